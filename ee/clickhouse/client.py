@@ -1,6 +1,7 @@
 import asyncio
 import hashlib
 import json
+import threading
 from time import time
 from typing import Any, Dict, List, Tuple
 
@@ -41,6 +42,9 @@ CACHE_TTL = 60  # seconds
 
 _save_query_user_id = False
 
+# Set by ee.clickhouse.explain.QueryExplainer to collect query plans for the current request
+_explain_context = threading.local()
+
 if PRIMARY_DB != RDBMS.CLICKHOUSE:
     ch_client = None  # type: Client
 
@@ -115,21 +119,30 @@ else:
         if not redis_client:
             redis_client = redis.get_client()
         key = _key_hash(query, args)
-        if redis_client.exists(key):
-            result = _deserialize(redis_client.get(key))
-            return result
+        cached_result = redis_client.get(key)  # a single round trip, a miss comes back as None
+        if cached_result is not None:
+            return _deserialize(cached_result)
         else:
             result = sync_execute(query, args, settings=settings)
             redis_client.set(key, _serialize(result), ex=ttl)
             return result
 
     def sync_execute(query, args=None, settings=None):
+        query_id = None
+        explainer = getattr(_explain_context, "explainer", None)
+        if explainer is not None:
+            _explain_context.explainer = None  # the explainer's own queries shouldn't be explained
+            try:
+                query_id = explainer.explain(query, args)
+            finally:
+                _explain_context.explainer = explainer
+
         with ch_pool.get_client() as client:
             start_time = time()
             settings = settings or {}
             settings["max_threads"] = 48  # :TODO: Nuke this, update configuration
             try:
-                result = client.execute(query, args, settings=settings)
+                result = client.execute(query, args, settings=settings, query_id=query_id)
             finally:
                 execution_time = time() - start_time
                 g = statsd.Gauge("%s_clickhouse_sync_execution_time" % (STATSD_PREFIX,))
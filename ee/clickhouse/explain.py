@@ -0,0 +1,158 @@
+import re
+from functools import wraps
+from typing import Any, Callable, Dict, List, Optional
+from uuid import uuid4
+
+from rest_framework.exceptions import PermissionDenied
+from rest_framework.request import Request
+from sentry_sdk.api import capture_exception
+
+from ee.clickhouse import client
+from ee.clickhouse.client import format_sql, sync_execute
+from ee.clickhouse.queries.builder import query_shape_hash
+
+INDEX_GRANULARITY = 8192  # rows per granule, the MergeTree default used by all our tables
+INDEX_TYPES = ("MinMax", "Partition", "PrimaryKey", "Skip")
+SELECTED_OF_TOTAL_REGEX = re.compile(r"^(Parts|Granules): (\d+)/(\d+)$")
+
+QUERY_LOG_SQL = """
+SELECT query_id, query_duration_ms, read_rows, read_bytes, result_rows, memory_usage, length(thread_ids)
+FROM system.query_log
+WHERE event_date >= yesterday() AND type = 'QueryFinish' AND query_id IN %(query_ids)s
+"""
+
+
+def parse_explain_indexes(rows: List[str]) -> List[Dict[str, Any]]:
+    """
+    Parses the output of `EXPLAIN indexes = 1` into one entry per index used by each read from a MergeTree table.
+    `read` numbers the reads (`ReadFromMergeTree` steps) in the plan, so indexes can be grouped by read.
+    """
+    indexes: List[Dict[str, Any]] = []
+    current: Optional[Dict[str, Any]] = None
+    in_keys = False
+    read = -1
+    for row in rows:
+        line = row.strip()
+        if line.startswith("ReadFromMergeTree"):
+            read += 1
+            current = None
+        elif line in INDEX_TYPES:
+            current = {"type": line, "keys": [], "condition": None, "read": read}
+            indexes.append(current)
+            in_keys = False
+        elif current is None:
+            continue
+        elif line == "Keys:":
+            in_keys = True
+        elif line.startswith("Condition:"):
+            current["condition"] = line[len("Condition:") :].strip()
+            in_keys = False
+        elif SELECTED_OF_TOTAL_REGEX.match(line):
+            kind, selected, total = SELECTED_OF_TOTAL_REGEX.match(line).groups()  # type: ignore
+            current["{}_selected".format(kind.lower())] = int(selected)
+            current["{}_total".format(kind.lower())] = int(total)
+            in_keys = False
+        elif in_keys:
+            current["keys"].append(line)
+    return indexes
+
+
+def summarize_primary_key(indexes: List[Dict[str, Any]]) -> Dict[str, Any]:
+    primary_keys = [index for index in indexes if index["type"] == "PrimaryKey"]
+    granules_selected = sum(index.get("granules_selected", 0) for index in primary_keys)
+    return {
+        "parts_selected": sum(index.get("parts_selected", 0) for index in primary_keys),
+        "parts_total": sum(index.get("parts_total", 0) for index in primary_keys),
+        "granules_selected": granules_selected,
+        "granules_total": sum(index.get("granules_total", 0) for index in primary_keys),
+        "estimated_rows": granules_selected * INDEX_GRANULARITY,
+        # every read should be pruned by both the team and the date, otherwise the filters defeat the sorting key
+        "prunes_by_team": bool(primary_keys) and all("team_id" in index["keys"] for index in primary_keys),
+        "prunes_by_date": bool(primary_keys) and all("toDate(timestamp)" in index["keys"] for index in primary_keys),
+    }
+
+
+class QueryExplainer:
+    """
+    Collects the plan of every ClickHouse query run within its context, and the stats of their execution.
+
+    Usage:
+        with QueryExplainer() as explainer:
+            result = ClickhouseTrends().run(filter, team)
+        explain = explainer.report()
+    """
+
+    def __init__(self) -> None:
+        self.queries: List[Dict[str, Any]] = []
+
+    def __enter__(self) -> "QueryExplainer":
+        client._explain_context.explainer = self
+        return self
+
+    def __exit__(self, *args: Any) -> None:
+        client._explain_context.explainer = None
+
+    def explain(self, query: str, args: Optional[Dict] = None) -> str:
+        query_id = str(uuid4())
+        entry: Dict[str, Any] = {
+            "query_id": query_id,
+            "sql": format_sql(query, args, colorize=False),
+            "shape_hash": query_shape_hash(query),
+        }
+        if query.lstrip().upper().startswith(("SELECT", "WITH")):
+            try:
+                indexes = parse_explain_indexes([row[0] for row in sync_execute("EXPLAIN indexes = 1 " + query, args)])
+                entry["indexes"] = indexes
+                entry["primary_key"] = summarize_primary_key(indexes)
+                entry["pipeline"] = [row[0] for row in sync_execute("EXPLAIN PIPELINE " + query, args)]
+            except Exception as e:
+                capture_exception(e)
+                entry["error"] = str(e)
+        self.queries.append(entry)
+        return query_id
+
+    def report(self) -> Dict[str, Any]:
+        stats = {}
+        if self.queries:
+            try:
+                sync_execute("SYSTEM FLUSH LOGS")
+                rows = sync_execute(QUERY_LOG_SQL, {"query_ids": [entry["query_id"] for entry in self.queries]})
+            except Exception as e:
+                capture_exception(e)
+                rows = []
+            for query_id, duration_ms, read_rows, read_bytes, result_rows, memory_usage, threads in rows:
+                stats[query_id] = {
+                    "duration_ms": duration_ms,
+                    "read_rows": read_rows,
+                    "read_bytes": read_bytes,
+                    "result_rows": result_rows,
+                    "memory_usage": memory_usage,
+                    "threads": threads,
+                }
+        return {"queries": [{**entry, "stats": stats.get(entry["query_id"])} for entry in self.queries]}
+
+
+def explainable() -> Callable:
+    """
+    Adds an explain mode to insight endpoints: with `?explain=true` staff get the result together with the plan and
+    execution stats of every query that computed it. Explained results always bypass (and don't fill) the cache.
+
+    Must wrap `cached_function`, so that the query is computed from the same builders as normal requests.
+    """
+
+    def parameterized_decorator(f: Callable) -> Callable:
+        @wraps(f)
+        def wrapper(self, request: Request, *args: Any, **kwargs: Any) -> Dict[str, Any]:
+            if not request.GET.get("explain"):
+                return f(self, request, *args, **kwargs)
+            if not request.user.is_staff:
+                raise PermissionDenied("Only staff users can explain insight queries.")
+
+            uncached = getattr(f, "__wrapped__", f)
+            with QueryExplainer() as explainer:
+                result = uncached(self, request, *args, **kwargs)
+            return {**result, "explain": explainer.report()}
+
+        return wrapper
+
+    return parameterized_decorator
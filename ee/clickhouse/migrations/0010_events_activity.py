@@ -0,0 +1,9 @@
+from infi.clickhouse_orm import migrations
+
+from ee.clickhouse.sql.events import BACKFILL_EVENTS_ACTIVITY_SQL, EVENTS_ACTIVITY_MV_SQL, EVENTS_ACTIVITY_TABLE_SQL
+
+operations = [
+    migrations.RunSQL(EVENTS_ACTIVITY_TABLE_SQL),
+    migrations.RunSQL(EVENTS_ACTIVITY_MV_SQL),
+    migrations.RunSQL(BACKFILL_EVENTS_ACTIVITY_SQL),
+]
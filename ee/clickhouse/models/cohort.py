@@ -1,6 +1,6 @@
 import uuid
 from datetime import datetime, timedelta
-from typing import Any, Dict, List, Optional, Tuple
+from typing import Any, Dict, Iterator, List, Optional, Tuple
 
 from django.utils import timezone
 
@@ -11,11 +11,14 @@ from ee.clickhouse.sql.person import (
     GET_LATEST_PERSON_DISTINCT_ID_SQL,
     GET_LATEST_PERSON_ID_SQL,
     GET_PERSON_IDS_BY_FILTER,
+    GET_STATIC_COHORT_PERSON_IDS_PAGE_SQL,
     INSERT_PERSON_STATIC_COHORT,
     PERSON_STATIC_COHORT_TABLE,
 )
 from posthog.models import Action, Cohort, Filter, Team
 
+STATIC_COHORT_SYNC_BATCH_SIZE = 5000
+
 
 def format_person_query(cohort: Cohort) -> Tuple[str, Dict[str, Any]]:
     filters = []
@@ -107,3 +110,24 @@ def insert_static_cohort(person_uuids: List[Optional[uuid.UUID]], cohort_id: int
         for person_uuid in person_uuids
     )
     sync_execute(INSERT_PERSON_STATIC_COHORT, persons)
+
+
+def get_static_cohort_person_uuid_batches(
+    cohort: Cohort, batch_size: int = STATIC_COHORT_SYNC_BATCH_SIZE
+) -> Iterator[List[str]]:
+    """
+    Person uuids of a static cohort, in batches ordered by uuid, starting after the cohort's `static_sync_cursor`.
+    Paging on the uuid instead of an offset keeps every batch a cheap range read of the table's sorting key.
+    """
+    after = str(cohort.static_sync_cursor) if cohort.static_sync_cursor else str(uuid.UUID(int=0))
+    while True:
+        rows = sync_execute(
+            GET_STATIC_COHORT_PERSON_IDS_PAGE_SQL,
+            {"team_id": cohort.team_id, "cohort_id": cohort.pk, "after": after, "limit": batch_size},
+        )
+        batch = [str(row[0]) for row in rows]
+        if batch:
+            yield batch
+        if len(batch) < batch_size:
+            return
+        after = batch[-1]
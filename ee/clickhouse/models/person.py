@@ -3,6 +3,7 @@ import json
 from typing import Any, Dict, List, Optional
 from uuid import UUID, uuid4
 
+from django.db.models import Prefetch
 from django.db.models.query import QuerySet
 from django.db.models.signals import post_delete, post_save
 from django.dispatch import receiver
@@ -14,14 +15,19 @@ from ee.clickhouse.models.property import parse_prop_clauses
 from ee.clickhouse.sql.person import (
     DELETE_PERSON_BY_ID,
     DELETE_PERSON_DISTINCT_ID_BY_PERSON_ID,
+    DELETE_PERSON_EVENTS_ACTIVITY_BY_ID,
     DELETE_PERSON_EVENTS_BY_ID,
+    DELETE_PERSON_EVENTS_FIRST_SEEN_BY_ID,
     GET_DISTINCT_IDS_SQL,
     GET_DISTINCT_IDS_SQL_BY_ID,
+    GET_LATEST_PERSON_DISTINCT_ID_SQL,
+    GET_LATEST_PERSON_SQL,
     GET_PERSON_BY_DISTINCT_ID,
     GET_PERSON_IDS_BY_FILTER,
     GET_PERSON_SQL,
     INSERT_PERSON_DISTINCT_ID,
     INSERT_PERSON_SQL,
+    PEOPLE_BY_IDS_SQL,
     PERSON_DISTINCT_ID_EXISTS_SQL,
     UPDATE_PERSON_ATTACHED_DISTINCT_ID,
     UPDATE_PERSON_IS_IDENTIFIED,
@@ -135,6 +141,17 @@ def get_persons_by_uuids(team_id: int, uuids: List[str]) -> QuerySet:
     return Person.objects.filter(team_id=team_id, uuid__in=uuids)
 
 
+def serialize_people_by_uuids(team_id: int, uuids: List[str]) -> List[Dict[str, Any]]:
+    """Serializes the people of a page of a people drilldown, in the order of `uuids`."""
+    from posthog.api.person import PersonSerializer
+
+    people = get_persons_by_uuids(team_id=team_id, uuids=uuids).prefetch_related(
+        Prefetch("persondistinctid_set", to_attr="distinct_ids_cache")
+    )
+    people_by_uuid = {str(person.uuid): person for person in people}
+    return [PersonSerializer(people_by_uuid[str(uuid)]).data for uuid in uuids if str(uuid) in people_by_uuid]
+
+
 def merge_people(team_id: int, target: Dict, old_id: UUID, old_props: Dict) -> None:
     # merge the properties
     properties = {**old_props, **target["properties"]}
@@ -159,6 +176,8 @@ def delete_person(person_id: UUID, delete_events: bool = False, team_id: int = F
     try:
         if delete_events:
             sync_execute(DELETE_PERSON_EVENTS_BY_ID, {"id": person_id, "team_id": team_id})
+            sync_execute(DELETE_PERSON_EVENTS_FIRST_SEEN_BY_ID, {"id": person_id, "team_id": team_id})
+            sync_execute(DELETE_PERSON_EVENTS_ACTIVITY_BY_ID, {"id": person_id, "team_id": team_id})
     except:
         pass  # cannot delete if the table is distributed
 
@@ -200,6 +219,23 @@ class ClickhousePersonSerializer(serializers.Serializer):
         return person[5] if len(person) > 5 else []
 
 
+def serialize_clickhouse_people_by_uuids(team_id: int, uuids: List[str]) -> List[Dict[str, Any]]:
+    """Like `serialize_people_by_uuids`, from the ClickHouse person tables."""
+    if not uuids:
+        return []
+    rows = sync_execute(
+        PEOPLE_BY_IDS_SQL.format(
+            latest_person_sql=GET_LATEST_PERSON_SQL.format(query="AND id IN %(person_ids)s"),
+            latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+        ),
+        {"team_id": team_id, "person_ids": tuple(uuids)},
+    )
+    rows_by_uuid = {str(row[0]): row for row in rows}
+    return ClickhousePersonSerializer(
+        [rows_by_uuid[str(uuid)] for uuid in uuids if str(uuid) in rows_by_uuid], many=True
+    ).data
+
+
 class ClickhousePersonDistinctIdSerializer(serializers.Serializer):
     id = serializers.SerializerMethodField()
     distinct_id = serializers.SerializerMethodField()
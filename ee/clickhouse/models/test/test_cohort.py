@@ -4,7 +4,12 @@ from uuid import uuid4
 from freezegun import freeze_time
 
 from ee.clickhouse.client import sync_execute
-from ee.clickhouse.models.cohort import format_filter_query, get_person_ids_by_cohort_id
+from ee.clickhouse.models.cohort import (
+    format_filter_query,
+    get_person_ids_by_cohort_id,
+    get_static_cohort_person_uuid_batches,
+    insert_static_cohort,
+)
 from ee.clickhouse.models.event import create_event
 from ee.clickhouse.models.person import create_person, create_person_distinct_id
 from ee.clickhouse.models.property import parse_prop_clauses
@@ -248,3 +253,31 @@ class TestCohort(ClickhouseTestMixin, BaseTest):
         cohort.insert_users_by_list(["123"])
         results = get_person_ids_by_cohort_id(self.team, cohort.id)
         self.assertEqual(len(results), 3)
+
+    def test_sync_static_cohort_in_batches(self):
+        people = [Person.objects.create(team_id=self.team.pk, distinct_ids=[str(i)]) for i in range(5)]
+        cohort = Cohort.objects.create(team=self.team, groups=[], is_static=True, is_calculating=True)
+        insert_static_cohort([person.uuid for person in people], cohort.pk, self.team)
+
+        batches = list(get_static_cohort_person_uuid_batches(cohort, batch_size=2))
+        self.assertEqual([len(batch) for batch in batches], [2, 2, 1])
+        self.assertEqual(sorted(uuid for batch in batches for uuid in batch), sorted(str(p.uuid) for p in people))
+
+        # an interrupted sync resumes after the last batch it committed
+        def interrupted_batches():
+            yield batches[0]
+            raise Exception("Worker lost")
+
+        with self.settings(DEBUG=False):
+            cohort.insert_users_batches_by_uuid(interrupted_batches())
+        cohort = Cohort.objects.get(pk=cohort.pk)
+        self.assertEqual(str(cohort.static_sync_cursor), batches[0][-1])
+        self.assertEqual(cohort.static_synced_count, 2)
+        self.assertEqual(list(get_static_cohort_person_uuid_batches(cohort, batch_size=2)), batches[1:])
+
+        cohort.insert_users_batches_by_uuid(get_static_cohort_person_uuid_batches(cohort, batch_size=2))
+        cohort = Cohort.objects.get(pk=cohort.pk)
+        self.assertEqual(Person.objects.filter(cohort__id=cohort.pk).count(), 5)
+        self.assertEqual(cohort.static_synced_count, 5)
+        self.assertIsNone(cohort.static_sync_cursor)
+        self.assertFalse(cohort.is_calculating)
@@ -0,0 +1,244 @@
+import hashlib
+import re
+from typing import Any, Dict, FrozenSet, Iterable, List, Optional, Tuple, Union
+
+from django.conf import settings
+
+PARAM_REGEX = re.compile(r"%\((\w+)\)s")
+STRING_LITERAL_REGEX = re.compile(r"'(?:[^'\\]|\\.)*'")
+NUMBER_LITERAL_REGEX = re.compile(r"\b\d+(\.\d+)?\b")
+WHITESPACE_REGEX = re.compile(r"\s+")
+LEADING_AND_REGEX = re.compile(r"^\s*and\s+", re.IGNORECASE)
+
+# Columns that are cheap to read and filter out most rows, conditions on them only are moved to PREWHERE
+PREWHERE_COLUMNS = frozenset(["event"])
+
+
+class Fragment:
+    """
+    A piece of ClickHouse SQL together with the parameters it owns.
+
+    `columns` lists the columns of the main table the fragment reads, when known. Only fragments with known columns
+    are candidates for PREWHERE, raw SQL from the older `str.format` helpers never is.
+    """
+
+    def __init__(self, sql: str, params: Optional[Dict[str, Any]] = None, columns: Optional[Iterable[str]] = None):
+        self.sql = sql.strip()
+        self.params = params or {}
+        self.columns: Optional[FrozenSet[str]] = frozenset(columns) if columns is not None else None
+
+    @classmethod
+    def raw(
+        cls, sql: str, params: Optional[Dict[str, Any]] = None, columns: Optional[Iterable[str]] = None
+    ) -> Optional["Fragment"]:
+        """Wraps conditions of the `"AND ..."` form returned by `parse_prop_clauses` and friends."""
+        sql = LEADING_AND_REGEX.sub("", sql or "", count=1).strip()
+        if not sql:
+            return None
+        return cls("({})".format(sql), params, columns)
+
+    def namespaced(self, namespace: str) -> "Fragment":
+        """
+        Prefixes the parameters owned by this fragment, so it can be combined with others using the same names.
+        Placeholders for parameters the fragment doesn't own (e.g. `team_id`) are shared and left untouched.
+        """
+        sql, params = namespace_params(self.sql, self.params, namespace)
+        return Fragment(sql, params, self.columns)
+
+    def __str__(self) -> str:
+        return self.sql
+
+
+def namespace_params(sql: str, params: Dict[str, Any], namespace: str) -> Tuple[str, Dict[str, Any]]:
+    def _rename(match: Any) -> str:
+        name = match.group(1)
+        return "%({}_{})s".format(namespace, name) if name in params else match.group(0)
+
+    return PARAM_REGEX.sub(_rename, sql), {"{}_{}".format(namespace, key): value for key, value in params.items()}
+
+
+def column_equals(column: str, param: str, value: Any, table: str = "") -> Fragment:
+    return Fragment("{}{} = %({})s".format(table, column, param), {param: value}, columns=[column])
+
+
+def column_in(column: str, param: str, values: Any, table: str = "") -> Fragment:
+    return Fragment("{}{} IN %({})s".format(table, column, param), {param: values}, columns=[column])
+
+
+def merge_params(*param_dicts: Dict[str, Any]) -> Dict[str, Any]:
+    merged: Dict[str, Any] = {}
+    for params in param_dicts:
+        for key, value in params.items():
+            if key in merged and merged[key] != value:
+                raise ValueError("Query parameter {} is bound to conflicting values, namespace one of them".format(key))
+            merged[key] = value
+    return merged
+
+
+Condition = Union[Fragment, str, None]
+
+
+def _to_fragment(condition: Condition) -> Optional[Fragment]:
+    if condition is None or isinstance(condition, Fragment):
+        return condition
+    return Fragment.raw(condition)
+
+
+class Select:
+    """
+    Builds a single SELECT statement of the ClickHouse dialect.
+
+        sql, params = (
+            Select("count(*) as data", from_="events")
+            .where(column_equals("team_id", "team_id", team.pk), column_equals("event", "event", "$pageview"))
+            .group_by("toStartOfDay(timestamp)")
+            .build()
+        )
+
+    Conditions on the main table that only read `PREWHERE_COLUMNS` (and materialized property columns) are placed in
+    PREWHERE automatically, unless `auto_prewhere=False`. Subqueries (`Select` given as `from_`) are rendered inline
+    and contribute their parameters.
+    """
+
+    def __init__(
+        self, *columns: Union[str, Fragment], from_: Union[str, "Select"], alias: str = "", auto_prewhere: bool = True
+    ):
+        self._columns: List[Fragment] = []
+        self.select(*columns)
+        self._from = from_
+        self._alias = alias
+        self._auto_prewhere = auto_prewhere and isinstance(from_, str)
+        self._distinct = False
+        self._joins: List[Fragment] = []
+        self._prewhere: List[Fragment] = []
+        self._where: List[Fragment] = []
+        self._group_by: List[str] = []
+        self._having: List[Fragment] = []
+        self._order_by: List[str] = []
+        self._limit: Optional[Fragment] = None
+        self._unions: List["Select"] = []
+
+    def select(self, *columns: Union[str, Fragment]) -> "Select":
+        self._columns.extend(
+            column if isinstance(column, Fragment) else Fragment(column) for column in columns if column
+        )
+        return self
+
+    def distinct(self) -> "Select":
+        self._distinct = True
+        return self
+
+    def join(self, join: Union[str, Fragment, None]) -> "Select":
+        if join:
+            self._joins.append(join if isinstance(join, Fragment) else Fragment(join))
+        return self
+
+    def where(self, *conditions: Condition) -> "Select":
+        for condition in conditions:
+            fragment = _to_fragment(condition)
+            if fragment is not None:
+                self._where.append(fragment)
+        return self
+
+    def prewhere(self, *conditions: Condition) -> "Select":
+        for condition in conditions:
+            fragment = _to_fragment(condition)
+            if fragment is not None:
+                self._prewhere.append(fragment)
+        return self
+
+    def group_by(self, *expressions: str) -> "Select":
+        self._group_by.extend(expression for expression in expressions if expression)
+        return self
+
+    def having(self, *conditions: Condition) -> "Select":
+        for condition in conditions:
+            fragment = _to_fragment(condition)
+            if fragment is not None:
+                self._having.append(fragment)
+        return self
+
+    def order_by(self, *expressions: str) -> "Select":
+        self._order_by.extend(expression for expression in expressions if expression)
+        return self
+
+    def limit(self, limit: Union[int, str], offset: Union[int, str, None] = None) -> "Select":
+        sql = "LIMIT {}".format(limit) + (" OFFSET {}".format(offset) if offset is not None else "")
+        self._limit = Fragment(sql)
+        return self
+
+    def union_all(self, query: "Select") -> "Select":
+        self._unions.append(query)
+        return self
+
+    def _is_prewhere_candidate(self, condition: Fragment) -> bool:
+        if not condition.columns:
+            return False
+        materialized = {
+            "properties_{}".format(key.lower()) for key in settings.CLICKHOUSE_DENORMALIZED_PROPERTIES if key
+        }
+        return condition.columns <= PREWHERE_COLUMNS | materialized
+
+    def _split_prewhere(self) -> Tuple[List[Fragment], List[Fragment]]:
+        prewhere = list(self._prewhere)
+        where = []
+        for condition in self._where:
+            if self._auto_prewhere and self._is_prewhere_candidate(condition):
+                prewhere.append(condition)
+            else:
+                where.append(condition)
+        return prewhere, where
+
+    def fragment(self) -> Fragment:
+        prewhere, where = self._split_prewhere()
+        if isinstance(self._from, Select):
+            source = self._from.fragment()
+            from_sql, from_params = "({})".format(source.sql), source.params
+        else:
+            from_sql, from_params = self._from, {}
+
+        columns = ", ".join(column.sql for column in self._columns)
+        parts = [
+            "SELECT {}{}".format("DISTINCT " if self._distinct else "", columns),
+            "FROM {}{}".format(from_sql, " {}".format(self._alias) if self._alias else ""),
+        ]
+        parts.extend(join.sql for join in self._joins)
+        if prewhere:
+            parts.append("PREWHERE {}".format(" AND ".join(condition.sql for condition in prewhere)))
+        if where:
+            parts.append("WHERE {}".format(" AND ".join(condition.sql for condition in where)))
+        if self._group_by:
+            parts.append("GROUP BY {}".format(", ".join(self._group_by)))
+        if self._having:
+            parts.append("HAVING {}".format(" AND ".join(condition.sql for condition in self._having)))
+        if self._order_by:
+            parts.append("ORDER BY {}".format(", ".join(self._order_by)))
+        if self._limit:
+            parts.append(self._limit.sql)
+
+        unions = [union.fragment() for union in self._unions]
+        sql = "\n".join(parts) + "".join("\nUNION ALL\n{}".format(union.sql) for union in unions)
+        params = merge_params(
+            from_params,
+            *(fragment.params for fragment in [*self._columns, *self._joins, *prewhere, *where, *self._having]),
+            *(union.params for union in unions),
+        )
+        return Fragment(sql, params)
+
+    def build(self) -> Tuple[str, Dict[str, Any]]:
+        fragment = self.fragment()
+        return fragment.sql, fragment.params
+
+    def shape_hash(self) -> str:
+        return query_shape_hash(self.fragment().sql)
+
+
+def query_shape_hash(sql: str) -> str:
+    """
+    Hash of the query with literals and formatting stripped: queries that only differ in their parameters
+    (dates, values, ids) share a shape, so plans and results can be cached per shape.
+    """
+    normalized = STRING_LITERAL_REGEX.sub("?", sql)
+    normalized = NUMBER_LITERAL_REGEX.sub("?", normalized)
+    normalized = WHITESPACE_REGEX.sub(" ", normalized).strip().lower()
+    return hashlib.md5(normalized.encode("utf-8")).hexdigest()
@@ -1,7 +1,7 @@
 import uuid
 from collections import defaultdict
 from datetime import datetime, timedelta
-from typing import Any, Dict, List, Match, Tuple
+from typing import Any, Dict, List, Match, Optional, Tuple
 
 import pytz
 from django.utils import timezone
@@ -9,8 +9,8 @@ from django.utils import timezone
 from ee.clickhouse.client import sync_execute
 from ee.clickhouse.models.action import format_action_filter
 from ee.clickhouse.models.property import parse_prop_clauses
-from ee.clickhouse.queries.util import get_trunc_func_ch, parse_timestamps
-from ee.clickhouse.sql.funnels.funnel import FUNNEL_SQL
+from ee.clickhouse.queries.builder import Fragment, Select, column_equals, column_in
+from ee.clickhouse.queries.util import get_trunc_func_ch, parse_prop_conditions, parse_timestamp_conditions
 from ee.clickhouse.sql.person import GET_LATEST_PERSON_DISTINCT_ID_SQL
 from posthog.constants import TREND_FILTER_TYPE_ACTIONS, TRENDS_LINEAR
 from posthog.models.action import Action
@@ -57,18 +57,52 @@ class ClickhouseFunnel(Funnel):
             content_sql = "{actions_query} {filters}".format(actions_query=action_query, filters=filters,)
         else:
             self.params["events"].append(entity.id)
-            content_sql = "event = '{event}' {filters}".format(event=entity.id, filters=filters)
+            self.params["event_{}".format(index)] = entity.id
+            content_sql = "event = %(event_{index})s {filters}".format(index=index, filters=filters)
         return content_sql
 
-    def _exec_query(self) -> List[Tuple]:
-        prop_filters, prop_filter_params = parse_prop_clauses(
+    def _build_query(self, within_time: str, trunc_func: Optional[str] = None) -> Tuple[str, Dict]:
+        """
+        Each person's furthest step within `within_time` microseconds, per `trunc_func` period if given.
+        """
+        prop_conditions = parse_prop_conditions(
             self._filter.properties,
             self._team.pk,
-            prepend="global",
+            table_name="events",
             allow_denormalized_props=True,
             filter_test_accounts=self._filter.filter_test_accounts,
         )
+        steps = [self._build_steps_query(entity, index) for index, entity in enumerate(self._filter.entities)]
+        window_funnel = Fragment(
+            "windowFunnel({within_time})(toUInt64(toUnixTimestamp64Micro(timestamp)), {steps}) as max_step".format(
+                within_time=within_time, steps=", ".join(steps)
+            ),
+            self.params,
+        )
+
+        steps_query = (
+            Select("pid.person_id as id", window_funnel.namespaced("steps"), from_="events")
+            .join(
+                "JOIN (SELECT person_id, distinct_id FROM ({}) WHERE team_id = %(team_id)s) as pid "
+                "ON pid.distinct_id = events.distinct_id".format(GET_LATEST_PERSON_DISTINCT_ID_SQL)
+            )
+            .where(
+                column_equals("team_id", "team_id", self._team.pk),
+                *prop_conditions,
+                *parse_timestamp_conditions(filter=self._filter, team_id=self._team.pk, table="events."),
+                column_in("event", "events", self.params["events"]),  # purely a speed optimization
+            )
+            .group_by("pid.person_id")
+        )
+        query = Select("max_step", from_=steps_query).where("max_step > 0").group_by("max_step")
+        if trunc_func:
+            steps_query.select("{}(timestamp) as date".format(trunc_func)).group_by("{}(timestamp)".format(trunc_func))
+            query.select("date").group_by("date").order_by("max_step", "date ASC")
+        else:
+            query.order_by("max_step ASC")
+        return query.select("count(1)", "groupArray(100)(id)").build()
 
+    def _exec_query(self) -> List[Tuple]:
         # format default dates
         data = {}
         if not self._filter._date_from:
@@ -77,52 +111,15 @@ class ClickhouseFunnel(Funnel):
             data.update({"date_to": timezone.now()})
         self._filter = self._filter.with_data(data)
 
-        parsed_date_from, parsed_date_to, _ = parse_timestamps(
-            filter=self._filter, table="events.", team_id=self._team.pk
-        )
-        self.params.update(prop_filter_params)
-        steps = [self._build_steps_query(entity, index) for index, entity in enumerate(self._filter.entities)]
-        query = FUNNEL_SQL.format(
-            team_id=self._team.id,
-            steps=", ".join(steps),
-            filters=prop_filters.replace("uuid IN", "events.uuid IN", 1),
-            parsed_date_from=parsed_date_from,
-            parsed_date_to=parsed_date_to,
-            top_level_groupby="",
-            extra_select="",
-            extra_groupby="",
-            within_time="6048000000000000",
-            latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
-        )
-        return sync_execute(query, self.params)
+        query, params = self._build_query(within_time="6048000000000000")
+        return sync_execute(query, params)
 
     def _get_trends(self) -> List[Dict[str, Any]]:
         serialized: Dict[str, Any] = {"count": 0, "data": [], "days": [], "labels": []}
-        prop_filters, prop_filter_params = parse_prop_clauses(
-            self._filter.properties,
-            self._team.pk,
-            prepend="global",
-            allow_denormalized_props=True,
-            filter_test_accounts=self._filter.filter_test_accounts,
-        )
-        parsed_date_from, parsed_date_to, _ = parse_timestamps(
-            filter=self._filter, table="events.", team_id=self._team.pk
-        )
-        self.params.update(prop_filter_params)
-        steps = [self._build_steps_query(entity, index) for index, entity in enumerate(self._filter.entities)]
-        funnel_query = FUNNEL_SQL.format(
-            team_id=self._team.id,
-            steps=", ".join(steps),
-            filters=prop_filters.replace("uuid IN", "events.uuid IN", 1),
-            parsed_date_from=parsed_date_from,
-            parsed_date_to=parsed_date_to,
-            top_level_groupby=", date",
-            extra_select="{}(timestamp) as date,".format(get_trunc_func_ch(self._filter.interval)),
-            extra_groupby=",{}(timestamp)".format(get_trunc_func_ch(self._filter.interval)),
-            within_time="86400000000",
-            latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+        funnel_query, params = self._build_query(
+            within_time="86400000000", trunc_func=get_trunc_func_ch(self._filter.interval)
         )
-        results = sync_execute(funnel_query, self.params)
+        results = sync_execute(funnel_query, params)
         parsed_results = []
 
         for result in results:
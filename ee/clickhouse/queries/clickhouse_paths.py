@@ -12,7 +12,7 @@ from posthog.constants import AUTOCAPTURE_EVENT, CUSTOM_EVENT, SCREEN_EVENT
 from posthog.models.filters import Filter
 from posthog.models.filters.path_filter import PathFilter
 from posthog.models.team import Team
-from posthog.queries.paths import Paths
+from posthog.queries.paths import PATHS_EDGE_LIMIT, Paths
 from posthog.utils import relative_date_parse
 
 
@@ -82,6 +82,7 @@ class ClickhousePaths(Paths):
             "property": "$current_url",
             "event": event,
             "start_point": filter.start_point,
+            "edge_limit": PATHS_EDGE_LIMIT,
         }
         params = {**params, **prop_filter_params}
 
@@ -1,32 +1,26 @@
-from typing import Any, Dict, Tuple
-
-from django.db.models.query import Prefetch
+from datetime import datetime
+from typing import Any, Dict, List, Tuple
 
 from ee.clickhouse.client import sync_execute
 from ee.clickhouse.models.action import format_action_filter
-from ee.clickhouse.models.person import ClickhousePersonSerializer, get_persons_by_uuids
+from ee.clickhouse.models.person import ClickhousePersonSerializer, serialize_clickhouse_people_by_uuids
 from ee.clickhouse.models.property import parse_prop_clauses
-from ee.clickhouse.queries.util import get_trunc_func_ch
-from ee.clickhouse.sql.person import GET_LATEST_PERSON_DISTINCT_ID_SQL
+from ee.clickhouse.queries.builder import Fragment, Select, column_equals, merge_params
+from ee.clickhouse.queries.util import get_trunc_func_ch, parse_prop_conditions, timestamp_bound
+from ee.clickhouse.sql.person import GET_LATEST_PERSON_DISTINCT_ID_SQL, GET_LATEST_PERSON_SQL, PEOPLE_SQL
 from ee.clickhouse.sql.retention.people_in_period import (
     DEFAULT_REFERENCE_EVENT_PEOPLE_PER_PERIOD_SQL,
     DEFAULT_REFERENCE_EVENT_UNIQUE_PEOPLE_PER_PERIOD_SQL,
     REFERENCE_EVENT_PEOPLE_PER_PERIOD_SQL,
     REFERENCE_EVENT_UNIQUE_PEOPLE_PER_PERIOD_SQL,
     RETENTION_PEOPLE_PER_PERIOD_SQL,
+    RETENTION_PEOPLE_PER_PERIOD_WITH_PERSONS_SQL,
 )
-from ee.clickhouse.sql.retention.retention import (
-    INITIAL_INTERVAL_SQL,
-    REFERENCE_EVENT_SQL,
-    REFERENCE_EVENT_UNIQUE_SQL,
-    RETENTION_PEOPLE_SQL,
-    RETENTION_SQL,
-)
+from ee.clickhouse.sql.retention.retention import RETENTION_PEOPLE_SQL, RETENTION_PERSON_JOIN_SQL
 from posthog.constants import RETENTION_FIRST_TIME, TREND_FILTER_TYPE_ACTIONS, TREND_FILTER_TYPE_EVENTS, TRENDS_LINEAR
 from posthog.models.action import Action
 from posthog.models.entity import Entity
 from posthog.models.filters import Filter, RetentionFilter
-from posthog.models.person import Person
 from posthog.models.team import Team
 from posthog.queries.retention import Retention
 
@@ -34,96 +28,100 @@ from posthog.queries.retention import Retention
 class ClickhouseRetention(Retention):
     def _execute_sql(self, filter: RetentionFilter, team: Team,) -> Dict[Tuple[int, int], Dict[str, Any]]:
         period = filter.period
-        prop_filters, prop_filter_params = parse_prop_clauses(
-            filter.properties, team.pk, filter_test_accounts=filter.filter_test_accounts
+        prop_conditions = parse_prop_conditions(
+            filter.properties,
+            team.pk,
+            allow_denormalized_props=True,
+            filter_test_accounts=filter.filter_test_accounts,
         )
-        target_entity = filter.target_entity
-        returning_entity = filter.returning_entity
-        is_first_time_retention = filter.retention_type == RETENTION_FIRST_TIME
-        date_from = filter.date_from
-        date_to = filter.date_to
-
-        target_query = ""
-        target_params: Dict = {}
         trunc_func = get_trunc_func_ch(period)
 
-        target_query, target_params = self._get_condition(target_entity, table="e")
-        returning_query, returning_params = self._get_condition(returning_entity, table="e", prepend="returning")
-
-        target_query_formatted = "AND {target_query}".format(target_query=target_query)
-        returning_query_formatted = "AND {returning_query}".format(returning_query=returning_query)
-
-        reference_event_sql = (REFERENCE_EVENT_UNIQUE_SQL if is_first_time_retention else REFERENCE_EVENT_SQL).format(
-            target_query=target_query_formatted,
-            filters=prop_filters,
-            trunc_func=trunc_func,
-            latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+        reference_date_to = (
+            (filter.date_from + filter.period_increment) if filter.display == TRENDS_LINEAR else filter.date_to
+        )
+        reference_event = self._reference_event_query(
+            filter,
+            team,
+            self._get_condition(filter.target_entity, table="e"),
+            prop_conditions,
+            trunc_func,
+            filter.date_from,
+            reference_date_to,
         )
+        start_date = self._format_date(filter, filter.date_from)
 
-        target_condition, _ = self._get_condition(target_entity, table="reference_event")
-        if is_first_time_retention:
-            target_condition = target_condition.replace("reference_event.uuid", "reference_event.min_uuid")
-            target_condition = target_condition.replace("reference_event.event", "reference_event.min_event")
-        returning_condition, _ = self._get_condition(returning_entity, table="event", prepend="returning")
-        result = sync_execute(
-            RETENTION_SQL.format(
-                target_query=target_query_formatted,
-                returning_query=returning_query_formatted,
-                filters=prop_filters,
-                trunc_func=trunc_func,
-                extra_union="UNION ALL {} ".format(reference_event_sql),
-                reference_event_sql=reference_event_sql,
-                target_condition=target_condition,
-                returning_condition=returning_condition,
-                latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
-            ),
-            {
-                "team_id": team.pk,
-                "start_date": date_from.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
+        returning_event = (
+            Select(
+                "timestamp AS event_date",
+                "pdi.person_id as person_id",
+                "e.uuid as uuid",
+                "e.event as event",
+                from_="events",
+                alias="e",
+            )
+            .join(RETENTION_PERSON_JOIN_SQL)
+            .where(
+                column_equals("team_id", "team_id", team.pk, table="e."),
+                Fragment(timestamp_bound(">=", "toDateTime(%(start_date)s)", "e."), {"start_date": start_date}),
+                Fragment(
+                    timestamp_bound("<=", "toDateTime(%(end_date)s)", "e."),
+                    {"end_date": self._format_date(filter, filter.date_to)},
                 ),
-                "end_date": date_to.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
+                self._get_condition(filter.returning_entity, table="e", prepend="returning"),
+                *prop_conditions,
+            )
+        )
+        reference_join = reference_event.fragment()
+        retention_query = (
+            Select(
+                Fragment(
+                    "datediff(%(period)s, {trunc_func}(toDateTime(%(start_date)s)), reference_event.event_date) "
+                    "as base_interval".format(trunc_func=trunc_func),
+                    {"period": period, "start_date": start_date},
                 ),
-                "reference_start_date": date_from.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
+                Fragment(
+                    "datediff(%(period)s, reference_event.event_date, {trunc_func}(toDateTime(event_date))) "
+                    "as intervals_from_base".format(trunc_func=trunc_func),
+                    {"period": period},
                 ),
-                "reference_end_date": (
-                    (date_from + filter.period_increment) if filter.display == TRENDS_LINEAR else date_to
-                ).strftime("%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")),
-                **prop_filter_params,
-                **target_params,
-                **returning_params,
-                "period": period,
-            },
+                "COUNT(DISTINCT event.person_id) count",
+                from_=returning_event,
+                alias="event",
+            )
+            .join(
+                Fragment(
+                    "JOIN ({}) reference_event ON (event.person_id = reference_event.person_id)".format(
+                        reference_join.sql
+                    ),
+                    reference_join.params,
+                )
+            )
+            .where(
+                "{trunc_func}(event.event_date) > {trunc_func}(reference_event.event_date)".format(
+                    trunc_func=trunc_func
+                )
+            )
+            .group_by("base_interval", "intervals_from_base")
+            .order_by("base_interval", "intervals_from_base")
         )
+        result = sync_execute(*retention_query.build())
 
-        initial_interval_result = sync_execute(
-            INITIAL_INTERVAL_SQL.format(
-                reference_event_sql=reference_event_sql,
-                trunc_func=trunc_func,
-                latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
-            ),
-            {
-                "team_id": team.pk,
-                "start_date": date_from.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
-                ),
-                "end_date": date_to.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
-                ),
-                "reference_start_date": date_from.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
+        # the reference event subquery is shared, so both queries read the same cohort of people
+        initial_interval_query = (
+            Select(
+                Fragment(
+                    "datediff(%(period)s, {trunc_func}(toDateTime(%(start_date)s)), event_date) event_date".format(
+                        trunc_func=trunc_func
+                    ),
+                    {"period": period, "start_date": start_date},
                 ),
-                "reference_end_date": (
-                    (date_from + filter.period_increment) if filter.display == TRENDS_LINEAR else date_to
-                ).strftime("%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")),
-                **prop_filter_params,
-                **target_params,
-                **returning_params,
-                "period": period,
-            },
+                "count(DISTINCT person_id)",
+                from_=reference_event,
+            )
+            .group_by("event_date")
+            .order_by("event_date")
         )
+        initial_interval_result = sync_execute(*initial_interval_query.build())
 
         result_dict = {}
         for initial_res in initial_interval_result:
@@ -134,87 +132,187 @@ class ClickhouseRetention(Retention):
 
         return result_dict
 
-    def _get_condition(self, target_entity: Entity, table: str, prepend: str = "") -> Tuple[str, Dict]:
+    def _reference_event_query(
+        self,
+        filter: RetentionFilter,
+        team: Team,
+        target_condition: Fragment,
+        prop_conditions: List[Fragment],
+        trunc_func: str,
+        reference_date_from: datetime,
+        reference_date_to: datetime,
+    ) -> Select:
+        reference_dates = {
+            "reference_start_date": self._format_date(filter, reference_date_from),
+            "reference_end_date": self._format_date(filter, reference_date_to),
+        }
+        if filter.retention_type == RETENTION_FIRST_TIME:
+            return (
+                Select(
+                    "min({trunc_func}(e.timestamp)) as event_date".format(trunc_func=trunc_func),
+                    "pdi.person_id as person_id",
+                    "argMin(e.uuid, {trunc_func}(e.timestamp)) as min_uuid".format(trunc_func=trunc_func),
+                    "argMin(e.event, {trunc_func}(e.timestamp)) as min_event".format(trunc_func=trunc_func),
+                    from_="events",
+                    alias="e",
+                )
+                .distinct()
+                .join(RETENTION_PERSON_JOIN_SQL)
+                .where(column_equals("team_id", "team_id", team.pk, table="e."), target_condition, *prop_conditions)
+                .group_by("person_id")
+                .having(
+                    Fragment(
+                        "event_date >= toDateTime(%(reference_start_date)s) "
+                        "AND event_date <= toDateTime(%(reference_end_date)s)",
+                        reference_dates,
+                    )
+                )
+            )
+
+        return (
+            Select(
+                "{trunc_func}(e.timestamp) as event_date".format(trunc_func=trunc_func),
+                "pdi.person_id as person_id",
+                "e.uuid as uuid",
+                "e.event as event",
+                from_="events",
+                alias="e",
+            )
+            .distinct()
+            .join(RETENTION_PERSON_JOIN_SQL)
+            .where(
+                column_equals("team_id", "team_id", team.pk, table="e."),
+                Fragment(
+                    "{} AND {}".format(
+                        timestamp_bound(">=", "toDateTime(%(reference_start_date)s)", "e."),
+                        timestamp_bound("<=", "toDateTime(%(reference_end_date)s)", "e."),
+                    ),
+                    reference_dates,
+                ),
+                target_condition,
+                *prop_conditions,
+            )
+        )
+
+    def _format_date(self, filter: RetentionFilter, date: datetime) -> str:
+        return date.strftime("%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00"))
+
+    def _get_condition(self, target_entity: Entity, table: str, prepend: str = "") -> Fragment:
         if target_entity.type == TREND_FILTER_TYPE_ACTIONS:
             action = Action.objects.get(pk=target_entity.id)
             action_query, params = format_action_filter(action, prepend=prepend, use_loop=False)
-            condition = action_query
-        elif target_entity.type == TREND_FILTER_TYPE_EVENTS:
-            condition = "{}.event = %({}_event)s".format(table, prepend)
-            params = {"{}_event".format(prepend): target_entity.id}
-        else:
-            condition = "{}.event = %({}_event)s".format(table, prepend)
-            params = {"{}_event".format(prepend): "$pageview"}
-        return condition, params
+            return Fragment(action_query, params)
+        event = target_entity.id if target_entity.type == TREND_FILTER_TYPE_EVENTS else "$pageview"
+        return column_equals("event", "{}_event".format(prepend), event, table="{}.".format(table))
 
     def _retrieve_people(self, filter: RetentionFilter, team: Team):
+        # the people are hydrated from the ClickHouse person tables, in the same query
+        people_query, params = self._people_query(filter, team)
+        people = sync_execute(
+            PEOPLE_SQL.format(
+                content_sql=people_query,
+                latest_person_sql=GET_LATEST_PERSON_SQL.format(query=""),
+                latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+            ),
+            {**params, "offset": filter.offset},
+        )
+        return ClickhousePersonSerializer(people, many=True).data
+
+    def people_uuids(self, filter: RetentionFilter, team: Team) -> List[str]:
+        people_query, params = self._people_query(filter, team)
+        return sorted(str(val[0]) for val in sync_execute(people_query, params))
+
+    def _people_query(self, filter: RetentionFilter, team: Team) -> Tuple[str, Dict[str, Any]]:
         period = filter.period
-        is_first_time_retention = filter.retention_type == RETENTION_FIRST_TIME
         trunc_func = get_trunc_func_ch(period)
+        # parse_prop_clauses appends the test account filters to the filter's properties, so it has to come second
+        prop_conditions = parse_prop_conditions(
+            filter.properties, team.pk, allow_denormalized_props=True, filter_test_accounts=filter.filter_test_accounts,
+        )
         prop_filters, prop_filter_params = parse_prop_clauses(
             filter.properties, team.pk, filter_test_accounts=filter.filter_test_accounts
         )
 
         returning_entity = filter.returning_entity if filter.selected_interval > 0 else filter.target_entity
-        target_query, target_params = self._get_condition(filter.target_entity, table="e")
-        target_query_formatted = "AND {target_query}".format(target_query=target_query)
-        return_query, return_params = self._get_condition(returning_entity, table="e", prepend="returning")
-        return_query_formatted = "AND {return_query}".format(return_query=return_query)
+        return_condition = self._get_condition(returning_entity, table="e", prepend="returning")
+        return_query_formatted = "AND {return_query}".format(return_query=return_condition.sql)
 
-        reference_event_query = (REFERENCE_EVENT_UNIQUE_SQL if is_first_time_retention else REFERENCE_EVENT_SQL).format(
-            target_query=target_query_formatted,
-            filters=prop_filters,
-            trunc_func=trunc_func,
-            latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
-        )
-        reference_date_from = filter.date_from
-        reference_date_to = filter.date_from + filter.period_increment
+        reference_event = self._reference_event_query(
+            filter,
+            team,
+            self._get_condition(filter.target_entity, table="e"),
+            prop_conditions,
+            trunc_func,
+            filter.date_from,
+            filter.date_from + filter.period_increment,
+        ).fragment()
         date_from = filter.date_from + filter.selected_interval * filter.period_increment
         date_to = date_from + filter.period_increment
 
-        result = sync_execute(
+        return (
             RETENTION_PEOPLE_SQL.format(
-                reference_event_query=reference_event_query,
+                reference_event_query=reference_event.sql,
                 target_query=return_query_formatted,
                 filters=prop_filters,
                 latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
             ),
-            {
-                "team_id": team.pk,
-                "start_date": date_from.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
-                ),
-                "end_date": date_to.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
-                ),
-                "reference_start_date": reference_date_from.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
-                ),
-                "reference_end_date": reference_date_to.strftime(
-                    "%Y-%m-%d{}".format(" %H:%M:%S" if filter.period == "Hour" else " 00:00:00")
-                ),
-                "offset": filter.offset,
-                **target_params,
-                **return_params,
-                **prop_filter_params,
-            },
+            merge_params(
+                {
+                    "team_id": team.pk,
+                    "start_date": self._format_date(filter, date_from),
+                    "end_date": self._format_date(filter, date_to),
+                    **return_condition.params,
+                    **prop_filter_params,
+                },
+                reference_event.params,
+            ),
+        )
+
+    def _retrieve_people_in_period(self, filter: RetentionFilter, team: Team):
+        # the people are hydrated from the ClickHouse person tables, in the same query
+        people_in_period_query, params = self._people_in_period_query(
+            filter, team, limit_sql="LIMIT %(limit)s OFFSET %(offset)s"
+        )
+        rows = sync_execute(
+            RETENTION_PEOPLE_PER_PERIOD_WITH_PERSONS_SQL.format(
+                people_in_period_sql=people_in_period_query,
+                latest_person_sql=GET_LATEST_PERSON_SQL.format(query=""),
+                latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+            ),
+            params,
+        )
+        people = ClickhousePersonSerializer([row[:6] for row in rows], many=True).data
+        return self.process_people_in_period(
+            self._people_in_period_filter(filter),
+            [(str(row[0]), row[6], row[7]) for row in rows],
+            {str(row[0]): person for row, person in zip(rows, people)},
         )
-        people = Person.objects.filter(team_id=team.pk, uuid__in=[val[0] for val in result])
 
-        from posthog.api.person import PersonSerializer
+    def people_in_period_rows(self, filter: RetentionFilter, team: Team) -> List[Tuple]:
+        """Uuid, appearance count and appearances of every person of the period, see `serialize_people_in_period`."""
+        people_in_period_query, params = self._people_in_period_query(filter, team, limit_sql="")
+        return [(str(row[0]), *row[1:]) for row in sync_execute(people_in_period_query, params)]
 
-        return PersonSerializer(people, many=True).data
+    def serialize_people_in_period(self, filter: RetentionFilter, team: Team, rows: List[Tuple]):
+        people = serialize_clickhouse_people_by_uuids(team.pk, [row[0] for row in rows])
+        people_dict = {str(person["id"]): person for person in people}
+        return self.process_people_in_period(self._people_in_period_filter(filter), rows, people_dict)
 
-    def _retrieve_people_in_period(self, filter: RetentionFilter, team: Team):
+    def _people_in_period_filter(self, filter: RetentionFilter) -> RetentionFilter:
+        return filter.with_data({"total_intervals": filter.total_intervals - filter.selected_interval})
+
+    def _people_in_period_query(
+        self, filter: RetentionFilter, team: Team, limit_sql: str
+    ) -> Tuple[str, Dict[str, Any]]:
         period = filter.period
         is_first_time_retention = filter.retention_type == RETENTION_FIRST_TIME
         trunc_func = get_trunc_func_ch(period)
         prop_filters, prop_filter_params = parse_prop_clauses(filter.properties, team.pk)
 
-        target_query, target_params = self._get_condition(filter.target_entity, table="e")
-        target_query_formatted = "AND {target_query}".format(target_query=target_query)
-        return_query, return_params = self._get_condition(filter.returning_entity, table="e", prepend="returning")
-        return_query_formatted = "AND {return_query}".format(return_query=return_query)
+        target_condition = self._get_condition(filter.target_entity, table="e")
+        target_query_formatted = "AND {target_query}".format(target_query=target_condition.sql)
+        return_condition = self._get_condition(filter.returning_entity, table="e", prepend="returning")
+        return_query_formatted = "AND {return_query}".format(return_query=return_condition.sql)
 
         first_event_sql = (
             REFERENCE_EVENT_UNIQUE_PEOPLE_PER_PERIOD_SQL
@@ -240,9 +338,7 @@ class ClickhouseRetention(Retention):
         date_from = filter.date_from + filter.selected_interval * filter.period_increment
         date_to = filter.date_to
 
-        filter = filter.with_data({"total_intervals": filter.total_intervals - filter.selected_interval})
-
-        query_result = sync_execute(
+        return (
             RETENTION_PEOPLE_PER_PERIOD_SQL.format(
                 returning_query=return_query_formatted,
                 filters=prop_filters,
@@ -250,6 +346,7 @@ class ClickhouseRetention(Retention):
                 first_event_default_sql=default_event_query,
                 trunc_func=trunc_func,
                 latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+                limit=limit_sql,
             ),
             {
                 "team_id": team.pk,
@@ -262,20 +359,8 @@ class ClickhouseRetention(Retention):
                 "offset": filter.offset,
                 "limit": 100,
                 "period": period,
-                **target_params,
-                **return_params,
+                **target_condition.params,
+                **return_condition.params,
                 **prop_filter_params,
             },
         )
-        people_dict = {}
-
-        from posthog.api.person import PersonSerializer
-
-        people = get_persons_by_uuids(team_id=team.pk, uuids=[val[0] for val in query_result])
-        people = people.prefetch_related(Prefetch("persondistinctid_set", to_attr="distinct_ids_cache"))
-
-        for person in people:
-            people_dict.update({str(person.uuid): PersonSerializer(person).data})
-
-        result = self.process_people_in_period(filter, query_result, people_dict)
-        return result
@@ -19,7 +19,8 @@ SINGLE_RECORDING_QUERY = """
     WHERE
         team_id = %(team_id)s
         AND session_id = %(session_id)s
-    ORDER BY timestamp
+    ORDER BY timestamp, uuid
+    {limit_clause}
 """
 
 SESSIONS_IN_RANGE_QUERY = """
@@ -50,9 +51,13 @@ SESSIONS_IN_RANGE_QUERY_COLUMNS = ["session_id", "distinct_id", "start_time", "e
 
 class SessionRecording(BaseSessionRecording):
     def query_recording_snapshots(
-        self, team: Team, session_id: str
+        self, team: Team, session_id: str, offset: int = 0, limit: Optional[int] = None
     ) -> Tuple[Optional[DistinctId], Optional[datetime.datetime], Snapshots]:
-        response = sync_execute(SINGLE_RECORDING_QUERY, {"team_id": team.id, "session_id": session_id})
+        limit_clause = "LIMIT %(limit)s OFFSET %(offset)s" if limit is not None else ""
+        response = sync_execute(
+            SINGLE_RECORDING_QUERY.format(limit_clause=limit_clause),
+            {"team_id": team.id, "session_id": session_id, "limit": limit, "offset": offset},
+        )
         if len(response) == 0:
             return None, None, []
         return response[0][0], response[0][1], [json.loads(snapshot_data) for _, _, snapshot_data in response]
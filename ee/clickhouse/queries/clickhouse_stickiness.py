@@ -1,5 +1,5 @@
 from datetime import datetime
-from typing import Any, Dict, Optional, Tuple
+from typing import Any, Dict, List, Optional, Tuple
 
 from django.conf import settings
 from django.db.models.expressions import F
@@ -20,9 +20,9 @@ from ee.clickhouse.sql.person import (
     PERSON_STATIC_COHORT_TABLE,
 )
 from ee.clickhouse.sql.stickiness.stickiness import STICKINESS_SQL
-from ee.clickhouse.sql.stickiness.stickiness_actions import STICKINESS_ACTIONS_SQL
+from ee.clickhouse.sql.stickiness.stickiness_activity import STICKINESS_ACTIVITY_SQL, STICKINESS_ACTIVITY_STORED_SQL
 from ee.clickhouse.sql.stickiness.stickiness_people import STICKINESS_PEOPLE_SQL
-from posthog.constants import TREND_FILTER_TYPE_ACTIONS
+from posthog.constants import TREND_FILTER_TYPE_ACTIONS, TREND_FILTER_TYPE_EVENTS
 from posthog.models.action import Action
 from posthog.models.cohort import Cohort
 from posthog.models.entity import Entity
@@ -33,46 +33,24 @@ from posthog.queries.stickiness import Stickiness
 
 class ClickhouseStickiness(Stickiness):
     def stickiness(self, entity: Entity, filter: StickinessFilter, team_id: int) -> Dict[str, Any]:
-
-        parsed_date_from, parsed_date_to, _ = parse_timestamps(filter=filter, team_id=team_id)
-        prop_filters, prop_filter_params = parse_prop_clauses(filter.properties, team_id)
-        trunc_func = get_trunc_func_ch(filter.interval)
-
-        params: Dict = {"team_id": team_id}
-        params = {**params, **prop_filter_params, "num_intervals": filter.total_intervals}
         if entity.type == TREND_FILTER_TYPE_ACTIONS:
             action = Action.objects.get(pk=entity.id)
-            action_query, action_params = format_action_filter(action)
+            action_query, _ = format_action_filter(action)
             if action_query == "":
                 return {}
 
-            params = {**params, **action_params}
-            content_sql = STICKINESS_ACTIONS_SQL.format(
-                team_id=team_id,
-                actions_query=action_query,
-                parsed_date_from=parsed_date_from,
-                parsed_date_to=parsed_date_to,
-                filters=prop_filters,
-                trunc_func=trunc_func,
-                latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
-            )
-        else:
-            content_sql = STICKINESS_SQL.format(
-                team_id=team_id,
-                event=entity.id,
-                parsed_date_from=parsed_date_from,
-                parsed_date_to=parsed_date_to,
-                filters=prop_filters,
-                trunc_func=trunc_func,
-                latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
-            )
-
-        counts = sync_execute(content_sql, params)
+        activity_sql, params = _process_activity_sql(entity, filter, team_id)
+        content_sql = STICKINESS_SQL.format(activity_sql=activity_sql)
+        counts = sync_execute(content_sql, {**params, "num_intervals": filter.total_intervals})
         return self.process_result(counts, filter)
 
     def _retrieve_people(self, target_entity: Entity, filter: StickinessFilter, team: Team) -> ReturnDict:
         return retrieve_stickiness_people(target_entity, filter, team)
 
+    def people_uuids(self, target_entity: Entity, filter: StickinessFilter, team: Team) -> List[str]:
+        content_sql, params = _process_content_sql(target_entity, filter, team)
+        return sorted(str(row[0]) for row in sync_execute(content_sql, params))
+
 
 def _format_entity_filter(entity: Entity) -> Tuple[str, Dict]:
     if entity.type == TREND_FILTER_TYPE_ACTIONS:
@@ -90,23 +68,56 @@ def _format_entity_filter(entity: Entity) -> Tuple[str, Dict]:
     return entity_filter, params
 
 
-def _process_content_sql(target_entity: Entity, filter: StickinessFilter, team: Team) -> Tuple[str, Dict[str, Any]]:
-    parsed_date_from, parsed_date_to, _ = parse_timestamps(filter=filter, team_id=team.pk)
-    prop_filters, prop_filter_params = parse_prop_clauses(
-        filter.properties, team.pk, filter_test_accounts=filter.filter_test_accounts
+# Interval types events_activity keeps bitmaps for
+STORED_ACTIVITY_INTERVALS = ["hour", "day", "week", "month"]
+
+
+def can_use_stored_activity(entity: Entity, filter: StickinessFilter) -> bool:
+    """
+    Plain events read their bitmaps from events_activity. Actions and property filters (test accounts included) are
+    only known at query time, so they are read from the raw events.
+    """
+    return (
+        entity.type == TREND_FILTER_TYPE_EVENTS
+        and not filter.properties
+        and not filter.filter_test_accounts
+        and (filter.interval or "day").lower() in STORED_ACTIVITY_INTERVALS
     )
-    entity_sql, entity_params = _format_entity_filter(entity=target_entity)
+
+
+def _process_activity_sql(entity: Entity, filter: StickinessFilter, team_id: int) -> Tuple[str, Dict[str, Any]]:
+    """
+    Per person activity bitmaps, see `STICKINESS_ACTIVITY_SQL`. Stickiness counts the persons by the cardinality of
+    their bitmap and its people filter on it, so both read the events the same way.
+    """
+    parsed_date_from, parsed_date_to, date_params = parse_timestamps(filter=filter, team_id=team_id)
     trunc_func = get_trunc_func_ch(filter.interval)
 
-    params: Dict = {
-        "team_id": team.pk,
-        **prop_filter_params,
-        "stickiness_day": filter.selected_interval,
-        **entity_params,
-        "offset": filter.offset,
-    }
+    if can_use_stored_activity(entity, filter):
+        interval_from = "0"
+        if "date_from" in date_params:
+            interval_from = "toUInt32({}(toDateTime(%(date_from)s, 'UTC')))".format(trunc_func)
+        activity_sql = STICKINESS_ACTIVITY_STORED_SQL.format(
+            interval_from=interval_from,
+            interval_to="toUInt32({}(toDateTime(%(date_to)s, 'UTC')) + 1)".format(trunc_func),
+            latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+        )
+        return (
+            activity_sql,
+            {
+                "team_id": team_id,
+                "event": entity.id,
+                "interval_type": (filter.interval or "day").lower(),
+                **date_params,
+            },
+        )
+
+    prop_filters, prop_filter_params = parse_prop_clauses(
+        filter.properties, team_id, filter_test_accounts=filter.filter_test_accounts
+    )
+    entity_sql, entity_params = _format_entity_filter(entity=entity)
 
-    content_sql = STICKINESS_PEOPLE_SQL.format(
+    activity_sql = STICKINESS_ACTIVITY_SQL.format(
         entity_filter=entity_sql,
         parsed_date_from=parsed_date_from,
         parsed_date_to=parsed_date_to,
@@ -114,7 +125,13 @@ def _process_content_sql(target_entity: Entity, filter: StickinessFilter, team:
         trunc_func=trunc_func,
         latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
     )
-    return content_sql, params
+    return activity_sql, {"team_id": team_id, **prop_filter_params, **entity_params}
+
+
+def _process_content_sql(target_entity: Entity, filter: StickinessFilter, team: Team) -> Tuple[str, Dict[str, Any]]:
+    activity_sql, params = _process_activity_sql(target_entity, filter, team.pk)
+    content_sql = STICKINESS_PEOPLE_SQL.format(activity_sql=activity_sql)
+    return content_sql, {**params, "stickiness_day": filter.selected_interval, "offset": filter.offset}
 
 
 def retrieve_stickiness_people(target_entity: Entity, filter: StickinessFilter, team: Team) -> ReturnDict:
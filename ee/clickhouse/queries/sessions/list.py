@@ -31,30 +31,38 @@ class ClickhouseSessionsList(SessionsList):
         action_filters = format_action_filters(self.filter)
 
         date_from, date_to, _ = parse_timestamps(self.filter, self.team.pk)
-        distinct_ids = self.fetch_distinct_ids(action_filters, date_from, date_to, limit, distinct_id_offset)
+        distinct_ids_query, distinct_id_count_query, distinct_ids_params = self.distinct_ids_query(
+            action_filters, date_from, date_to, limit, distinct_id_offset
+        )
 
         query = SESSION_SQL.format(
             date_from=date_from,
             date_to=date_to,
+            distinct_ids=distinct_ids_query,
+            distinct_id_count=distinct_id_count_query,
             filters_select_clause=action_filters.select_clause,
             matches_action_clauses=action_filters.matches_action_clauses,
             filters_having=action_filters.filters_having,
             sessions_limit="LIMIT %(offset)s, %(limit)s",
         )
-        query_result = sync_execute(
-            query,
-            {
-                **action_filters.params,
-                "team_id": self.team.pk,
-                "limit": limit,
-                "offset": offset,
-                "distinct_ids": distinct_ids,
-            },
-        )
+        params = {
+            **action_filters.params,
+            **distinct_ids_params,
+            "team_id": self.team.pk,
+            "limit": limit,
+            "offset": offset,
+        }
+        query_result = sync_execute(query, params)
         result = self._parse_list_results(query_result)
 
+        if query_result:
+            distinct_id_count = query_result[0][10]
+        else:
+            # No session of these people matched every filter, the next ones might still
+            distinct_id_count = sync_execute(f"SELECT {distinct_id_count_query}", params)[0][0]
+
         pagination = None
-        if len(distinct_ids) >= limit + distinct_id_offset or len(result) == limit:
+        if distinct_id_count >= limit + distinct_id_offset or len(result) == limit:
             if len(result) == limit:
                 result.pop()
             pagination = {"offset": offset + len(result), "distinct_id_offset": distinct_id_offset + limit}
@@ -63,27 +71,30 @@ class ClickhouseSessionsList(SessionsList):
 
         return filter_sessions_by_recordings(self.team, result, self.filter), pagination
 
-    def fetch_distinct_ids(
+    def distinct_ids_query(
         self, action_filters: ActionFiltersSQL, date_from: str, date_to: str, limit: int, distinct_id_offset: int
-    ) -> List[str]:
+    ) -> Tuple[str, str, Dict]:
+        """The distinct ids to list sessions of and their count, as subqueries of the sessions query."""
         if self.filter.distinct_id:
             persons = get_persons_by_distinct_ids(self.team.pk, [self.filter.distinct_id])
-            return persons[0].distinct_ids if len(persons) > 0 else []
+            distinct_ids = persons[0].distinct_ids if len(persons) > 0 else []
+            return (
+                "%(distinct_ids)s",
+                "%(distinct_id_count)s",
+                {"distinct_ids": distinct_ids, "distinct_id_count": len(distinct_ids)},
+            )
 
         person_filters, person_filter_params = parse_prop_clauses(self.filter.person_filter_properties, self.team.pk)
-        return sync_execute(
-            SESSIONS_DISTINCT_ID_SQL.format(
-                date_from=date_from,
-                date_to=date_to,
-                person_filters=person_filters,
-                action_filters=action_filters.matches_any_clause,
-            ),
-            {
-                **person_filter_params,
-                **action_filters.params,
-                "team_id": self.team.pk,
-                "distinct_id_limit": distinct_id_offset + limit,
-            },
+        query = SESSIONS_DISTINCT_ID_SQL.format(
+            date_from=date_from,
+            date_to=date_to,
+            person_filters=person_filters,
+            action_filters=action_filters.matches_any_clause,
+        )
+        return (
+            f"({query})",
+            f"(SELECT count() FROM ({query}))",
+            {**person_filter_params, "distinct_id_limit": distinct_id_offset + limit},
         )
 
     def _add_person_properties(self, sessions: List[Session]):
@@ -134,7 +145,7 @@ class ClickhouseSessionsList(SessionsList):
                     "event_count": len(result[4]),
                     "events": list(events),
                     "properties": {},
-                    "matching_events": list(sorted(set(flatten(result[10:])))),
+                    "matching_events": list(sorted(set(flatten(result[11:])))),
                 }
             )
 
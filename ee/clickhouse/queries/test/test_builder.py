@@ -0,0 +1,60 @@
+from django.test import SimpleTestCase
+
+from ee.clickhouse.queries.builder import Fragment, Select, column_equals, merge_params, query_shape_hash
+
+
+class TestQueryBuilder(SimpleTestCase):
+    def test_raw_strips_leading_and(self):
+        fragment = Fragment.raw(" AND  has(%(vals)s, event)", {"vals": []})
+        self.assertEqual(fragment.sql, "(has(%(vals)s, event))")  # type: ignore
+        self.assertIsNone(Fragment.raw(""))
+
+    def test_namespaced_only_renames_owned_params(self):
+        fragment = Fragment("team_id = %(team_id)s AND timestamp >= %(date_from)s", {"date_from": "2021-01-01"})
+        namespaced = fragment.namespaced("props")
+        self.assertEqual(namespaced.sql, "team_id = %(team_id)s AND timestamp >= %(props_date_from)s")
+        self.assertEqual(namespaced.params, {"props_date_from": "2021-01-01"})
+
+    def test_merge_params_rejects_conflicts(self):
+        self.assertEqual(merge_params({"a": 1}, {"a": 1, "b": 2}), {"a": 1, "b": 2})
+        with self.assertRaises(ValueError):
+            merge_params({"date_from": "2021-01-01"}, {"date_from": "2020-01-01"})
+
+    def test_event_conditions_move_to_prewhere(self):
+        sql, params = (
+            Select("count(*) as data", from_="events")
+            .where(
+                column_equals("team_id", "team_id", 2),
+                column_equals("event", "event", "$pageview"),
+                Fragment.raw("AND properties != ''"),
+            )
+            .build()
+        )
+        self.assertEqual(
+            sql,
+            "SELECT count(*) as data\nFROM events\nPREWHERE event = %(event)s\n"
+            "WHERE team_id = %(team_id)s AND (properties != '')",
+        )
+        self.assertEqual(params, {"team_id": 2, "event": "$pageview"})
+
+    def test_materialized_columns_move_to_prewhere(self):
+        query = Select("count(*)", from_="events").where(column_equals("properties_plan", "plan", "pro"))
+        self.assertNotIn("PREWHERE", query.build()[0])
+        with self.settings(CLICKHOUSE_DENORMALIZED_PROPERTIES=["plan"]):
+            self.assertIn("PREWHERE properties_plan = %(plan)s", query.build()[0])
+
+    def test_subquery_params_are_merged(self):
+        inner = Select("person_id", from_="events").where(column_equals("event", "event", "$pageview"))
+        sql, params = Select("count(*)", from_=inner).where(Fragment("1 = %(one)s", {"one": 1})).build()
+        self.assertIn("FROM (SELECT person_id\nFROM events\nPREWHERE event = %(event)s)", sql)
+        self.assertEqual(params, {"event": "$pageview", "one": 1})
+
+    def test_shape_hash_ignores_literals_and_whitespace(self):
+        self.assertEqual(
+            query_shape_hash("SELECT * FROM events WHERE team_id = 2 AND event = '$pageview'"),
+            query_shape_hash("select *  from events\nwhere team_id = 5 and event = 'sign up'"),
+        )
+        self.assertNotEqual(
+            query_shape_hash("SELECT * FROM events WHERE team_id = 2"),
+            query_shape_hash("SELECT * FROM events WHERE team_id = 2 AND event = 'x'"),
+        )
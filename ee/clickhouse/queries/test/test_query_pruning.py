@@ -0,0 +1,99 @@
+import re
+from uuid import uuid4
+
+from freezegun import freeze_time
+
+from ee.clickhouse.explain import QueryExplainer
+from ee.clickhouse.models.event import create_event
+from ee.clickhouse.queries.clickhouse_funnel import ClickhouseFunnel
+from ee.clickhouse.queries.clickhouse_paths import ClickhousePaths
+from ee.clickhouse.queries.clickhouse_retention import ClickhouseRetention
+from ee.clickhouse.queries.clickhouse_stickiness import ClickhouseStickiness
+from ee.clickhouse.queries.sessions.clickhouse_sessions import ClickhouseSessions
+from ee.clickhouse.queries.trends.clickhouse_trends import ClickhouseTrends
+from ee.clickhouse.queries.util import get_earliest_timestamp
+from ee.clickhouse.util import ClickhouseTestMixin
+from posthog.constants import TRENDS_LIFECYCLE
+from posthog.models.filters import Filter, RetentionFilter
+from posthog.models.filters.path_filter import PathFilter
+from posthog.models.filters.sessions_filter import SessionsFilter
+from posthog.models.filters.stickiness_filter import StickinessFilter
+from posthog.models.person import Person
+from posthog.test.base import BaseTest
+
+DATE_RANGE = {"date_from": "2021-01-01", "date_to": "2021-01-14"}
+EVENTS = [{"id": "$pageview", "order": 0}, {"id": "$pageleave", "order": 1}]
+EVENTS_READ_REGEX = re.compile(r"\bfrom\s+events\b", re.IGNORECASE)
+
+
+@freeze_time("2021-01-15T12:00:00Z")
+class TestQueryPruning(ClickhouseTestMixin, BaseTest):
+    """
+    Every insight should only read the granules of its team and date range: each read from the events table has to
+    use both `team_id` and `toDate(timestamp)` of the sorting key.
+    """
+
+    def setUp(self):
+        super().setUp()
+        Person.objects.create(team=self.team, distinct_ids=["1"])
+        for event, timestamp in [("$pageview", "2021-01-04T12:00:00Z"), ("$pageleave", "2021-01-05T12:00:00Z")]:
+            create_event(team=self.team, event=event, distinct_id="1", timestamp=timestamp, event_uuid=uuid4())
+
+    def assertPrunesByTeamAndDate(self, run):
+        with QueryExplainer() as explainer:
+            run()
+
+        events_queries = [query for query in explainer.queries if EVENTS_READ_REGEX.search(query["sql"])]
+        self.assertTrue(events_queries)
+        for query in events_queries:
+            self.assertNotIn("error", query, query["sql"])
+            # The plan doesn't name the table of each read, but only reads of events can use both keys: every
+            # `FROM events` of the query needs a read of its own that does
+            pruned_reads = {
+                index["read"]
+                for index in query["indexes"]
+                if index["type"] == "PrimaryKey" and {"team_id", "toDate(timestamp)"} <= set(index["keys"])
+            }
+            self.assertGreaterEqual(len(pruned_reads), len(EVENTS_READ_REGEX.findall(query["sql"])), query["sql"])
+
+    def test_trends(self):
+        self.assertPrunesByTeamAndDate(
+            lambda: ClickhouseTrends().run(Filter(data={"events": EVENTS, **DATE_RANGE}), self.team)
+        )
+
+    def test_trends_with_property_filter(self):
+        filter = Filter(data={"events": EVENTS, "properties": [{"key": "$browser", "value": "Chrome"}], **DATE_RANGE})
+        self.assertPrunesByTeamAndDate(lambda: ClickhouseTrends().run(filter, self.team))
+
+    def test_lifecycle(self):
+        filter = Filter(data={"events": EVENTS[:1], "shown_as": TRENDS_LIFECYCLE, **DATE_RANGE})
+        self.assertPrunesByTeamAndDate(lambda: ClickhouseTrends().run(filter, self.team))
+
+    def test_stickiness(self):
+        # Plain events read the activity bitmaps of events_activity, a property filter reads the events
+        filter = StickinessFilter(
+            data={
+                "events": EVENTS[:1],
+                "shown_as": "Stickiness",
+                "properties": [{"key": "$browser", "value": "Chrome"}],
+                **DATE_RANGE,
+            },
+            team=self.team,
+            get_earliest_timestamp=get_earliest_timestamp,
+        )
+        self.assertPrunesByTeamAndDate(lambda: ClickhouseStickiness().run(filter, self.team))
+
+    def test_funnel(self):
+        filter = Filter(data={"events": EVENTS, "insight": "FUNNELS", **DATE_RANGE})
+        self.assertPrunesByTeamAndDate(lambda: ClickhouseFunnel(filter, self.team).run())
+
+    def test_retention(self):
+        filter = RetentionFilter(data={"date_to": "2021-01-14", "total_intervals": 7})
+        self.assertPrunesByTeamAndDate(lambda: ClickhouseRetention().run(filter, self.team))
+
+    def test_paths(self):
+        self.assertPrunesByTeamAndDate(lambda: ClickhousePaths().run(PathFilter(data=DATE_RANGE), self.team))
+
+    def test_sessions(self):
+        filter = SessionsFilter(data={"session": "avg", "events": EVENTS[:1], **DATE_RANGE})
+        self.assertPrunesByTeamAndDate(lambda: ClickhouseSessions().run(filter, self.team))
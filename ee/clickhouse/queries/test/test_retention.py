@@ -9,6 +9,7 @@ from ee.clickhouse.util import ClickhouseTestMixin
 from posthog.models.action import Action
 from posthog.models.action_step import ActionStep
 from posthog.models.filters import Filter
+from posthog.models.filters.retention_filter import RetentionFilter
 from posthog.models.person import Person
 from posthog.queries.test.test_retention import retention_test_factory
 
@@ -28,8 +29,29 @@ def _create_action(**kwargs):
 
 def _create_person(**kwargs):
     person = Person.objects.create(**kwargs)
-    return person
+    return Person(id=person.uuid)
 
 
 class TestClickhouseRetention(ClickhouseTestMixin, retention_test_factory(ClickhouseRetention, _create_event, _create_person, _create_action)):  # type: ignore
-    pass
+    def test_retention_people_offset(self):
+        for i in range(110):
+            distinct_id = "person{}".format(i)
+            _create_person(team_id=self.team.pk, distinct_ids=[distinct_id])
+            for day in (10, 12):
+                _create_event(
+                    team=self.team,
+                    event="$pageview",
+                    distinct_id=distinct_id,
+                    timestamp=datetime(2020, 6, day, 5, tzinfo=pytz.UTC),
+                )
+
+        data = {"date_to": datetime(2020, 6, 20, 6, tzinfo=pytz.UTC).isoformat(), "selected_interval": 2}
+        first_page = ClickhouseRetention().people(RetentionFilter(data=data), self.team)
+        second_page = ClickhouseRetention().people(RetentionFilter(data={**data, "offset": 100}), self.team)
+
+        self.assertEqual(len(first_page), 100)
+        self.assertEqual(len(second_page), 10)
+        # the drilldown uuids ignore the offset
+        uuids = ClickhouseRetention().people_uuids(RetentionFilter(data={**data, "offset": 100}), self.team)
+        self.assertEqual(len(uuids), 110)
+        self.assertTrue({str(person["id"]) for person in first_page + second_page} <= set(uuids))
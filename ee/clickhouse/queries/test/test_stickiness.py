@@ -1,3 +1,4 @@
+from unittest.mock import patch
 from uuid import uuid4
 
 from ee.clickhouse.models.event import create_event
@@ -6,6 +7,8 @@ from ee.clickhouse.queries.util import get_earliest_timestamp
 from ee.clickhouse.util import ClickhouseTestMixin
 from posthog.models.action import Action
 from posthog.models.action_step import ActionStep
+from posthog.models.entity import Entity
+from posthog.models.filters.stickiness_filter import StickinessFilter
 from posthog.models.person import Person
 from posthog.queries.test.test_stickiness import stickiness_test_factory
 
@@ -30,4 +33,35 @@ def _create_person(**kwargs):
 
 
 class TestClickhouseStickiness(ClickhouseTestMixin, stickiness_test_factory(ClickhouseStickiness, _create_event, _create_person, _create_action, get_earliest_timestamp)):  # type: ignore
-    pass
+    def test_stored_activity_matches_events(self):
+        self._create_multiple_people()
+        # outside of the date range, so it's cut from the stored bitmap
+        _create_event(team=self.team, event="watched movie", distinct_id="person1", timestamp="2019-12-20T12:00:00Z")
+
+        for interval, date_from, date_to in [
+            ("hour", "2020-01-01T12:00:00Z", "2020-01-02T00:00:00Z"),
+            ("day", "2020-01-01", "2020-01-08"),
+            ("week", "2019-12-29", "2020-01-25"),
+            ("month", "2020-01-01", "2020-01-31"),
+        ]:
+            filter = StickinessFilter(
+                data={
+                    "shown_as": "Stickiness",
+                    "date_from": date_from,
+                    "date_to": date_to,
+                    "events": [{"id": "watched movie"}],
+                    "interval": interval,
+                },
+                team=self.team,
+                get_earliest_timestamp=get_earliest_timestamp,
+            )
+            entity = Entity({"id": "watched movie", "type": "events"})
+            people_filter = filter.with_data({"stickiness_days": 1})
+            stored = ClickhouseStickiness().run(filter, self.team)
+            stored_people = ClickhouseStickiness().people_uuids(entity, people_filter, self.team)
+            with patch("ee.clickhouse.queries.clickhouse_stickiness.can_use_stored_activity", return_value=False):
+                from_events = ClickhouseStickiness().run(filter, self.team)
+                people_from_events = ClickhouseStickiness().people_uuids(entity, people_filter, self.team)
+
+            self.assertEqual(stored[0]["data"], from_events[0]["data"], interval)
+            self.assertEqual(stored_people, people_from_events, interval)
@@ -1,6 +1,7 @@
 from typing import Any, Callable, Dict, List, Optional, Tuple, Union
 
 from django.db.models.manager import BaseManager
+from sentry_sdk.api import capture_exception
 
 from ee.clickhouse.client import sync_execute
 from ee.clickhouse.models.action import format_action_filter
@@ -23,8 +24,12 @@ from ee.clickhouse.sql.trends.breakdown import (
     BREAKDOWN_PROP_JOIN_SQL,
     BREAKDOWN_QUERY_SQL,
 )
-from ee.clickhouse.sql.trends.top_elements import TOP_ELEMENTS_ARRAY_OF_KEY_SQL
-from ee.clickhouse.sql.trends.top_person_props import TOP_PERSON_PROPS_ARRAY_OF_KEY_SQL
+from ee.clickhouse.queries.trends.top_values import can_merge_daily_top_values, get_top_values_from_daily
+from ee.clickhouse.sql.trends.top_elements import TOP_ELEMENTS_ARRAY_OF_KEY_SQL, TOP_ELEMENTS_OF_KEY_BY_DAY_SQL
+from ee.clickhouse.sql.trends.top_person_props import (
+    TOP_PERSON_PROPS_ARRAY_OF_KEY_SQL,
+    TOP_PERSON_PROPS_OF_KEY_BY_DAY_SQL,
+)
 from posthog.constants import MONTHLY_ACTIVE, TREND_FILTER_TYPE_ACTIONS, TRENDS_DISPLAY_BY_VALUE, WEEKLY_ACTIVE
 from posthog.models.action import Action
 from posthog.models.cohort import Cohort
@@ -172,7 +177,7 @@ class ClickhouseTrendsBreakdown:
         return params, breakdown_filter, breakdown_filter_params, "value"
 
     def _breakdown_person_params(self, aggregate_operation: str, filter: Filter, team_id: int):
-        parsed_date_from, parsed_date_to, _ = parse_timestamps(filter=filter, team_id=team_id)
+        parsed_date_from, parsed_date_to, date_params = parse_timestamps(filter=filter, team_id=team_id)
         prop_filters, prop_filter_params = parse_prop_clauses(
             filter.properties, team_id, table_name="e", filter_test_accounts=filter.filter_test_accounts
         )
@@ -184,7 +189,7 @@ class ClickhouseTrendsBreakdown:
             is_person_query=True,
         )
 
-        elements_query = TOP_PERSON_PROPS_ARRAY_OF_KEY_SQL.format(
+        query_params = dict(
             parsed_date_from=parsed_date_from,
             parsed_date_to=parsed_date_to,
             latest_person_sql=GET_LATEST_PERSON_SQL.format(query=""),
@@ -194,7 +199,13 @@ class ClickhouseTrendsBreakdown:
             latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
         )
         top_elements_array = self._get_top_elements(
-            elements_query, filter, team_id, params={**prop_filter_params, **person_prop_params}
+            TOP_PERSON_PROPS_ARRAY_OF_KEY_SQL.format(**query_params),
+            filter,
+            team_id,
+            params={**prop_filter_params, **person_prop_params},
+            daily_query=TOP_PERSON_PROPS_OF_KEY_BY_DAY_SQL.format(**query_params),
+            aggregate_operation=aggregate_operation,
+            date_params=date_params,
         )
         params = {
             "values": top_elements_array,
@@ -207,17 +218,25 @@ class ClickhouseTrendsBreakdown:
         return params, breakdown_filter, breakdown_filter_params, "value"
 
     def _breakdown_prop_params(self, aggregate_operation: str, filter: Filter, team_id: int):
-        parsed_date_from, parsed_date_to, _ = parse_timestamps(filter=filter, team_id=team_id)
+        parsed_date_from, parsed_date_to, date_params = parse_timestamps(filter=filter, team_id=team_id)
         prop_filters, prop_filter_params = parse_prop_clauses(
             filter.properties, team_id, table_name="e", filter_test_accounts=filter.filter_test_accounts
         )
-        elements_query = TOP_ELEMENTS_ARRAY_OF_KEY_SQL.format(
+        query_params = dict(
             parsed_date_from=parsed_date_from,
             parsed_date_to=parsed_date_to,
             prop_filters=prop_filters,
             aggregate_operation=aggregate_operation,
         )
-        top_elements_array = self._get_top_elements(elements_query, filter, team_id, params=prop_filter_params)
+        top_elements_array = self._get_top_elements(
+            TOP_ELEMENTS_ARRAY_OF_KEY_SQL.format(**query_params),
+            filter,
+            team_id,
+            params=prop_filter_params,
+            daily_query=TOP_ELEMENTS_OF_KEY_BY_DAY_SQL.format(**query_params),
+            aggregate_operation=aggregate_operation,
+            date_params=date_params,
+        )
         params = {
             "values": top_elements_array,
         }
@@ -282,14 +301,33 @@ class ClickhouseTrendsBreakdown:
         else:
             return str(value) or ""
 
-    def _get_top_elements(self, query: str, filter: Filter, team_id: int, params: Dict = {}) -> List:
+    def _get_top_elements(
+        self,
+        query: str,
+        filter: Filter,
+        team_id: int,
+        params: Dict = {},
+        daily_query: Optional[str] = None,
+        aggregate_operation: str = "",
+        date_params: Dict = {},
+    ) -> List:
         # use limit of 25 to determine if there are more than 20
-        element_params = {"key": filter.breakdown, "limit": 25, "team_id": team_id, "offset": filter.offset, **params}
-
+        limit = 25
         try:
-            top_elements_array_result = sync_execute(query, element_params)
+            if daily_query and can_merge_daily_top_values(aggregate_operation, limit, filter.offset):
+                return get_top_values_from_daily(
+                    daily_query,
+                    {"key": filter.breakdown, "team_id": team_id, **params},
+                    date_params.get("date_from"),
+                    date_params["date_to"],
+                    limit,
+                    filter.offset,
+                )
+            element_params = {"key": filter.breakdown, "limit": limit, "team_id": team_id, "offset": filter.offset}
+            top_elements_array_result = sync_execute(query, {**element_params, **params})
             top_elements_array = top_elements_array_result[0][0]
-        except:
+        except Exception as e:
+            capture_exception(e)
             top_elements_array = []
 
         return top_elements_array
@@ -3,6 +3,7 @@ from itertools import accumulate
 from typing import Any, Dict, List
 
 from ee.clickhouse.client import sync_execute
+from ee.clickhouse.queries.builder import namespace_params
 from ee.clickhouse.queries.trends.util import parse_response
 from posthog.constants import TRENDS_CUMULATIVE, TRENDS_DISPLAY_BY_VALUE
 from posthog.models.cohort import Cohort
@@ -25,8 +26,7 @@ class ClickhouseTrendsFormula:
         params: Dict[str, Any] = {}
         for idx, entity in enumerate(filter.entities):
             sql, entity_params, _ = self._get_sql_for_entity(filter, entity, team_id)  # type: ignore
-            sql = sql.replace("%(", "%({}_".format(idx))
-            entity_params = {"{}_{}".format(idx, key): value for key, value in entity_params.items()}
+            sql, entity_params = namespace_params(sql, entity_params, str(idx))
             queries.append(sql)
             params = {**params, **entity_params}
 
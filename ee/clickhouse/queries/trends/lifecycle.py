@@ -10,12 +10,17 @@ from ee.clickhouse.models.person import get_persons_by_distinct_ids, get_persons
 from ee.clickhouse.models.property import parse_prop_clauses
 from ee.clickhouse.queries.trends.util import parse_response
 from ee.clickhouse.queries.util import get_earliest_timestamp, get_time_diff, get_trunc_func_ch, parse_timestamps
-from ee.clickhouse.sql.trends.lifecycle import LIFECYCLE_PEOPLE_SQL, LIFECYCLE_SQL
+from ee.clickhouse.sql.trends.lifecycle import (
+    EARLIEST_EVENTS_SQL,
+    EARLIEST_FIRST_SEEN_SQL,
+    LIFECYCLE_PEOPLE_SQL,
+    LIFECYCLE_SQL,
+)
 from posthog.constants import TREND_FILTER_TYPE_ACTIONS
 from posthog.models.action import Action
 from posthog.models.entity import Entity
 from posthog.models.filters import Filter
-from posthog.queries.lifecycle import LifecycleTrend
+from posthog.queries.lifecycle import LifecycleTrend, can_use_first_seen
 
 
 class ClickhouseLifecycle(LifecycleTrend):
@@ -70,6 +75,7 @@ class ClickhouseLifecycle(LifecycleTrend):
                 event_query=event_query,
                 filters=prop_filters,
                 sub_interval=sub_interval_string,
+                earliest=self._earliest_sql(entity, filter, trunc_func, event_query, prop_filters),
             ),
             {
                 "team_id": team_id,
@@ -87,6 +93,14 @@ class ClickhouseLifecycle(LifecycleTrend):
             self._parse_result(filter, entity),
         )
 
+    def _earliest_sql(
+        self, entity: Entity, filter: Filter, trunc_func: str, event_query: str, prop_filters: str
+    ) -> str:
+        """When each person first did the entity, to tell new people apart from resurrecting ones."""
+        if can_use_first_seen(filter, entity):
+            return EARLIEST_FIRST_SEEN_SQL.format(trunc_func=trunc_func)
+        return EARLIEST_EVENTS_SQL.format(trunc_func=trunc_func, event_query=event_query, filters=prop_filters)
+
     def _parse_result(self, filter: Filter, entity: Entity) -> Callable:
         def _parse(result: List) -> List:
             res = []
@@ -103,6 +117,28 @@ class ClickhouseLifecycle(LifecycleTrend):
     def get_people(
         self, filter: Filter, team_id: int, target_date: datetime, lifecycle_type: str, limit: int = 100,
     ):
+        uuids = self._get_people_uuids(
+            filter, team_id, target_date, lifecycle_type, limit_sql="LIMIT %(limit)s OFFSET %(offset)s", limit=limit,
+        )
+        people = get_persons_by_uuids(team_id=team_id, uuids=uuids)
+        people = people.prefetch_related(Prefetch("persondistinctid_set", to_attr="distinct_ids_cache"))
+
+        from posthog.api.person import PersonSerializer
+
+        return PersonSerializer(people, many=True).data
+
+    def get_people_uuids(self, filter: Filter, team_id: int, target_date: datetime, lifecycle_type: str) -> List[str]:
+        return sorted(self._get_people_uuids(filter, team_id, target_date, lifecycle_type, limit_sql=""))
+
+    def _get_people_uuids(
+        self,
+        filter: Filter,
+        team_id: int,
+        target_date: datetime,
+        lifecycle_type: str,
+        limit_sql: str,
+        limit: int = 0,
+    ) -> List[str]:
         entity = filter.entities[0]
         date_from = filter.date_from
 
@@ -142,6 +178,8 @@ class ClickhouseLifecycle(LifecycleTrend):
                 event_query=event_query,
                 filters=prop_filters,
                 sub_interval=sub_interval_string,
+                earliest=self._earliest_sql(entity, filter, trunc_func, event_query, prop_filters),
+                limit=limit_sql,
             ),
             {
                 "team_id": team_id,
@@ -165,9 +203,4 @@ class ClickhouseLifecycle(LifecycleTrend):
                 "limit": limit,
             },
         )
-        people = get_persons_by_uuids(team_id=team_id, uuids=[p[0] for p in result])
-        people = people.prefetch_related(Prefetch("persondistinctid_set", to_attr="distinct_ids_cache"))
-
-        from posthog.api.person import PersonSerializer
-
-        return PersonSerializer(people, many=True).data
+        return [str(p[0]) for p in result]
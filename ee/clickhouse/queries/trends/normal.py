@@ -6,11 +6,20 @@ from django.utils import timezone
 from ee.clickhouse.client import format_sql, sync_execute
 from ee.clickhouse.models.action import format_action_filter
 from ee.clickhouse.models.property import parse_prop_clauses
+from ee.clickhouse.queries.builder import Fragment, Select, column_equals
 from ee.clickhouse.queries.trends.util import get_active_user_params, parse_response, process_math
-from ee.clickhouse.queries.util import date_from_clause, get_time_diff, get_trunc_func_ch, parse_timestamps
+from ee.clickhouse.queries.util import (
+    date_from_clause,
+    date_from_condition,
+    get_time_diff,
+    get_trunc_func_ch,
+    parse_prop_conditions,
+    parse_timestamps,
+    timestamp_condition,
+)
 from ee.clickhouse.sql.events import NULL_SQL
 from ee.clickhouse.sql.trends.aggregate import AGGREGATE_SQL
-from ee.clickhouse.sql.trends.volume import ACTIVE_USER_SQL, VOLUME_SQL, VOLUME_TOTAL_AGGREGATE_SQL
+from ee.clickhouse.sql.trends.volume import ACTIVE_USER_SQL
 from posthog.constants import MONTHLY_ACTIVE, TREND_FILTER_TYPE_ACTIONS, TRENDS_DISPLAY_BY_VALUE, WEEKLY_ACTIVE
 from posthog.models.action import Action
 from posthog.models.entity import Entity
@@ -27,58 +36,74 @@ class ClickhouseTrendsNormal:
         _, parsed_date_to, date_params = parse_timestamps(filter=filter, team_id=team_id)
 
         props_to_filter = [*filter.properties, *entity.properties]
-        prop_filters, prop_filter_params = parse_prop_clauses(
-            props_to_filter, team_id, filter_test_accounts=filter.filter_test_accounts
-        )
-
         aggregate_operation, join_condition, math_params = process_math(entity)
 
-        params: Dict = {"team_id": team_id}
-        params = {**params, **prop_filter_params, **math_params, **date_params}
-        content_sql_params = {
-            "interval": interval_annotation,
-            "parsed_date_from": date_from_clause(interval_annotation, round_interval),
-            "parsed_date_to": parsed_date_to,
-            "timestamp": "timestamp",
-            "filters": prop_filters,
-            "event_join": join_condition,
-            "aggregate_operation": aggregate_operation,
-            "entity_query": "AND {actions_query}"
-            if entity.type == TREND_FILTER_TYPE_ACTIONS
-            else "AND event = %(event)s",
-        }
-
-        entity_params, entity_format_params = self._populate_entity_params(entity)
-        params = {**params, **entity_params}
-
-        if filter.display in TRENDS_DISPLAY_BY_VALUE:
-            content_sql = VOLUME_TOTAL_AGGREGATE_SQL.format(**content_sql_params).format(**entity_format_params)
-            time_range = self._enumerate_time_range(filter, seconds_in_interval)
-
-            return (
-                content_sql,
-                params,
-                lambda result: [
-                    {"aggregated_value": result[0][0] if result and len(result) else 0, "days": time_range}
-                ],
+        if filter.display not in TRENDS_DISPLAY_BY_VALUE and entity.math in [WEEKLY_ACTIVE, MONTHLY_ACTIVE]:
+            prop_filters, prop_filter_params = parse_prop_clauses(
+                props_to_filter, team_id, filter_test_accounts=filter.filter_test_accounts
             )
+            params: Dict = {"team_id": team_id}
+            params = {**params, **prop_filter_params, **math_params, **date_params}
+            content_sql_params = {
+                "interval": interval_annotation,
+                "parsed_date_from": date_from_clause(interval_annotation, round_interval),
+                "parsed_date_to": parsed_date_to,
+                "filters": prop_filters,
+                "entity_query": "AND {actions_query}"
+                if entity.type == TREND_FILTER_TYPE_ACTIONS
+                else "AND event = %(event)s",
+            }
+            entity_params, entity_format_params = self._populate_entity_params(entity)
+            params = {**params, **entity_params}
+            sql_params = get_active_user_params(filter, entity, team_id)
+            content_sql = ACTIVE_USER_SQL.format(**content_sql_params, **sql_params).format(**entity_format_params)
         else:
+            prop_conditions = parse_prop_conditions(
+                props_to_filter,
+                team_id,
+                allow_denormalized_props=True,
+                filter_test_accounts=filter.filter_test_accounts,
+            )
+            query = (
+                Select(Fragment("{} as data".format(aggregate_operation), math_params), from_="events")
+                .join(join_condition)
+                .where(
+                    column_equals("team_id", "team_id", team_id),
+                    self._entity_condition(entity),
+                    *prop_conditions,
+                    date_from_condition(interval_annotation, round_interval, date_params["date_from"])
+                    if "date_from" in date_params
+                    else None,
+                    timestamp_condition("<=", "date_to", date_params["date_to"]),
+                )
+            )
+
+            if filter.display in TRENDS_DISPLAY_BY_VALUE:
+                content_sql, params = query.build()
+                time_range = self._enumerate_time_range(filter, seconds_in_interval)
+
+                return (
+                    content_sql,
+                    params,
+                    lambda result: [
+                        {"aggregated_value": result[0][0] if result and len(result) else 0, "days": time_range}
+                    ],
+                )
 
-            if entity.math in [WEEKLY_ACTIVE, MONTHLY_ACTIVE]:
-                sql_params = get_active_user_params(filter, entity, team_id)
-                content_sql = ACTIVE_USER_SQL.format(**content_sql_params, **sql_params).format(**entity_format_params)
-            else:
-                # entity_format_params depends on format clause from content_sql_params
-                content_sql = VOLUME_SQL.format(**content_sql_params).format(**entity_format_params)
-
-            null_sql = NULL_SQL.format(
-                interval=interval_annotation,
-                seconds_in_interval=seconds_in_interval,
-                num_intervals=num_intervals,
-                date_to=filter.date_to.strftime("%Y-%m-%d %H:%M:%S"),
+            content_sql, params = (
+                query.select("toDateTime({}(timestamp), 'UTC') as date".format(interval_annotation))
+                .group_by("{}(timestamp)".format(interval_annotation))
+                .build()
             )
-            final_query = AGGREGATE_SQL.format(null_sql=null_sql, content_sql=content_sql)
-            return final_query, params, self._parse_normal_result(filter)
+
+        null_sql = NULL_SQL.format(
+            interval=interval_annotation,
+            seconds_in_interval=seconds_in_interval,
+            num_intervals=num_intervals,
+            date_to=filter.date_to.strftime("%Y-%m-%d %H:%M:%S"),
+        )
+        final_query = AGGREGATE_SQL.format(null_sql=null_sql, content_sql=content_sql)
+        return final_query, params, self._parse_normal_result(filter)
 
     def _enumerate_time_range(self, filter: Filter, seconds_in_interval: int) -> List[str]:
         date_from = filter.date_from
@@ -109,6 +134,16 @@ class ClickhouseTrendsNormal:
 
         return _parse
 
+    def _entity_condition(self, entity: Entity) -> Fragment:
+        if entity.type == TREND_FILTER_TYPE_ACTIONS:
+            try:
+                action = Action.objects.get(pk=entity.id)
+            except Action.DoesNotExist:
+                raise ValueError("Action does not exist")
+            action_query, action_params = format_action_filter(action)
+            return Fragment(action_query, action_params)
+        return column_equals("event", "event", entity.id)
+
     def _populate_entity_params(self, entity: Entity) -> Tuple[Dict, Dict]:
         params, content_sql_params = {}, {}
         if entity.type == TREND_FILTER_TYPE_ACTIONS:
@@ -0,0 +1,85 @@
+from unittest.mock import patch
+from uuid import uuid4
+
+from freezegun import freeze_time
+
+from ee.clickhouse.client import sync_execute
+from ee.clickhouse.models.event import create_event
+from ee.clickhouse.queries.trends.clickhouse_trends import ClickhouseTrends
+from ee.clickhouse.queries.trends.top_values import get_top_values_from_daily
+from ee.clickhouse.sql.trends.top_elements import TOP_ELEMENTS_OF_KEY_BY_DAY_SQL
+from ee.clickhouse.util import ClickhouseTestMixin
+from posthog.models.filters.filter import Filter
+from posthog.models.person import Person
+from posthog.test.base import APIBaseTest
+
+
+def _create_event(**kwargs):
+    kwargs.update({"event_uuid": uuid4()})
+    create_event(**kwargs)
+
+
+class TestTopValues(ClickhouseTestMixin, APIBaseTest):
+    def setUp(self):
+        super().setUp()
+        Person.objects.create(team_id=self.team.pk, distinct_ids=["blabla"])
+        for timestamp, value in [
+            ("2020-01-02T12:00:00Z", "a"),
+            ("2020-01-02T12:00:00Z", "b"),
+            ("2020-01-02T12:00:00Z", "b"),
+            ("2020-01-03T12:00:00Z", "a"),
+            ("2020-01-03T12:00:00Z", "a"),
+            ("2020-01-04T12:00:00Z", "c"),
+        ]:
+            _create_event(
+                team=self.team, event="sign up", distinct_id="blabla", properties={"$os": value}, timestamp=timestamp
+            )
+
+    def _breakdown_values(self, date_from="2020-01-01", date_to="2020-01-04"):
+        filter = Filter(
+            data={
+                "date_from": date_from,
+                "date_to": date_to,
+                "breakdown": "$os",
+                "events": [{"id": "sign up", "order": 0}],
+            }
+        )
+        with patch("ee.clickhouse.queries.trends.top_values.sync_execute", wraps=sync_execute) as top_values_query:
+            response = ClickhouseTrends().run(filter, self.team)
+        return [item["breakdown_value"] for item in response], top_values_query
+
+    @freeze_time("2020-01-04T13:00:00Z")
+    def test_top_values_merge_days_and_store_past_ones(self):
+        values, top_values_query = self._breakdown_values()
+        self.assertEqual(sorted(values), ["a", "b", "c"])
+        self.assertEqual(
+            top_values_query.call_args[0][1]["days"], ("2020-01-01", "2020-01-02", "2020-01-03", "2020-01-04")
+        )
+
+        # only today, which isn't over yet, is queried again
+        values, top_values_query = self._breakdown_values()
+        self.assertEqual(sorted(values), ["a", "b", "c"])
+        self.assertEqual(top_values_query.call_args[0][1]["days"], ("2020-01-04",))
+
+    @freeze_time("2020-01-04T13:00:00Z")
+    def test_top_values_reuse_days_of_overlapping_range(self):
+        values, top_values_query = self._breakdown_values(date_from="2020-01-01", date_to="2020-01-03")
+        self.assertEqual(sorted(values), ["a", "b"])
+        self.assertEqual(top_values_query.call_args[0][1]["days"], ("2020-01-01", "2020-01-02", "2020-01-03"))
+
+        # the days both ranges cover are stored, only the new one is queried
+        values, top_values_query = self._breakdown_values(date_from="2020-01-02", date_to="2020-01-04")
+        self.assertEqual(sorted(values), ["a", "b", "c"])
+        self.assertEqual(top_values_query.call_args[0][1]["days"], ("2020-01-04",))
+
+    @freeze_time("2020-01-04T13:00:00Z")
+    def test_top_values_limited_to_most_frequent(self):
+        query = TOP_ELEMENTS_OF_KEY_BY_DAY_SQL.format(prop_filters="", aggregate_operation="count(*)")
+        params = {"key": "$os", "team_id": self.team.pk}
+        self.assertEqual(
+            get_top_values_from_daily(query, params, "2020-01-01 00:00:00", "2020-01-04 23:59:59", 2, 0),
+            ['"a"', '"b"'],
+        )
+        self.assertEqual(
+            get_top_values_from_daily(query, params, "2020-01-01 00:00:00", "2020-01-04 23:59:59", 2, 2), ['"c"']
+        )
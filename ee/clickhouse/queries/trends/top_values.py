@@ -0,0 +1,89 @@
+"""
+Top breakdown values, stored per team, breakdown key, filters and day.
+
+Instead of grouping the whole date range by value before every breakdown query, each day's top values are computed
+once and kept in the cache, and a date range merges the days it covers. Only the days that aren't stored yet, and the
+partial ones at the edges of the range or today, hit the events table.
+"""
+import json
+from collections import defaultdict
+from datetime import date, datetime, timedelta
+from typing import Any, Dict, List, Optional
+
+from django.core.cache import cache
+from django.utils import timezone
+
+from ee.clickhouse.client import sync_execute
+from posthog.utils import generate_cache_key
+
+# Daily top values add up to the top values of the range only for additive aggregates
+ADDITIVE_AGGREGATE_OPERATIONS = ("count(*)", "sum(")
+TOP_VALUES_PER_DAY = 100
+TOP_VALUES_TTL = 24 * 60 * 60
+# Events can arrive a little late, a day is only stored once it's been over for a while
+TOP_VALUES_SETTLE_TIME = timedelta(hours=1)
+
+CH_TIMESTAMP_FORMAT = "%Y-%m-%d %H:%M:%S"
+
+
+def can_merge_daily_top_values(aggregate_operation: str, limit: int, offset: int) -> bool:
+    return aggregate_operation.startswith(ADDITIVE_AGGREGATE_OPERATIONS) and limit + offset <= TOP_VALUES_PER_DAY
+
+
+def get_top_values_from_daily(
+    daily_query: str, params: Dict[str, Any], date_from: Optional[str], date_to: str, limit: int, offset: int
+) -> List:
+    """
+    Merges the top values of every day between `date_from` and `date_to` (as given to the query, see
+    `parse_timestamps`). `daily_query` returns the `(day, value, count)` rows of the days in `%(days)s` between
+    `%(date_from)s` and `%(date_to)s`, at most `%(limit)s` per day. The bounds only trim the partial days at the edges
+    of the range, so they're passed as parameters and left out of the stored days' key.
+    """
+    if date_from is None:
+        return []
+    range_start = datetime.strptime(date_from, CH_TIMESTAMP_FORMAT)
+    range_end = datetime.strptime(date_to, CH_TIMESTAMP_FORMAT) + timedelta(seconds=1)
+    settled_before = timezone.now().replace(tzinfo=None) - TOP_VALUES_SETTLE_TIME
+
+    scope = generate_cache_key(json.dumps([daily_query, params], sort_keys=True, default=str))
+    days = [range_start.date() + timedelta(days=i) for i in range((range_end - range_start).days + 1)]
+    days = [day for day in days if _day_start(day) < range_end]
+    storable_keys = {
+        day: "top_values_{}_{}".format(scope, day.isoformat())
+        for day in days
+        if range_start <= _day_start(day) and _day_start(day + timedelta(days=1)) <= min(range_end, settled_before)
+    }
+
+    stored = cache.get_many(list(storable_keys.values()))
+    daily_values = {day: stored[key] for day, key in storable_keys.items() if key in stored}
+    missing_days = [day for day in days if day not in daily_values]
+    if missing_days:
+        rows = sync_execute(
+            daily_query,
+            {
+                **params,
+                "days": tuple(day.isoformat() for day in missing_days),
+                "date_from": date_from,
+                "date_to": date_to,
+                "limit": TOP_VALUES_PER_DAY,
+            },
+        )
+        fetched: Dict[date, List] = defaultdict(list)
+        for day, value, count in rows:
+            fetched[day].append((value, count))
+        for day in missing_days:
+            daily_values[day] = fetched.get(day, [])
+        cache.set_many(
+            {storable_keys[day]: daily_values[day] for day in missing_days if day in storable_keys}, TOP_VALUES_TTL
+        )
+
+    totals: Dict[Any, float] = defaultdict(float)
+    for values in daily_values.values():
+        for value, count in values:
+            totals[value] += count or 0
+    ranked = sorted(totals.items(), key=lambda item: item[1], reverse=True)
+    return [value for value, _ in ranked[offset : offset + limit]]
+
+
+def _day_start(day: date) -> datetime:
+    return datetime(day.year, day.month, day.day)
@@ -1,12 +1,17 @@
 from datetime import datetime
-from typing import Optional, Tuple
+from typing import List, Optional, Tuple
 
 from dateutil.relativedelta import relativedelta
+from django.conf import settings
 from django.utils import timezone
 
 from ee.clickhouse.client import sync_execute
+from ee.clickhouse.models.property import parse_prop_clauses
+from ee.clickhouse.queries.builder import Fragment
 from ee.clickhouse.sql.events import GET_EARLIEST_TIMESTAMP_SQL
 from posthog.models.event import DEFAULT_EARLIEST_TIME_DELTA
+from posthog.models.property import Property
+from posthog.models.team import Team
 from posthog.queries.base import TIME_IN_SECONDS
 from posthog.types import FilterType
 
@@ -17,7 +22,7 @@ def parse_timestamps(filter: FilterType, team_id: int, table: str = "") -> Tuple
     params = {}
     if filter.date_from:
 
-        date_from = "and {table}timestamp >= '{}'".format(format_ch_timestamp(filter.date_from, filter), table=table,)
+        date_from = "and " + timestamp_bound(">=", ch_datetime(format_ch_timestamp(filter.date_from, filter)), table)
         params.update({"date_from": format_ch_timestamp(filter.date_from, filter)})
     else:
         try:
@@ -25,17 +30,88 @@ def parse_timestamps(filter: FilterType, team_id: int, table: str = "") -> Tuple
         except IndexError:
             date_from = ""
         else:
-            date_from = "and {table}timestamp >= '{}'".format(format_ch_timestamp(earliest_date, filter), table=table,)
+            date_from = "and " + timestamp_bound(">=", ch_datetime(format_ch_timestamp(earliest_date, filter)), table)
             params.update({"date_from": format_ch_timestamp(earliest_date, filter)})
 
     _date_to = filter.date_to
 
-    date_to = "and {table}timestamp <= '{}'".format(format_ch_timestamp(_date_to, filter, " 23:59:59"), table=table,)
+    date_to = "and " + timestamp_bound("<=", ch_datetime(format_ch_timestamp(_date_to, filter, " 23:59:59")), table)
     params.update({"date_to": format_ch_timestamp(_date_to, filter, " 23:59:59")})
 
     return date_from or "", date_to or "", params
 
 
+def parse_timestamp_conditions(filter: FilterType, team_id: int, table: str = "") -> List[Fragment]:
+    """
+    Same bounds as `parse_timestamps`, as query builder conditions with the timestamps passed as parameters.
+    """
+    _, _, params = parse_timestamps(filter=filter, team_id=team_id, table=table)
+    conditions = []
+    if "date_from" in params:
+        conditions.append(timestamp_condition(">=", "date_from", params["date_from"], table))
+    conditions.append(timestamp_condition("<=", "date_to", params["date_to"], table))
+    return conditions
+
+
+def ch_datetime(timestamp: str) -> str:
+    return "toDateTime('{}', 'UTC')".format(timestamp)
+
+
+def timestamp_bound(operator: str, value: str, table: str = "") -> str:
+    """
+    Compares the raw `timestamp` to a DateTime expression, and adds the same bound on `toDate(timestamp)`. Both are
+    needed for ClickHouse to prune by the `(team_id, toDate(timestamp))` sorting key: wrapping `timestamp` in a function
+    (`toDateTime(timestamp)`, `toStartOfDay(timestamp)`, ...) reads every granule of the team.
+    """
+    return "{table}timestamp {operator} {value} AND toDate({table}timestamp) {operator} toDate({value})".format(
+        table=table, operator=operator, value=value
+    )
+
+
+def timestamp_condition(operator: str, param: str, value: str, table: str = "") -> Fragment:
+    return Fragment(
+        timestamp_bound(operator, "toDateTime(%({})s, 'UTC')".format(param), table), {param: value}, ["timestamp"]
+    )
+
+
+def parse_prop_conditions(
+    filters: List[Property],
+    team_id: int,
+    prepend: str = "global",
+    table_name: str = "",
+    allow_denormalized_props: bool = False,
+    filter_test_accounts: bool = False,
+) -> List[Fragment]:
+    """
+    Same filters as `parse_prop_clauses`, as one query builder condition per property. Conditions on event properties
+    record the column they read, so the ones on materialized columns are placed in PREWHERE.
+    """
+    if filter_test_accounts:
+        test_account_filters = Team.objects.only("test_account_filters").get(id=team_id).test_account_filters
+        filters = [*filters, *[Property(**prop) for prop in test_account_filters]]
+
+    conditions = []
+    for idx, prop in enumerate(filters):
+        is_event_property = prop.type not in ("cohort", "person", "element")
+        # the team is already filtered on by the query itself, `parse_prop_clauses` only repeats it for event properties
+        clause, params = parse_prop_clauses(
+            [prop],
+            None if is_event_property else team_id,
+            prepend=prepend,
+            table_name=table_name,
+            allow_denormalized_props=allow_denormalized_props,
+        )
+        columns = None
+        if is_event_property:
+            key = prop.key.lower()
+            is_denormalized = allow_denormalized_props and key in settings.CLICKHOUSE_DENORMALIZED_PROPERTIES
+            columns = ["properties_{}".format(key) if is_denormalized else "properties"]
+        condition = Fragment.raw(clause, params, columns)
+        if condition:
+            conditions.append(condition.namespaced("{}_{}".format(prepend, idx)))
+    return conditions
+
+
 def format_ch_timestamp(timestamp: datetime, filter, default_hour_min: str = " 00:00:00"):
     is_hour_or_min = (
         (filter.interval and filter.interval.lower() == "hour")
@@ -103,6 +179,14 @@ def get_trunc_func_ch(period: Optional[str]) -> str:
 
 def date_from_clause(interval_annotation: str, round_interval: bool) -> str:
     if round_interval:
-        return "AND {interval}(timestamp) >= {interval}(toDateTime(%(date_from)s))".format(interval=interval_annotation)
+        # timestamp >= start of the interval holding date_from, same rows as comparing both sides rounded
+        value = "toDateTime({interval}(toDateTime(%(date_from)s)))".format(interval=interval_annotation)
     else:
-        return "AND timestamp >= %(date_from)s"
+        value = "toDateTime(%(date_from)s, 'UTC')"
+    return "AND " + timestamp_bound(">=", value)
+
+
+def date_from_condition(interval_annotation: str, round_interval: bool, date_from: str) -> Fragment:
+    return Fragment(
+        date_from_clause(interval_annotation, round_interval)[len("AND ") :], {"date_from": date_from}, ["timestamp"]
+    )
@@ -1,6 +1,6 @@
 from ee.kafka_client.topics import KAFKA_EVENTS
 
-from .clickhouse import KAFKA_COLUMNS, STORAGE_POLICY, kafka_engine, table_engine
+from .clickhouse import KAFKA_COLUMNS, STORAGE_POLICY, aggregating_table_engine, kafka_engine, table_engine
 from .person import GET_LATEST_PERSON_DISTINCT_ID_SQL
 
 DROP_EVENTS_TABLE_SQL = """
@@ -126,6 +126,111 @@ _offset
 FROM events
 """
 
+DROP_EVENTS_FIRST_SEEN_TABLE_SQL = """
+DROP TABLE events_first_seen
+"""
+
+DROP_EVENTS_FIRST_SEEN_MV_SQL = """
+DROP TABLE events_first_seen_mv
+"""
+
+EVENTS_FIRST_SEEN_TABLE = "events_first_seen"
+
+# When each distinct id first sent each event, merged from every insert into events by the view below
+EVENTS_FIRST_SEEN_TABLE_SQL = """
+CREATE TABLE {table_name}
+(
+    team_id Int64,
+    event VARCHAR,
+    distinct_id VARCHAR,
+    first_seen AggregateFunction(min, DateTime64(6, 'UTC'))
+) ENGINE = {engine}
+ORDER BY (team_id, event, distinct_id)
+""".format(
+    table_name=EVENTS_FIRST_SEEN_TABLE, engine=aggregating_table_engine(EVENTS_FIRST_SEEN_TABLE)
+)
+
+EVENTS_FIRST_SEEN_MV_SQL = """
+CREATE MATERIALIZED VIEW {table_name}_mv
+TO {table_name}
+AS SELECT
+team_id,
+event,
+distinct_id,
+minState(timestamp) AS first_seen
+FROM {events_table}
+GROUP BY team_id, event, distinct_id
+""".format(
+    table_name=EVENTS_FIRST_SEEN_TABLE, events_table=EVENTS_TABLE
+)
+
+# The view only sees events inserted after it's created
+BACKFILL_EVENTS_FIRST_SEEN_SQL = """
+INSERT INTO {table_name}
+SELECT team_id, event, distinct_id, minState(timestamp) FROM {events_table}
+GROUP BY team_id, event, distinct_id
+""".format(
+    table_name=EVENTS_FIRST_SEEN_TABLE, events_table=EVENTS_TABLE
+)
+
+DROP_EVENTS_ACTIVITY_TABLE_SQL = """
+DROP TABLE events_activity
+"""
+
+DROP_EVENTS_ACTIVITY_MV_SQL = """
+DROP TABLE events_activity_mv
+"""
+
+EVENTS_ACTIVITY_TABLE = "events_activity"
+
+# Start of every interval each distinct id sent each event in, per interval type, kept as bitmaps for stickiness.
+# The interval starts are the same values as `toUInt32({trunc_func}(toDateTime(timestamp)))` over the raw events.
+EVENTS_ACTIVITY_INTERVALS = """multiIf(
+    interval_type = 'hour', toUInt32(toStartOfHour(toDateTime(timestamp))),
+    interval_type = 'day', toUInt32(toStartOfDay(toDateTime(timestamp))),
+    interval_type = 'week', toUInt32(toStartOfWeek(toDateTime(timestamp))),
+    toUInt32(toStartOfMonth(toDateTime(timestamp)))
+)"""
+
+EVENTS_ACTIVITY_TABLE_SQL = """
+CREATE TABLE {table_name}
+(
+    team_id Int64,
+    event VARCHAR,
+    distinct_id VARCHAR,
+    interval_type VARCHAR,
+    active_intervals AggregateFunction(groupBitmap, UInt32)
+) ENGINE = {engine}
+ORDER BY (team_id, event, distinct_id, interval_type)
+""".format(
+    table_name=EVENTS_ACTIVITY_TABLE, engine=aggregating_table_engine(EVENTS_ACTIVITY_TABLE)
+)
+
+EVENTS_ACTIVITY_MV_SQL = """
+CREATE MATERIALIZED VIEW {table_name}_mv
+TO {table_name}
+AS SELECT
+team_id,
+event,
+distinct_id,
+interval_type,
+groupBitmapState({intervals}) AS active_intervals
+FROM {events_table}
+ARRAY JOIN ['hour', 'day', 'week', 'month'] AS interval_type
+GROUP BY team_id, event, distinct_id, interval_type
+""".format(
+    table_name=EVENTS_ACTIVITY_TABLE, events_table=EVENTS_TABLE, intervals=EVENTS_ACTIVITY_INTERVALS
+)
+
+BACKFILL_EVENTS_ACTIVITY_SQL = """
+INSERT INTO {table_name}
+SELECT team_id, event, distinct_id, interval_type, groupBitmapState({intervals}) FROM {events_table}
+ARRAY JOIN ['hour', 'day', 'week', 'month'] AS interval_type
+GROUP BY team_id, event, distinct_id, interval_type
+""".format(
+    table_name=EVENTS_ACTIVITY_TABLE, events_table=EVENTS_TABLE, intervals=EVENTS_ACTIVITY_INTERVALS
+)
+
 SELECT_PROP_VALUES_SQL = """
 SELECT DISTINCT trim(BOTH '\"' FROM JSONExtractRaw(properties, %(key)s)) FROM events where JSONHas(properties, %(key)s) AND team_id = %(team_id)s {parsed_date_from} {parsed_date_to} LIMIT 10
 """
@@ -148,7 +253,7 @@ FROM
     events
 where team_id = %(team_id)s
 {conditions}
-ORDER BY toDate(timestamp) DESC, timestamp DESC {limit}
+ORDER BY toDate(timestamp) {order}, timestamp {order} {limit}
 """
 
 SELECT_EVENT_WITH_PROP_SQL = """
@@ -166,7 +271,7 @@ WHERE
 team_id = %(team_id)s
 {conditions}
 {filters}
-ORDER BY toDate(timestamp) DESC, timestamp DESC {limit}
+ORDER BY toDate(timestamp) {order}, timestamp {order} {limit}
 """
 
 SELECT_ONE_EVENT_SQL = """
@@ -130,7 +130,7 @@ PATHS_QUERY_FINAL = """
         event_count DESC,
         source_event,
         target_event
-    LIMIT 20
+    LIMIT %(edge_limit)s
 """.format(
     paths_query=paths_query_step_3
 )
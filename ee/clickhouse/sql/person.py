@@ -170,6 +170,15 @@ INSERT INTO {} (id, person_id, cohort_id, team_id, _timestamp) VALUES
     PERSON_STATIC_COHORT_TABLE
 )
 
+GET_STATIC_COHORT_PERSON_IDS_PAGE_SQL = """
+SELECT DISTINCT person_id FROM {}
+WHERE team_id = %(team_id)s AND cohort_id = %(cohort_id)s AND person_id > toUUID(%(after)s)
+ORDER BY person_id
+LIMIT %(limit)s
+""".format(
+    PERSON_STATIC_COHORT_TABLE
+)
+
 #
 # Other queries
 #
@@ -251,6 +260,22 @@ where distinct_id IN (
 AND team_id = %(team_id)s
 """
 
+DELETE_PERSON_EVENTS_FIRST_SEEN_BY_ID = """
+ALTER TABLE events_first_seen DELETE
+where distinct_id IN (
+    SELECT distinct_id FROM person_distinct_id WHERE person_id=%(id)s AND team_id = %(team_id)s
+)
+AND team_id = %(team_id)s
+"""
+
+DELETE_PERSON_EVENTS_ACTIVITY_BY_ID = """
+ALTER TABLE events_activity DELETE
+where distinct_id IN (
+    SELECT distinct_id FROM person_distinct_id WHERE person_id=%(id)s AND team_id = %(team_id)s
+)
+AND team_id = %(team_id)s
+"""
+
 DELETE_PERSON_DISTINCT_ID_BY_PERSON_ID = """
 ALTER TABLE person_distinct_id DELETE where person_id = %(id)s
 """
@@ -274,6 +299,19 @@ GROUP BY id, created_at, team_id, properties, is_identified
 LIMIT 200 OFFSET %(offset)s
 """
 
+PERSON_IDS_THROUGH_DISTINCT_SQL = """
+SELECT DISTINCT person_id FROM ({latest_distinct_id_sql}) WHERE distinct_id IN ({content_sql}) AND team_id = %(team_id)s
+"""
+
+PEOPLE_BY_IDS_SQL = """
+SELECT id, created_at, team_id, properties, is_identified, groupArray(distinct_id) FROM (
+    {latest_person_sql}
+) as person INNER JOIN (
+    SELECT DISTINCT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE person_id IN %(person_ids)s AND team_id = %(team_id)s
+) as pdi ON person.id = pdi.person_id
+GROUP BY id, created_at, team_id, properties, is_identified
+"""
+
 INSERT_COHORT_ALL_PEOPLE_THROUGH_DISTINCT_SQL = """
 INSERT INTO {cohort_table} SELECT generateUUIDv4(), id, %(cohort_id)s, %(team_id)s, %(_timestamp)s, 0 FROM (
     SELECT id FROM (
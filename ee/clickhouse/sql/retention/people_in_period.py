@@ -1,5 +1,5 @@
 RETENTION_PEOPLE_PER_PERIOD_SQL = """
-SELECT toString(person_id), count(person_id) appearance_count, groupArray(intervals_from_base) appearances FROM (
+SELECT person_id, count(person_id) appearance_count, groupArray(intervals_from_base) appearances FROM (
     SELECT DISTINCT
         datediff(%(period)s, {trunc_func}(toDateTime(%(start_date)s)), reference_event.event_date) as base_interval,
         datediff(%(period)s, reference_event.event_date, {trunc_func}(toDateTime(event_date))) as intervals_from_base,
@@ -11,7 +11,8 @@ SELECT toString(person_id), count(person_id) appearance_count, groupArray(interv
         e.uuid as uuid,
         e.event as event
         FROM events e join (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) pdi on e.distinct_id = pdi.distinct_id
-        where toDateTime(e.timestamp) >= toDateTime(%(start_date)s) AND toDateTime(e.timestamp) <= toDateTime(%(end_date)s)
+        where e.timestamp >= toDateTime(%(start_date)s) AND toDate(e.timestamp) >= toDate(toDateTime(%(start_date)s))
+        AND e.timestamp <= toDateTime(%(end_date)s) AND toDate(e.timestamp) <= toDate(toDateTime(%(end_date)s))
         AND e.team_id = %(team_id)s {returning_query} {filters}
     ) event
     JOIN (
@@ -24,8 +25,8 @@ SELECT toString(person_id), count(person_id) appearance_count, groupArray(interv
 ) person_appearances
 WHERE base_interval = 0
 GROUP BY person_id
-ORDER BY appearance_count DESC
-LIMIT %(limit)s OFFSET %(offset)s
+ORDER BY appearance_count DESC, person_id
+{limit}
 """
 
 REFERENCE_EVENT_PEOPLE_PER_PERIOD_SQL = """
@@ -36,6 +37,7 @@ e.uuid as uuid,
 e.event as event
 from events e JOIN (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) pdi on e.distinct_id = pdi.distinct_id
 where event_date = {trunc_func}(toDateTime(%(start_date)s))
+AND toDate(e.timestamp) >= toDate({trunc_func}(toDateTime(%(start_date)s)))
 AND e.team_id = %(team_id)s {target_query} {filters}
 """
 
@@ -47,6 +49,7 @@ SELECT DISTINCT
 pdi.person_id as person_id
 from events e JOIN (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) pdi on e.distinct_id = pdi.distinct_id
 where {trunc_func}(e.timestamp) = {trunc_func}(toDateTime(%(start_date)s))
+AND toDate(e.timestamp) >= toDate({trunc_func}(toDateTime(%(start_date)s)))
 AND e.team_id = %(team_id)s {target_query} {filters}
 """
 
@@ -72,3 +75,19 @@ WHERE e.team_id = %(team_id)s {target_query} {filters}
 GROUP BY person_id HAVING
 min({trunc_func}(e.timestamp)) = {trunc_func}(toDateTime(%(start_date)s))
 """
+
+RETENTION_PEOPLE_PER_PERIOD_WITH_PERSONS_SQL = """
+SELECT id, created_at, team_id, properties, is_identified, distinct_ids, appearance_count, appearances FROM (
+    {people_in_period_sql}
+) as people_in_period INNER JOIN (
+    SELECT id, created_at, team_id, properties, is_identified, groupArray(distinct_id) as distinct_ids FROM (
+        {latest_person_sql}
+    ) as person INNER JOIN (
+        SELECT DISTINCT person_id, distinct_id FROM ({latest_distinct_id_sql})
+        WHERE team_id = %(team_id)s AND person_id IN (SELECT person_id FROM ({people_in_period_sql}))
+    ) as pdi ON person.id = pdi.person_id
+    WHERE person.id IN (SELECT person_id FROM ({people_in_period_sql}))
+    GROUP BY id, created_at, team_id, properties, is_identified
+) as person ON person.id = people_in_period.person_id
+ORDER BY appearance_count DESC, person_id
+"""
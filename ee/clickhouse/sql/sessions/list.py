@@ -22,7 +22,8 @@ SESSION_SQL = """
         groupArray(properties) properties,
         groupArray(timestamp) timestamps,
         groupArray(elements_chain) elements_chain,
-        arrayReduce('max', groupArray(timestamp)) as end_time
+        arrayReduce('max', groupArray(timestamp)) as end_time,
+        {distinct_id_count} AS distinct_id_count
         {filters_select_clause}
     FROM (
         SELECT
@@ -69,7 +70,7 @@ SESSION_SQL = """
                         AND event != '$feature_flag_called'
                         {date_from}
                         {date_to}
-                        AND distinct_id IN %(distinct_ids)s
+                        AND distinct_id IN {distinct_ids}
                     GROUP BY
                         uuid,
                         event,
@@ -1,10 +1,6 @@
 STICKINESS_SQL = """
-    SELECT countDistinct(person_id), num_intervals FROM (
-         SELECT person_distinct_id.person_id, countDistinct({trunc_func}(toDateTime(timestamp))) as num_intervals
-         FROM events
-         LEFT JOIN (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) as person_distinct_id ON person_distinct_id.distinct_id = events.distinct_id
-         WHERE team_id = {team_id} AND event = '{event}' {filters} {parsed_date_from} {parsed_date_to}
-         GROUP BY person_distinct_id.person_id
+    SELECT count(person_id), num_intervals FROM (
+         SELECT person_id, bitmapCardinality(active_intervals) as num_intervals FROM ({activity_sql})
     )
     WHERE num_intervals <= %(num_intervals)s
     GROUP BY num_intervals 
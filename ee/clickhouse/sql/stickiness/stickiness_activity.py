@@ -0,0 +1,23 @@
+# Intervals each person was active in, as a bitmap of the intervals' start, shared by stickiness and its people
+STICKINESS_ACTIVITY_SQL = """
+SELECT person_distinct_id.person_id as person_id, groupBitmapState(toUInt32({trunc_func}(toDateTime(timestamp)))) as active_intervals
+FROM events
+LEFT JOIN (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) as person_distinct_id ON person_distinct_id.distinct_id = events.distinct_id
+WHERE team_id = %(team_id)s {entity_filter} {filters} {parsed_date_from} {parsed_date_to}
+GROUP BY person_distinct_id.person_id
+"""
+
+# Same bitmaps merged from events_activity, for plain events: the stored bitmaps span all time, so they are cut to the
+# intervals from the one of date_from to the one of date_to
+STICKINESS_ACTIVITY_STORED_SQL = """
+SELECT person_distinct_id.person_id as person_id, groupBitmapOrState(activity.intervals) as active_intervals
+FROM (
+    SELECT distinct_id, bitmapSubsetInRange(groupBitmapMergeState(active_intervals), {interval_from}, {interval_to}) as intervals
+    FROM events_activity
+    WHERE team_id = %(team_id)s AND event = %(event)s AND interval_type = %(interval_type)s
+    GROUP BY distinct_id
+) as activity
+LEFT JOIN (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) as person_distinct_id ON person_distinct_id.distinct_id = activity.distinct_id
+GROUP BY person_distinct_id.person_id
+HAVING bitmapCardinality(active_intervals) > 0
+"""
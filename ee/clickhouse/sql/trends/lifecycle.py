@@ -26,6 +26,7 @@ SELECT groupArray(day_start) as date, groupArray(counts) as data, status FROM (
                                 FROM person_distinct_id
                                 WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                             WHERE team_id = %(team_id)s AND {event_query} {filters}
+                            AND events.timestamp >= toDateTime(%(prev_date_from)s) AND events.timestamp < toDateTime(%(date_to)s) + INTERVAL {interval}
                             GROUP BY person_id, day HAVING day <= toDateTime(%(date_to)s) AND day >= toDateTime(%(prev_date_from)s)
                         ) base
                         JOIN (
@@ -36,6 +37,7 @@ SELECT groupArray(day_start) as date, groupArray(counts) as data, status FROM (
                                 FROM person_distinct_id
                                 WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                             WHERE team_id = %(team_id)s AND {event_query} {filters}
+                            AND events.timestamp >= toDateTime(%(prev_date_from)s) AND events.timestamp < toDateTime(%(date_to)s) + INTERVAL {interval}
                             GROUP BY person_id, subsequent_day HAVING subsequent_day <= toDateTime(%(date_to)s) AND subsequent_day >= toDateTime(%(prev_date_from)s)
                         ) events ON base.person_id = events.person_id 
                         WHERE subsequent_day > base_day
@@ -50,6 +52,7 @@ SELECT groupArray(day_start) as date, groupArray(counts) as data, status FROM (
                             FROM person_distinct_id
                             WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                         WHERE team_id = %(team_id)s AND {event_query} {filters}
+                        AND events.timestamp >= toDateTime(%(prev_date_from)s) AND events.timestamp < toDateTime(%(date_to)s) + INTERVAL {interval}
                         GROUP BY person_id, day HAVING day <= toDateTime(%(date_to)s) AND day >= toDateTime(%(prev_date_from)s)
                     ) base
                     GROUP BY person_id
@@ -63,7 +66,9 @@ SELECT groupArray(day_start) as date, groupArray(counts) as data, status FROM (
                                 FROM person_distinct_id
                                 WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                             WHERE team_id = %(team_id)s AND {event_query} {filters}
-                            AND toDateTime(events.timestamp) <= toDateTime(%(date_to)s) AND {trunc_func}(events.timestamp) >= toDateTime(%(date_from)s)
+                            AND events.timestamp <= toDateTime(%(date_to)s) AND toDate(events.timestamp) <= toDate(toDateTime(%(date_to)s))
+                            AND events.timestamp >= toDateTime(%(date_from)s) AND toDate(events.timestamp) >= toDate(toDateTime(%(date_from)s))
+                            AND {trunc_func}(events.timestamp) >= toDateTime(%(date_from)s)
                             GROUP BY person_id
                         ) as e
                         CROSS JOIN (
@@ -75,16 +80,7 @@ SELECT groupArray(day_start) as date, groupArray(counts) as data, status FROM (
                         OR
                         ( (neighbor(person_id, -1) = person_id) AND neighbor(subsequent_day, -1) < subsequent_day - INTERVAL {interval})
                     ) e
-                JOIN (
-                    SELECT DISTINCT person_id, {trunc_func}(min(events.timestamp)) earliest FROM events 
-                    JOIN
-                    (SELECT person_id,
-                                distinct_id
-                        FROM person_distinct_id
-                        WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
-                  WHERE team_id = %(team_id)s AND {event_query} {filters}
-                    GROUP BY person_id
-                ) earliest ON e.person_id = earliest.person_id
+                JOIN ({earliest}) earliest ON e.person_id = earliest.person_id
         )
         WHERE subsequent_day <= toDateTime(%(date_to)s) AND subsequent_day >= toDateTime(%(date_from)s)
         GROUP BY subsequent_day, status
@@ -107,6 +103,7 @@ SELECT person_id FROM (
                     FROM person_distinct_id
                     WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                 WHERE team_id = %(team_id)s AND {event_query} {filters}
+                AND events.timestamp >= toDateTime(%(prev_date_from)s) AND events.timestamp < toDateTime(%(date_to)s) + INTERVAL {interval}
                 GROUP BY person_id, day HAVING day <= toDateTime(%(date_to)s) AND day >= toDateTime(%(prev_date_from)s)
             ) base
             JOIN (
@@ -117,6 +114,7 @@ SELECT person_id FROM (
                     FROM person_distinct_id
                     WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                 WHERE team_id = %(team_id)s AND {event_query} {filters}
+                AND events.timestamp >= toDateTime(%(prev_date_from)s) AND events.timestamp < toDateTime(%(date_to)s) + INTERVAL {interval}
                 GROUP BY person_id, subsequent_day HAVING subsequent_day <= toDateTime(%(date_to)s) AND subsequent_day >= toDateTime(%(prev_date_from)s)
             ) events ON base.person_id = events.person_id 
             WHERE subsequent_day > base_day
@@ -131,6 +129,7 @@ SELECT person_id FROM (
                 FROM person_distinct_id
                 WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
             WHERE team_id = %(team_id)s AND {event_query} {filters}
+            AND events.timestamp >= toDateTime(%(prev_date_from)s) AND events.timestamp < toDateTime(%(date_to)s) + INTERVAL {interval}
             GROUP BY person_id, day HAVING day <= toDateTime(%(date_to)s) AND day >= toDateTime(%(prev_date_from)s)
         ) base
         GROUP BY person_id
@@ -144,7 +143,9 @@ SELECT person_id FROM (
                     FROM person_distinct_id
                     WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
                 WHERE team_id = %(team_id)s AND {event_query} {filters}
-                AND toDateTime(events.timestamp) <= toDateTime(%(date_to)s) AND {trunc_func}(events.timestamp) >= toDateTime(%(date_from)s)
+                AND events.timestamp <= toDateTime(%(date_to)s) AND toDate(events.timestamp) <= toDate(toDateTime(%(date_to)s))
+                AND events.timestamp >= toDateTime(%(date_from)s) AND toDate(events.timestamp) >= toDate(toDateTime(%(date_from)s))
+                AND {trunc_func}(events.timestamp) >= toDateTime(%(date_from)s)
                 GROUP BY person_id
             ) as e
             CROSS JOIN (
@@ -156,18 +157,34 @@ SELECT person_id FROM (
             OR
             ( (neighbor(person_id, -1) = person_id) AND neighbor(subsequent_day, -1) < subsequent_day - INTERVAL {interval})
         ) e
-    JOIN (
-        SELECT DISTINCT person_id, {trunc_func}(min(events.timestamp)) earliest FROM events 
-        JOIN
-        (SELECT person_id,
-                    distinct_id
-            FROM person_distinct_id
-            WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
-        WHERE team_id = %(team_id)s AND {event_query} {filters}
-        GROUP BY person_id
-    ) earliest ON e.person_id = earliest.person_id
+    JOIN ({earliest}) earliest ON e.person_id = earliest.person_id
 ) e
 WHERE status = %(status)s
 AND {trunc_func}(toDateTime(%(target_date)s)) = subsequent_day
-LIMIT %(limit)s OFFSET %(offset)s
+{limit}
+"""
+
+EARLIEST_EVENTS_SQL = """
+SELECT DISTINCT person_id, {trunc_func}(min(events.timestamp)) earliest FROM events
+JOIN
+(SELECT person_id,
+            distinct_id
+    FROM person_distinct_id
+    WHERE team_id = %(team_id)s) pdi on events.distinct_id = pdi.distinct_id
+WHERE team_id = %(team_id)s AND {event_query} {filters}
+GROUP BY person_id
+"""
+
+EARLIEST_FIRST_SEEN_SQL = """
+SELECT person_id, {trunc_func}(min(first_seen)) earliest FROM (
+    SELECT distinct_id, minMerge(first_seen) AS first_seen FROM events_first_seen
+    WHERE team_id = %(team_id)s AND event = %(event)s
+    GROUP BY distinct_id
+) first_seen
+JOIN
+(SELECT person_id,
+            distinct_id
+    FROM person_distinct_id
+    WHERE team_id = %(team_id)s) pdi on first_seen.distinct_id = pdi.distinct_id
+GROUP BY person_id
 """
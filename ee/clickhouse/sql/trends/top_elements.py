@@ -12,3 +12,18 @@ SELECT groupArray(value) FROM (
     LIMIT %(limit)s OFFSET %(offset)s
 )
 """
+
+TOP_ELEMENTS_OF_KEY_BY_DAY_SQL = """
+SELECT
+    toDate(timestamp) as day,
+    JSONExtractRaw(properties, %(key)s) as value,
+    {aggregate_operation} as count
+FROM events e
+WHERE
+    team_id = %(team_id)s AND toDate(timestamp) IN %(days)s
+    AND timestamp >= toDateTime(%(date_from)s, 'UTC') AND timestamp <= toDateTime(%(date_to)s, 'UTC') {prop_filters}
+ AND JSONHas(properties, %(key)s)
+GROUP BY day, value
+ORDER BY day, count DESC
+LIMIT %(limit)s BY day
+"""
@@ -29,3 +29,34 @@ SELECT groupArray(value) FROM (
     LIMIT %(limit)s OFFSET %(offset)s
 )
 """
+
+TOP_PERSON_PROPS_OF_KEY_BY_DAY_SQL = """
+SELECT toDate(timestamp) as day, value, {aggregate_operation} as count
+FROM
+events e 
+INNER JOIN (SELECT person_id, distinct_id FROM ({latest_distinct_id_sql}) WHERE team_id = %(team_id)s) as pid ON e.distinct_id = pid.distinct_id
+INNER JOIN
+    (
+        SELECT * FROM (
+            SELECT
+            id,
+            array_property_keys as key,
+            array_property_values as value
+            from (
+                SELECT
+                    id,
+                    arrayMap(k -> toString(k.1), JSONExtractKeysAndValuesRaw(properties)) AS array_property_keys,
+                    arrayMap(k -> toString(k.2), JSONExtractKeysAndValuesRaw(properties)) AS array_property_values
+                FROM ({latest_person_sql}) person WHERE team_id = %(team_id)s {person_prop_filters}
+            )
+            ARRAY JOIN array_property_keys, array_property_values
+        ) ep
+        WHERE key = %(key)s
+    ) ep ON person_id = ep.id
+WHERE
+    e.team_id = %(team_id)s AND toDate(timestamp) IN %(days)s
+    AND timestamp >= toDateTime(%(date_from)s, 'UTC') AND timestamp <= toDateTime(%(date_to)s, 'UTC') {prop_filters}
+GROUP BY day, value
+ORDER BY day, count DESC
+LIMIT %(limit)s BY day
+"""
@@ -0,0 +1,58 @@
+from uuid import uuid4
+
+from ee.api.test.base import APILicensedTest
+from ee.clickhouse.explain import parse_explain_indexes, summarize_primary_key
+from ee.clickhouse.models.event import create_event
+from ee.clickhouse.util import ClickhouseTestMixin
+
+EXPLAIN_INDEXES_OUTPUT = [
+    "Expression ((Projection + Before ORDER BY))",
+    "  ReadFromMergeTree",
+    "  Indexes:",
+    "    MinMax",
+    "      Keys:",
+    "        timestamp",
+    "      Condition: true",
+    "      Parts: 3/3",
+    "      Granules: 40/40",
+    "    PrimaryKey",
+    "      Keys:",
+    "        team_id",
+    "        toDate(timestamp)",
+    "      Condition: and((toDate(timestamp) in [18628, +inf)), (team_id in [2, 2]))",
+    "      Parts: 1/3",
+    "      Granules: 2/40",
+]
+
+
+class TestExplain(ClickhouseTestMixin, APILicensedTest):
+    def test_parse_explain_indexes(self):
+        indexes = parse_explain_indexes(EXPLAIN_INDEXES_OUTPUT)
+        self.assertEqual([index["type"] for index in indexes], ["MinMax", "PrimaryKey"])
+        self.assertEqual(indexes[1]["keys"], ["team_id", "toDate(timestamp)"])
+        self.assertEqual(indexes[1]["parts_selected"], 1)
+        self.assertEqual(indexes[1]["granules_total"], 40)
+        self.assertEqual([index["read"] for index in indexes], [0, 0])
+
+        summary = summarize_primary_key(indexes)
+        self.assertEqual(summary["estimated_rows"], 2 * 8192)
+        self.assertTrue(summary["prunes_by_team"])
+        self.assertTrue(summary["prunes_by_date"])
+
+    def test_explain_requires_staff(self):
+        response = self.client.get('/api/insight/trend/?events=[{"id": "$pageview"}]&explain=true')
+        self.assertEqual(response.status_code, 403)
+
+    def test_explain_trends(self):
+        self.user.is_staff = True
+        self.user.save()
+        create_event(team=self.team, event="$pageview", distinct_id="1", event_uuid=uuid4())
+
+        response = self.client.get('/api/insight/trend/?events=[{"id": "$pageview"}]&explain=true').json()
+
+        self.assertEqual(response["result"][0]["count"], 1)
+        self.assertFalse(response.get("is_cached", False))
+        query = response["explain"]["queries"][0]
+        self.assertIn("SELECT", query["sql"])
+        self.assertIn("primary_key", query)
+        self.assertTrue(len(query["pipeline"]) > 0)
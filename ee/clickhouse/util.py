@@ -1,12 +1,21 @@
 from contextlib import contextmanager
 
 from clickhouse_driver.errors import ServerException
+from django.core.cache import cache
 from django.db import DEFAULT_DB_ALIAS
 
 from ee.clickhouse.client import sync_execute
 from ee.clickhouse.sql.events import (
+    DROP_EVENTS_ACTIVITY_MV_SQL,
+    DROP_EVENTS_ACTIVITY_TABLE_SQL,
+    DROP_EVENTS_FIRST_SEEN_MV_SQL,
+    DROP_EVENTS_FIRST_SEEN_TABLE_SQL,
     DROP_EVENTS_TABLE_SQL,
     DROP_EVENTS_WITH_ARRAY_PROPS_TABLE_SQL,
+    EVENTS_ACTIVITY_MV_SQL,
+    EVENTS_ACTIVITY_TABLE_SQL,
+    EVENTS_FIRST_SEEN_MV_SQL,
+    EVENTS_FIRST_SEEN_TABLE_SQL,
     EVENTS_TABLE_SQL,
     EVENTS_WITH_PROPS_TABLE_SQL,
 )
@@ -26,6 +35,8 @@ from ee.clickhouse.sql.session_recording_events import (
 
 class ClickhouseTestMixin:
     def tearDown(self):
+        # results derived from the dropped tables, e.g. stored top breakdown values, mustn't leak into the next test
+        cache.clear()
         try:
             self._destroy_event_tables()
             self._destroy_person_tables()
@@ -59,12 +70,20 @@ class ClickhouseTestMixin:
         sync_execute(SESSION_RECORDING_EVENTS_TABLE_SQL)
 
     def _destroy_event_tables(self):
+        sync_execute(DROP_EVENTS_ACTIVITY_MV_SQL)
+        sync_execute(DROP_EVENTS_ACTIVITY_TABLE_SQL)
+        sync_execute(DROP_EVENTS_FIRST_SEEN_MV_SQL)
+        sync_execute(DROP_EVENTS_FIRST_SEEN_TABLE_SQL)
         sync_execute(DROP_EVENTS_TABLE_SQL)
         sync_execute(DROP_EVENTS_WITH_ARRAY_PROPS_TABLE_SQL)
 
     def _create_event_tables(self):
         sync_execute(EVENTS_TABLE_SQL)
         sync_execute(EVENTS_WITH_PROPS_TABLE_SQL)
+        sync_execute(EVENTS_FIRST_SEEN_TABLE_SQL)
+        sync_execute(EVENTS_FIRST_SEEN_MV_SQL)
+        sync_execute(EVENTS_ACTIVITY_TABLE_SQL)
+        sync_execute(EVENTS_ACTIVITY_MV_SQL)
 
     @contextmanager
     def _assertNumQueries(self, func):
@@ -13,7 +13,7 @@ from sentry_sdk.api import capture_exception
 from ee.clickhouse.client import sync_execute
 from ee.clickhouse.models.action import format_action_filter, format_entity_filter
 from ee.clickhouse.models.cohort import format_filter_query
-from ee.clickhouse.models.person import ClickhousePersonSerializer
+from ee.clickhouse.models.person import ClickhousePersonSerializer, serialize_clickhouse_people_by_uuids
 from ee.clickhouse.models.property import parse_prop_clauses
 from ee.clickhouse.queries.trends.util import get_active_user_params
 from ee.clickhouse.queries.util import parse_timestamps
@@ -23,12 +23,13 @@ from ee.clickhouse.sql.person import (
     INSERT_COHORT_ALL_PEOPLE_THROUGH_DISTINCT_SQL,
     PEOPLE_SQL,
     PEOPLE_THROUGH_DISTINCT_SQL,
+    PERSON_IDS_THROUGH_DISTINCT_SQL,
     PERSON_STATIC_COHORT_TABLE,
     PERSON_TREND_SQL,
 )
 from ee.clickhouse.sql.trends.volume import PERSONS_ACTIVE_USER_SQL
 from posthog.api.action import ActionSerializer, ActionViewSet
-from posthog.api.utils import get_target_entity
+from posthog.api.utils import get_target_entity, people_drilldown
 from posthog.constants import MONTHLY_ACTIVE, WEEKLY_ACTIVE
 from posthog.models.action import Action
 from posthog.models.cohort import Cohort
@@ -79,24 +80,15 @@ class ClickhouseActionsViewSet(ActionViewSet):
         entity = get_target_entity(request)
 
         current_url = request.get_full_path()
-        serialized_people = calculate_entity_people(team, entity, filter)
-
-        current_url = request.get_full_path()
-        next_url: Optional[str] = request.get_full_path()
-        offset = filter.offset
-        if len(serialized_people) > 100 and next_url:
-            if "offset" in next_url:
-                next_url = next_url[1:]
-                next_url = next_url.replace("offset=" + str(offset), "offset=" + str(offset + 100))
-            else:
-                next_url = request.build_absolute_uri(
-                    "{}{}offset={}".format(next_url, "&" if "?" in next_url else "?", offset + 100)
-                )
-        else:
-            next_url = None
+        people, total_count, next_url = people_drilldown(
+            request,
+            team.pk,
+            compute=lambda: calculate_entity_people_uuids(team, entity, filter),
+            serialize=lambda uuids: serialize_clickhouse_people_by_uuids(team.pk, uuids),
+        )
         return Response(
             {
-                "results": [{"people": serialized_people[0:100], "count": len(serialized_people[0:99])}],
+                "results": [{"people": people, "count": len(people), "total_count": total_count}],
                 "next": next_url,
                 "previous": current_url[1:],
             }
@@ -185,6 +177,19 @@ def calculate_entity_people(team: Team, entity: Entity, filter: Filter):
     return serialized_people
 
 
+def calculate_entity_people_uuids(team: Team, entity: Entity, filter: Filter) -> List[str]:
+    content_sql, params = _process_content_sql(team, entity, filter)
+
+    if entity.math in [WEEKLY_ACTIVE, MONTHLY_ACTIVE]:
+        # already distinct person ids
+        query = content_sql
+    else:
+        query = PERSON_IDS_THROUGH_DISTINCT_SQL.format(
+            content_sql=content_sql, latest_distinct_id_sql=GET_LATEST_PERSON_DISTINCT_ID_SQL,
+        )
+    return sorted(str(row[0]) for row in sync_execute(query, params))
+
+
 def insert_entity_people_into_cohort(cohort: Cohort, entity: Entity, filter: Filter):
     content_sql, params = _process_content_sql(cohort.team, entity, filter)
     sync_execute(
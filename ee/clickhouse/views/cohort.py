@@ -1,6 +1,5 @@
-from ee.clickhouse.client import sync_execute
+from ee.clickhouse.models.cohort import get_static_cohort_person_uuid_batches
 from ee.clickhouse.queries.util import get_earliest_timestamp
-from ee.clickhouse.sql.person import PERSON_STATIC_COHORT_TABLE
 from posthog.api.cohort import CohortSerializer, CohortViewSet
 from posthog.constants import INSIGHT_STICKINESS, INSIGHT_TRENDS
 from posthog.models.cohort import Cohort
@@ -24,13 +23,7 @@ class ClickhouseCohortSerializer(CohortSerializer):
 
 
 def insert_cohort_people_into_pg(cohort: Cohort):
-    ids = sync_execute(
-        "SELECT person_id FROM {} where team_id = %(team_id)s AND cohort_id = %(cohort_id)s".format(
-            PERSON_STATIC_COHORT_TABLE
-        ),
-        {"cohort_id": cohort.pk, "team_id": cohort.team.pk},
-    )
-    cohort.insert_users_list_by_uuid(items=[str(id[0]) for id in ids])
+    cohort.insert_users_batches_by_uuid(get_static_cohort_person_uuid_batches(cohort))
 
 
 class ClickhouseCohortViewSet(CohortViewSet):
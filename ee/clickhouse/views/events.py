@@ -24,7 +24,6 @@ from posthog.api.event import EventViewSet
 from posthog.models import Filter, Person, Team
 from posthog.models.action import Action
 from posthog.models.filters.sessions_filter import SessionsFilter
-from posthog.models.session_recording_event import SessionRecordingViewed
 from posthog.utils import convert_property_value, flatten
 
 
@@ -43,6 +42,7 @@ class ClickhouseEventsViewSet(EventViewSet):
         self, filter: Filter, team: Team, request: Request, long_date_from: bool = False, limit: int = 100
     ) -> List:
         limit_sql = f"LIMIT {limit + 1}"
+        order = "ASC" if json.loads(request.GET.get("orderBy", "[]")) == ["timestamp"] else "DESC"
         conditions, condition_params = determine_event_conditions(
             team,
             {
@@ -67,12 +67,14 @@ class ClickhouseEventsViewSet(EventViewSet):
 
         if prop_filters != "":
             return sync_execute(
-                SELECT_EVENT_WITH_PROP_SQL.format(conditions=conditions, limit=limit_sql, filters=prop_filters),
+                SELECT_EVENT_WITH_PROP_SQL.format(
+                    conditions=conditions, limit=limit_sql, filters=prop_filters, order=order
+                ),
                 {"team_id": team.pk, **condition_params, **prop_filter_params},
             )
         else:
             return sync_execute(
-                SELECT_EVENT_WITH_ARRAY_PROPS_SQL.format(conditions=conditions, limit=limit_sql),
+                SELECT_EVENT_WITH_ARRAY_PROPS_SQL.format(conditions=conditions, limit=limit_sql, order=order),
                 {"team_id": team.pk, **condition_params},
             )
 
@@ -145,6 +147,7 @@ class ClickhouseEventsViewSet(EventViewSet):
     # params:
     # - session_recording_id: (string) id of the session recording
     # - save_view: (boolean) save view of the recording
+    # - limit, offset: (int) page through the snapshots as stored, leaving chunked snapshots compressed
     # ******************************************
     @action(methods=["GET"], detail=False)
     def session_recording(self, request: Request, *args: Any, **kwargs: Any) -> Response:
@@ -158,13 +161,8 @@ class ClickhouseEventsViewSet(EventViewSet):
                 status=400,
             )
 
-        session_recording = SessionRecording().run(
-            team=self.team, filter=Filter(request=request), session_recording_id=request.GET["session_recording_id"]
-        )
+        session_recording = self._run_session_recording(SessionRecording(), request)
 
-        if request.GET.get("save_view"):
-            SessionRecordingViewed.objects.get_or_create(
-                team=self.team, user=request.user, session_id=request.GET["session_recording_id"]
-            )
+        self._save_recording_view(request)
 
         return Response({"result": session_recording})
@@ -4,6 +4,7 @@ from rest_framework.decorators import action
 from rest_framework.request import Request
 from rest_framework.response import Response
 
+from ee.clickhouse.explain import explainable
 from ee.clickhouse.queries.clickhouse_funnel import ClickhouseFunnel
 from ee.clickhouse.queries.clickhouse_paths import ClickhousePaths
 from ee.clickhouse.queries.clickhouse_retention import ClickhouseRetention
@@ -12,6 +13,7 @@ from ee.clickhouse.queries.sessions.clickhouse_sessions import ClickhouseSession
 from ee.clickhouse.queries.trends.clickhouse_trends import ClickhouseTrends
 from ee.clickhouse.queries.util import get_earliest_timestamp
 from posthog.api.insight import InsightViewSet
+from posthog.api.utils import insight_response
 from posthog.constants import INSIGHT_FUNNELS, INSIGHT_PATHS, INSIGHT_SESSIONS, TRENDS_STICKINESS
 from posthog.decorators import cached_function
 from posthog.models import Event
@@ -23,6 +25,7 @@ from posthog.models.filters.stickiness_filter import StickinessFilter
 
 
 class ClickhouseInsightsViewSet(InsightViewSet):
+    @explainable()
     @cached_function()
     def calculate_trends(self, request: Request) -> Dict[str, Any]:
         team = self.team
@@ -40,6 +43,7 @@ class ClickhouseInsightsViewSet(InsightViewSet):
         self._refresh_dashboard(request=request)
         return {"result": result}
 
+    @explainable()
     @cached_function()
     def calculate_session(self, request: Request) -> Dict[str, Any]:
         return {
@@ -48,6 +52,7 @@ class ClickhouseInsightsViewSet(InsightViewSet):
             )
         }
 
+    @explainable()
     @cached_function()
     def calculate_path(self, request: Request) -> Dict[str, Any]:
         team = self.team
@@ -58,14 +63,16 @@ class ClickhouseInsightsViewSet(InsightViewSet):
     @action(methods=["GET"], detail=False)
     def funnel(self, request: Request, *args: Any, **kwargs: Any) -> Response:
         response = self.calculate_funnel(request)
-        return Response(response)
+        return insight_response(request, response)
 
+    @explainable()
     @cached_function()
     def calculate_funnel(self, request: Request) -> Dict[str, Any]:
         team = self.team
         filter = Filter(request=request, data={"insight": INSIGHT_FUNNELS})
         return {"result": ClickhouseFunnel(team=team, filter=filter).run()}
 
+    @explainable()
     @cached_function()
     def calculate_retention(self, request: Request) -> Dict[str, Any]:
         team = self.team
@@ -1,12 +1,18 @@
+from datetime import datetime
+from typing import List, Optional, Tuple
+
 from rest_framework import request, response
 from rest_framework.exceptions import NotFound
 
-from ee.clickhouse.models.person import delete_person
+from ee.clickhouse.models.person import delete_person, serialize_clickhouse_people_by_uuids, serialize_people_by_uuids
 from ee.clickhouse.queries.clickhouse_retention import ClickhouseRetention
 from ee.clickhouse.queries.clickhouse_stickiness import ClickhouseStickiness
 from ee.clickhouse.queries.trends.lifecycle import ClickhouseLifecycle
 from posthog.api.person import PersonViewSet
-from posthog.models import Event, Person
+from posthog.api.utils import people_drilldown
+from posthog.models import Entity, Event, EventFirstSeen, Filter, Person, Team
+from posthog.models.filters import RetentionFilter
+from posthog.models.filters.stickiness_filter import StickinessFilter
 
 
 # TODO: Move grabbing all this to Clickhouse. See WIP-people-from-clickhouse branch.
@@ -22,8 +28,55 @@ class ClickhousePersonViewSet(PersonViewSet):
 
             events = Event.objects.filter(team=self.team, distinct_id__in=person.distinct_ids)
             events.delete()
+            EventFirstSeen.objects.filter(team=self.team, distinct_id__in=person.distinct_ids).delete()
             delete_person(person.uuid, delete_events=True, team_id=self.team.pk)
             person.delete()
             return response.Response(status=204)
         except Person.DoesNotExist:
             raise NotFound(detail="Person not found.")
+
+    # Drilldowns page through the matching people with a cursor, see `people_drilldown`
+
+    def _lifecycle_people(
+        self,
+        request: request.Request,
+        filter: Filter,
+        team: Team,
+        target_date: datetime,
+        lifecycle_type: str,
+        limit: int,
+    ) -> Tuple[List, Optional[int], Optional[str]]:
+        return people_drilldown(
+            request,
+            team.pk,
+            compute=lambda: ClickhouseLifecycle().get_people_uuids(filter, team.pk, target_date, lifecycle_type),
+            serialize=lambda uuids: serialize_people_by_uuids(team.pk, uuids),
+            page_size=limit,
+        )
+
+    def _retention_people(
+        self, request: request.Request, filter: RetentionFilter, team: Team, in_period: bool
+    ) -> Tuple[List, Optional[int], Optional[str]]:
+        if in_period:
+            return people_drilldown(
+                request,
+                team.pk,
+                compute=lambda: ClickhouseRetention().people_in_period_rows(filter, team),
+                serialize=lambda rows: ClickhouseRetention().serialize_people_in_period(filter, team, rows),
+            )
+        return people_drilldown(
+            request,
+            team.pk,
+            compute=lambda: ClickhouseRetention().people_uuids(filter, team),
+            serialize=lambda uuids: serialize_clickhouse_people_by_uuids(team.pk, uuids),
+        )
+
+    def _stickiness_people(
+        self, request: request.Request, filter: StickinessFilter, team: Team, target_entity: Entity
+    ) -> Tuple[List, Optional[int], Optional[str]]:
+        return people_drilldown(
+            request,
+            team.pk,
+            compute=lambda: ClickhouseStickiness().people_uuids(target_entity, filter, team),
+            serialize=lambda uuids: serialize_clickhouse_people_by_uuids(team.pk, uuids),
+        )
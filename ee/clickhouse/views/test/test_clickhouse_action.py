@@ -125,3 +125,54 @@ class TestAction(
             },
         ).json()
         self.assertEqual(len(people["results"][0]["people"]), 2)
+
+    def test_people_cursor_pagination(self):
+        for index in range(0, 150):
+            _create_person(team_id=self.team.pk, distinct_ids=["person" + str(index)])
+            _create_event(
+                team=self.team, event="sign up", distinct_id="person" + str(index), timestamp="2020-01-04T12:00:00Z",
+            )
+
+        response = self.client.get(
+            "/api/action/people/",
+            data={"date_from": "2020-01-04", "date_to": "2020-01-04", ENTITY_TYPE: "events", ENTITY_ID: "sign up"},
+        ).json()
+        self.assertEqual(response["results"][0]["total_count"], 150)
+        self.assertIn("cursor=", response["next"])
+
+        # the next page is a slice of the people computed for the first one, new events don't shift it
+        _create_person(team_id=self.team.pk, distinct_ids=["late_person"])
+        _create_event(team=self.team, event="sign up", distinct_id="late_person", timestamp="2020-01-04T13:00:00Z")
+        next_response = self.client.get(response["next"]).json()
+        self.assertEqual(next_response["results"][0]["total_count"], 150)
+        self.assertEqual(len(next_response["results"][0]["people"]), 50)
+        self.assertIsNone(next_response["next"])
+
+        first_page_ids = {person["id"] for person in response["results"][0]["people"]}
+        self.assertFalse(first_page_ids & {person["id"] for person in next_response["results"][0]["people"]})
+
+        invalid_response = self.client.get(
+            "/api/action/people/", data={ENTITY_TYPE: "events", ENTITY_ID: "sign up", "cursor": "invalid"}
+        )
+        self.assertEqual(invalid_response.status_code, status.HTTP_400_BAD_REQUEST)
+
+    @patch("posthog.api.utils.PEOPLE_DRILLDOWN_CACHED_PEOPLE", 100)
+    def test_people_cursor_pagination_past_cached_window(self):
+        for index in range(0, 250):
+            _create_person(team_id=self.team.pk, distinct_ids=["person" + str(index)])
+            _create_event(
+                team=self.team, event="sign up", distinct_id="person" + str(index), timestamp="2020-01-04T12:00:00Z",
+            )
+
+        url = "/api/action/people/?date_from=2020-01-04&date_to=2020-01-04&{}=events&{}=sign up".format(
+            ENTITY_TYPE, ENTITY_ID
+        )
+        seen_ids = set()
+        while url:
+            response = self.client.get(url).json()
+            self.assertEqual(response["results"][0]["total_count"], 250)
+            page_ids = {person["id"] for person in response["results"][0]["people"]}
+            self.assertFalse(seen_ids & page_ids)
+            seen_ids |= page_ids
+            url = response["next"]
+        self.assertEqual(len(seen_ids), 250)
@@ -48,8 +48,16 @@ def django_db_setup(django_db_setup, django_db_keepdb):
 @pytest.fixture
 def db(db):
     from ee.clickhouse.sql.events import (
+        DROP_EVENTS_ACTIVITY_MV_SQL,
+        DROP_EVENTS_ACTIVITY_TABLE_SQL,
+        DROP_EVENTS_FIRST_SEEN_MV_SQL,
+        DROP_EVENTS_FIRST_SEEN_TABLE_SQL,
         DROP_EVENTS_TABLE_SQL,
         DROP_EVENTS_WITH_ARRAY_PROPS_TABLE_SQL,
+        EVENTS_ACTIVITY_MV_SQL,
+        EVENTS_ACTIVITY_TABLE_SQL,
+        EVENTS_FIRST_SEEN_MV_SQL,
+        EVENTS_FIRST_SEEN_TABLE_SQL,
         EVENTS_TABLE_SQL,
         EVENTS_WITH_PROPS_TABLE_SQL,
     )
@@ -69,6 +77,10 @@ def db(db):
     yield
 
     try:
+        sync_execute(DROP_EVENTS_ACTIVITY_MV_SQL)
+        sync_execute(DROP_EVENTS_ACTIVITY_TABLE_SQL)
+        sync_execute(DROP_EVENTS_FIRST_SEEN_MV_SQL)
+        sync_execute(DROP_EVENTS_FIRST_SEEN_TABLE_SQL)
         sync_execute(DROP_EVENTS_TABLE_SQL)
         sync_execute(DROP_EVENTS_WITH_ARRAY_PROPS_TABLE_SQL)
         sync_execute(DROP_PERSON_TABLE_SQL)
@@ -79,6 +91,10 @@ def db(db):
 
         sync_execute(EVENTS_TABLE_SQL)
         sync_execute(EVENTS_WITH_PROPS_TABLE_SQL)
+        sync_execute(EVENTS_FIRST_SEEN_TABLE_SQL)
+        sync_execute(EVENTS_FIRST_SEEN_MV_SQL)
+        sync_execute(EVENTS_ACTIVITY_TABLE_SQL)
+        sync_execute(EVENTS_ACTIVITY_MV_SQL)
         sync_execute(SESSION_RECORDING_EVENTS_TABLE_SQL)
         sync_execute(PERSONS_TABLE_SQL)
         sync_execute(PERSONS_DISTINCT_ID_TABLE_SQL)
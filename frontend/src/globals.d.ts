@@ -1,6 +1,9 @@
 import posthog from 'posthog-js'
 
 declare global {
+    // Set by webpack, where the bundles are served from
+    let __webpack_public_path__: string
+
     interface Window {
         JS_POSTHOG_API_KEY?: str
         JS_POSTHOG_HOST?: str
@@ -41,6 +41,33 @@ class Api {
         }
         return await getJSONOrThrow(response)
     }
+    // Like `get`, but revalidates `etag`: resolves to `{ notModified: true }` when the server still has the same data
+    async getWithETag(url, etag = null) {
+        if (url.indexOf('http') !== 0) {
+            url = '/' + url + (url.indexOf('?') === -1 && url[url.length - 1] !== '/' ? '/' : '')
+        }
+
+        let response
+        try {
+            response = await fetch(url, etag ? { headers: { 'If-None-Match': etag } } : undefined)
+        } catch (e) {
+            throw { status: 0, message: e }
+        }
+
+        if (response.status === 304) {
+            return { notModified: true, etag, url: response.url }
+        }
+        if (!response.ok) {
+            const data = await getJSONOrThrow(response)
+            throw { status: response.status, ...data }
+        }
+        return {
+            notModified: false,
+            etag: response.headers.get('ETag'),
+            data: await getJSONOrThrow(response),
+            url: response.url,
+        }
+    }
     async update(url, data) {
         if (url.indexOf('http') !== 0) {
             url = '/' + url + (url.indexOf('?') === -1 && url[url.length - 1] !== '/' ? '/' : '')
@@ -13,6 +13,7 @@ interface Props {
     autoOpenIfEmpty?: boolean
     delayBeforeAutoOpen?: number
     dropdownMatchSelectWidth?: boolean | number
+    onSearch?: (search: string) => void // To fetch matching options that aren't loaded yet
 }
 
 export interface PropertyOptionGroup {
@@ -27,7 +28,7 @@ interface SelectionOptionType {
     type: 'event' | 'person' | 'element'
 }
 
-const fuseCache: Record<string, any> = {}
+const fuseCache: Record<string, { sources: Array<{ value: string }>; fuse: Fuse<{ value: string }> }> = {}
 
 export const searchItems = (
     sources: Array<{ value: string }>,
@@ -38,15 +39,17 @@ export const searchItems = (
         return sources
     }
 
-    if (!fuseCache[groupType]) {
-        fuseCache[groupType] = new Fuse(sources, {
-            keys: ['value'],
-            threshold: 0.3,
-        })
+    // options grow as more of them are fetched from the server, the index has to follow
+    if (fuseCache[groupType]?.sources !== sources) {
+        fuseCache[groupType] = {
+            sources,
+            fuse: new Fuse(sources, {
+                keys: ['value'],
+                threshold: 0.3,
+            }),
+        }
     }
-    return fuseCache[groupType].search(search).map((result: Record<string, { item: string }>) => {
-        return result.item
-    })
+    return fuseCache[groupType].fuse.search(search).map((result) => result.item)
 }
 
 export function PropertySelect({
@@ -57,6 +60,7 @@ export function PropertySelect({
     autoOpenIfEmpty,
     delayBeforeAutoOpen,
     dropdownMatchSelectWidth = true,
+    onSearch,
 }: Props): JSX.Element {
     const [search, setSearch] = useState(false as string | false)
     return (
@@ -71,6 +75,7 @@ export function PropertySelect({
             value={propertyOption || undefined}
             onSearch={(value) => {
                 setSearch(value)
+                onSearch?.(value)
             }}
             filterOption={() => {
                 return true // set to avoid ant.d doing its own filtering
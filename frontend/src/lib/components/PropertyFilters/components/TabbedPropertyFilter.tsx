@@ -14,6 +14,7 @@ import { isOperatorMulti, isOperatorRegex } from 'lib/utils'
 import { PropertyOptionGroup } from './PropertySelect'
 import { PropertyOperator, PropertyDefinition, SelectOption } from '~/types'
 import { PropertyFilterInternalProps } from './PropertyFilter'
+import { propertyDefinitionsLogic } from 'scenes/events/propertyDefinitionsLogic'
 
 const { TabPane } = Tabs
 
@@ -42,6 +43,7 @@ function PropertyPaneContents({
     displayOperatorAndValue,
     selectProps: { delayBeforeAutoOpen = 0 },
 }: PropertyPaneProps): JSX.Element {
+    const { searchPropertyDefinitions } = useActions(propertyDefinitionsLogic)
     const optionGroups = [
         {
             type: 'event',
@@ -88,6 +90,7 @@ function PropertyPaneContents({
                         )
                     }
                     optionGroups={optionGroups}
+                    onSearch={searchPropertyDefinitions}
                     autoOpenIfEmpty
                     delayBeforeAutoOpen={delayBeforeAutoOpen}
                     placeholder="Property key"
@@ -15,6 +15,7 @@ import {
 import { humanFriendlyDetailedTime, isOperatorMulti, isOperatorRegex } from 'lib/utils'
 import { SelectBox, SelectBoxItem, SelectedItem } from 'lib/components/SelectBox'
 import { PropertyFilterInternalProps } from './PropertyFilter'
+import { propertyDefinitionsLogic } from 'scenes/events/propertyDefinitionsLogic'
 
 function FilterDropdown({ open, children }: { open: boolean; children: React.ReactNode }): JSX.Element | null {
     return open ? <div>{children}</div> : null
@@ -77,6 +78,7 @@ export function UnifiedPropertyFilter({ index, onComplete, logic }: PropertyFilt
 
     const { cohorts } = useValues(cohortsModel)
     const { setFilter } = useActions(logic)
+    const { searchPropertyDefinitions } = useActions(propertyDefinitionsLogic)
     const { key, value, operator, type } = filters[index]
     const [open, setOpen] = useState(false)
     const selectBoxToggleRef = useRef<HTMLElement>(null)
@@ -227,6 +229,7 @@ export function UnifiedPropertyFilter({ index, onComplete, logic }: PropertyFilt
                                 setOpen(false)
                             }}
                             items={selectBoxItems}
+                            onSearch={searchPropertyDefinitions}
                             inputPlaceholder="Search cohorts, and event or user properties"
                         />
                     </FilterDropdown>
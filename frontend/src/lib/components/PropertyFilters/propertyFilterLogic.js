@@ -25,6 +25,7 @@ export const propertyFilterLogic = kea({
 
     actions: () => ({
         setProperties: (properties) => ({ properties }),
+        syncEventProperties: true,
         update: (filters) => ({ filters }),
         setFilter: (index, key, value, operator, type) => ({ index, key, value, operator, type }),
         setFilters: (filters) => ({ filters }),
@@ -106,6 +107,16 @@ export const propertyFilterLogic = kea({
         [propertyDefinitionsLogic.actionTypes.loadPropertyDefinitionsSuccess]: async () => {
             /* Set the event properties in case the `loadPropertyDefinitions` request came later, or the event
             properties were updated. */
+            actions.syncEventProperties()
+        },
+        [propertyDefinitionsLogic.actionTypes.searchPropertyDefinitionsSuccess]: async () => {
+            // Properties matching the search are fetched from the server as the user types
+            actions.syncEventProperties()
+        },
+        [propertyDefinitionsLogic.actionTypes.loadNumericalPropertyDefinitionsSuccess]: async () => {
+            actions.syncEventProperties()
+        },
+        [actions.syncEventProperties]: () => {
             if (props.endpoint !== 'person' && props.endpoint !== 'sessions') {
                 actions.setProperties(propertyDefinitionsLogic.values.transformedPropertyDefinitions)
             }
@@ -139,14 +150,12 @@ export const propertyFilterLogic = kea({
         filtersLoading: [() => [propertyDefinitionsLogic.selectors.loaded], (loaded) => !loaded],
     },
 
-    events: ({ actions, props }) => ({
+    events: ({ actions }) => ({
         afterMount: () => {
             actions.newFilter()
             actions.loadPersonProperties()
             // TODO: Event properties in sessions is temporarily unsupported (context https://github.com/PostHog/posthog/issues/2735)
-            if (props.endpoint !== 'person' && props.endpoint !== 'sessions') {
-                actions.setProperties(propertyDefinitionsLogic.values.transformedPropertyDefinitions)
-            }
+            actions.syncEventProperties()
         },
     }),
 })
@@ -55,6 +55,7 @@ export function SelectBox({
     onDismiss,
     inputPlaceholder,
     disablePopover = false,
+    onSearch,
 }: {
     items: SelectBoxItem[]
     selectedItemKey?: string
@@ -62,6 +63,7 @@ export function SelectBox({
     onDismiss: (event: MouseEvent) => void
     inputPlaceholder?: string
     disablePopover?: boolean // Disable PropertyKeyInfo popover
+    onSearch?: (search: string) => void // To fetch matching items that aren't loaded yet
 }): JSX.Element {
     const dropdownRef = useRef<HTMLDivElement>(null)
     const dropdownLogic = selectBoxLogic({ updateFilter: onSelect, items })
@@ -104,6 +106,7 @@ export function SelectBox({
                         autoFocus
                         onChange={(e) => {
                             setSearch(e.target.value)
+                            onSearch?.(e.target.value)
                         }}
                         style={{ width: '100%', borderRadius: 0, height: '10%' }}
                     />
@@ -0,0 +1,8 @@
+/** Starts a Web Worker from one of the worker bundles built by `webpack.config.js`, e.g. `snapshot_worker`. */
+export function createWorker(bundleName: string): Worker {
+    /* Worker bundles are served next to the app bundle, which can be another origin than the page in development
+    (webpack dev server). Workers must be same-origin, so the bundle is loaded from a same-origin blob instead. */
+    const workerUrl = new URL(`${bundleName}.js`, new URL(__webpack_public_path__, window.location.href)).href
+    const blob = new Blob([`importScripts(${JSON.stringify(workerUrl)})`], { type: 'application/javascript' })
+    return new Worker(URL.createObjectURL(blob))
+}
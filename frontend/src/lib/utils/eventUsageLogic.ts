@@ -7,6 +7,7 @@ import { eventUsageLogicType } from './eventUsageLogicType'
 import { AnnotationType, FilterType, DashboardType, PersonType, DashboardMode, HotKeys, GlobalHotKeys } from '~/types'
 import { ViewType } from 'scenes/insights/insightLogic'
 import dayjs from 'dayjs'
+import { InsightRequestTiming } from 'lib/utils/insightCache'
 
 const keyMappingKeys = Object.keys(keyMapping.event)
 
@@ -21,8 +22,31 @@ export enum DashboardEventSource {
     AddDescription = 'add_description',
 }
 
+export interface InsightLoadTiming extends Omit<InsightRequestTiming, 'startedAt'> {
+    duration: number // from the start of the query to the chart painted
+    renderDuration: number
+    isCached: boolean // whether the server answered from its cache
+}
+
+export interface DashboardLoadTiming {
+    duration: number // from opening (or refreshing) the dashboard to all its tiles painted
+    firstItemDuration: number | null
+    itemCount: number
+    cachedItemCount: number
+    refresh: boolean
+}
+
 export const eventUsageLogic = kea<
-    eventUsageLogicType<AnnotationType, FilterType, DashboardType, PersonType, DashboardMode, DashboardEventSource>
+    eventUsageLogicType<
+        AnnotationType,
+        FilterType,
+        DashboardType,
+        PersonType,
+        DashboardMode,
+        DashboardEventSource,
+        InsightLoadTiming,
+        DashboardLoadTiming
+    >
 >({
     actions: {
         reportAnnotationViewed: (annotations: AnnotationType[] | null) => ({ annotations }),
@@ -93,6 +117,8 @@ export const eventUsageLogic = kea<
             extraProps?: Record<string, string | boolean | number | undefined>
         ) => ({ module, item, extraProps }),
         reportProjectHomeSeen: (teamHasData: boolean) => ({ teamHasData }),
+        reportInsightLoaded: (insight: string, timing: InsightLoadTiming) => ({ insight, timing }),
+        reportDashboardLoaded: (dashboard: DashboardType, timing: DashboardLoadTiming) => ({ dashboard, timing }),
     },
     listeners: {
         reportAnnotationViewed: async ({ annotations }, breakpoint) => {
@@ -349,5 +375,27 @@ export const eventUsageLogic = kea<
         reportProjectHomeSeen: async ({ teamHasData }) => {
             posthog.capture('project home seen', { team_has_data: teamHasData })
         },
+        reportInsightLoaded: async ({ insight, timing }) => {
+            posthog.capture('insight loaded', {
+                insight,
+                source: timing.source,
+                is_cached: timing.isCached,
+                duration: Math.round(timing.duration),
+                request_duration: Math.round(timing.requestDuration),
+                server_duration: timing.serverDuration === null ? null : Math.round(timing.serverDuration),
+                transfer_duration: timing.transferDuration === null ? null : Math.round(timing.transferDuration),
+                render_duration: Math.round(timing.renderDuration),
+            })
+        },
+        reportDashboardLoaded: async ({ dashboard, timing }) => {
+            posthog.capture('dashboard loaded', {
+                is_shared: dashboard.is_shared,
+                refresh: timing.refresh,
+                item_count: timing.itemCount,
+                cached_item_count: timing.cachedItemCount,
+                duration: Math.round(timing.duration),
+                first_item_duration: timing.firstItemDuration === null ? null : Math.round(timing.firstItemDuration),
+            })
+        },
     },
 })
@@ -0,0 +1,123 @@
+import api from 'lib/api'
+
+// Insight responses already received in this tab, the least recently used first. Entries younger than
+// `INSIGHT_CACHE_MAX_AGE` are returned without a request, older ones are revalidated with their ETag.
+const INSIGHT_CACHE_SIZE = 50
+const INSIGHT_CACHE_MAX_AGE = 30 * 1000
+
+interface InsightCacheEntry {
+    etag: string | null
+    response: Record<string, any>
+    fetchedAt: number
+}
+
+export interface InsightRequestTiming {
+    source: 'memory' | 'revalidated' | 'network'
+    // `performance.now()` when loading the insight started, kept per response as several insights load at once
+    startedAt: number
+    requestDuration: number
+    // From the Resource Timing of the request: waiting for the first byte (mostly server compute), then the download
+    serverDuration: number | null
+    transferDuration: number | null
+}
+
+const insightCache = new Map<string, InsightCacheEntry>()
+const requestTimings = new WeakMap<Record<string, any>, InsightRequestTiming>()
+
+function stableStringify(value: any): string {
+    if (Array.isArray(value)) {
+        return `[${value.map(stableStringify).join(',')}]`
+    }
+    if (value && typeof value === 'object') {
+        const keys = Object.keys(value)
+            .filter((key) => value[key] !== undefined)
+            .sort()
+        return `{${keys.map((key) => `${JSON.stringify(key)}:${stableStringify(value[key])}`).join(',')}}`
+    }
+    return JSON.stringify(value)
+}
+
+/** The same filters give the same key, whatever the order of params and of keys in JSON encoded params. */
+export function insightCacheKey(url: string): string {
+    const [path, query = ''] = url.split('?')
+    const params: string[] = []
+    new URLSearchParams(query).forEach((value, key) => {
+        if (key === 'refresh' || value === '' || value === 'undefined') {
+            return
+        }
+        let normalized = value
+        if (value[0] === '{' || value[0] === '[') {
+            try {
+                normalized = stableStringify(JSON.parse(value))
+            } catch (e) {
+                // not JSON after all, kept as is
+            }
+        }
+        params.push(`${key}=${normalized}`)
+    })
+    return `${path.replace(/\/$/, '')}?${params.sort().join('&')}`
+}
+
+function isLoading(response: Record<string, any>): boolean {
+    return !!response?.result?.loading
+}
+
+function resourceTiming(url: string): Pick<InsightRequestTiming, 'serverDuration' | 'transferDuration'> {
+    const entries = url && window.performance?.getEntriesByName ? performance.getEntriesByName(url, 'resource') : []
+    const entry = entries[entries.length - 1] as PerformanceResourceTiming | undefined
+    if (!entry || !entry.requestStart) {
+        return { serverDuration: null, transferDuration: null }
+    }
+    return {
+        serverDuration: entry.responseStart - entry.requestStart,
+        transferDuration: entry.responseEnd - entry.responseStart,
+    }
+}
+
+/** How the last `getInsight` call returning `response` got it, for performance telemetry. */
+export function getInsightRequestTiming(response: Record<string, any> | null | undefined): InsightRequestTiming | null {
+    return (response && requestTimings.get(response)) || null
+}
+
+/**
+ * `api.get` for insight endpoints, through the cache unless the url asks for a `refresh`. An insight polled over
+ * several calls passes the `startedAt` of the first one, so the timing covers the whole wait.
+ */
+export async function getInsight(url: string, startedAt: number = performance.now()): Promise<Record<string, any>> {
+    const key = insightCacheKey(url)
+    const refresh = new URLSearchParams(url.split('?')[1] || '').has('refresh')
+    const entry = refresh ? undefined : insightCache.get(key)
+
+    if (entry) {
+        insightCache.delete(key)
+        insightCache.set(key, entry)
+        if (Date.now() - entry.fetchedAt < INSIGHT_CACHE_MAX_AGE) {
+            requestTimings.set(entry.response, {
+                source: 'memory',
+                startedAt,
+                requestDuration: 0,
+                serverDuration: null,
+                transferDuration: null,
+            })
+            return entry.response
+        }
+    }
+
+    const requestStartedAt = performance.now()
+    const { notModified, etag, data, url: responseUrl } = await api.getWithETag(url, entry?.etag)
+    const response = notModified && entry ? entry.response : data
+    requestTimings.set(response, {
+        source: notModified ? 'revalidated' : 'network',
+        startedAt,
+        requestDuration: performance.now() - requestStartedAt,
+        ...resourceTiming(responseUrl),
+    })
+    if (!isLoading(response)) {
+        insightCache.delete(key)
+        insightCache.set(key, { etag, response, fetchedAt: Date.now() })
+        if (insightCache.size > INSIGHT_CACHE_SIZE) {
+            insightCache.delete(insightCache.keys().next().value)
+        }
+    }
+    return response
+}
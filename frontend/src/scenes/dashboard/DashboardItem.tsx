@@ -9,7 +9,7 @@ import { ActionsLineGraph } from 'scenes/trends/viz/ActionsLineGraph'
 import { ActionsTable } from 'scenes/trends/viz/ActionsTable'
 import { ActionsPie } from 'scenes/trends/viz/ActionsPie'
 import { FunnelViz } from 'scenes/funnels/FunnelViz'
-import { Paths } from 'scenes/paths/Paths'
+import { LazyPaths } from 'scenes/paths/LazyPaths'
 import {
     EllipsisOutlined,
     EditOutlined,
@@ -59,6 +59,8 @@ interface Props {
     moveDashboardItem?: (it: DashboardItemType, dashboardId: number) => void
     saveDashboardItem?: (it: DashboardItemType) => void
     duplicateDashboardItem?: (it: DashboardItemType, dashboardId?: number) => void
+    shouldRefresh?: boolean
+    onLoadComplete?: () => void
 }
 
 export type DisplayedType = DisplayType | 'RetentionContainer'
@@ -100,7 +102,7 @@ export const displayMap: Record<DisplayedType, DisplayProps> = {
     ActionsPie: displayMapItem('pie', ActionsPie, PieChartOutlined, 'View graph'),
     FunnelViz: displayMapItem('funnel', FunnelViz, FunnelPlotOutlined, 'View funnel'),
     RetentionContainer: displayMapItem('retention', RetentionContainer, TableOutlined, 'View retention'),
-    PathsViz: displayMapItem('paths-viz', Paths, FunnelPlotOutlined, 'View graph'),
+    PathsViz: displayMapItem('paths-viz', LazyPaths, FunnelPlotOutlined, 'View graph'),
 }
 
 export function DashboardItem({
@@ -120,6 +122,8 @@ export function DashboardItem({
     moveDashboardItem,
     saveDashboardItem,
     duplicateDashboardItem,
+    shouldRefresh,
+    onLoadComplete,
 }: Props): JSX.Element {
     const [initialLoaded, setInitialLoaded] = useState(false)
     const [showSaveModal, setShowSaveModal] = useState(false)
@@ -180,8 +184,17 @@ export function DashboardItem({
         if (previousLoading && !resultsLoading && !initialLoaded) {
             setInitialLoaded(true)
         }
+        if (previousLoading && !resultsLoading) {
+            onLoadComplete?.()
+        }
     }, [resultsLoading])
 
+    useEffect(() => {
+        if (shouldRefresh) {
+            loadResults(true)
+        }
+    }, [shouldRefresh])
+
     return (
         <div
             key={item.id}
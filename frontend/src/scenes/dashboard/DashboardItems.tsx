@@ -3,6 +3,7 @@ import './DashboardItems.scss'
 import React, { useEffect, useRef, useState } from 'react'
 import { useActions, useValues } from 'kea'
 import { Responsive, WidthProvider } from 'react-grid-layout'
+import { Skeleton } from 'antd'
 
 import { DashboardItem } from 'scenes/dashboard/DashboardItem'
 import { isMobile, triggerResize, triggerResizeAfterADelay } from 'lib/utils'
@@ -14,16 +15,48 @@ import { DashboardEventSource } from '../../lib/utils/eventUsageLogic'
 const ReactGridLayout = WidthProvider(Responsive)
 
 export function DashboardItems({ inSharedMode }: { inSharedMode: boolean }): JSX.Element {
-    const { dashboard, items, layouts, layoutForItem, breakpoints, cols, dashboardMode } = useValues(dashboardLogic)
-    const { loadDashboardItems, updateLayouts, updateContainerWidth, updateItemColor, setDashboardMode } = useActions(
-        dashboardLogic
-    )
+    const {
+        dashboard,
+        items,
+        layouts,
+        layoutForItem,
+        breakpoints,
+        cols,
+        dashboardMode,
+        itemLoadStates,
+    } = useValues(dashboardLogic)
+    const {
+        loadDashboardItems,
+        updateLayouts,
+        updateContainerWidth,
+        updateItemColor,
+        setDashboardMode,
+        itemLoadComplete,
+        setItemVisible,
+    } = useActions(dashboardLogic)
     const { duplicateDashboardItem } = useActions(dashboardItemsModel)
 
     // make sure the dashboard takes up the right size
     useEffect(() => triggerResizeAfterADelay(), [])
     const [resizingItem, setResizingItem] = useState<any>(null)
 
+    // tiles in the viewport are loaded first
+    const visibilityObserver = useRef<IntersectionObserver | null>(null)
+    const observeItem = (element: HTMLDivElement | null): void => {
+        if (!element || typeof IntersectionObserver === 'undefined') {
+            return
+        }
+        if (!visibilityObserver.current) {
+            visibilityObserver.current = new IntersectionObserver((entries) =>
+                entries.forEach(({ target, isIntersecting }) =>
+                    setItemVisible(parseInt((target as HTMLElement).dataset.itemId || ''), isIntersecting)
+                )
+            )
+        }
+        visibilityObserver.current.observe(element)
+    }
+    useEffect(() => () => visibilityObserver.current?.disconnect(), [])
+
     // can not click links when dragging and 250ms after
     const isDragging = useRef(false)
     const dragEndTimeout = useRef<number | null>(null)
@@ -84,26 +117,43 @@ export function DashboardItems({ inSharedMode }: { inSharedMode: boolean }): JSX
             draggableCancel=".anticon,.ant-dropdown,table,.ant-popover-content"
         >
             {items.map((item: DashboardItemType, index: number) => (
-                <div key={item.id} className="dashboard-item-wrapper">
-                    <DashboardItem
-                        key={item.id}
-                        dashboardId={dashboard.id}
-                        item={item}
-                        layout={
-                            resizingItem?.i?.toString() === item.id.toString() ? resizingItem : layoutForItem[item.id]
-                        }
-                        loadDashboardItems={loadDashboardItems}
-                        duplicateDashboardItem={duplicateDashboardItem}
-                        moveDashboardItem={(it: DashboardItemType, dashboardId: number) =>
-                            duplicateDashboardItem(it, dashboardId, true)
-                        }
-                        updateItemColor={updateItemColor}
-                        isDraggingRef={isDragging}
-                        inSharedMode={inSharedMode}
-                        isOnEditMode={dashboardMode === DashboardMode.Edit}
-                        setEditMode={() => setDashboardMode(DashboardMode.Edit, DashboardEventSource.LongPress)}
-                        index={index}
-                    />
+                <div key={item.id} className="dashboard-item-wrapper" data-item-id={item.id} ref={observeItem}>
+                    {['queued', 'queuedCompute', 'fetching'].includes(itemLoadStates[item.id]) ? (
+                        <div className="dashboard-item white ph-no-capture" data-attr={'dashboard-item-' + index}>
+                            <div className="dashboard-item-container">
+                                <div className="dashboard-item-header">
+                                    <div className="dashboard-item-title">{item.name}</div>
+                                </div>
+                                <div className="dashboard-item-content">
+                                    <Skeleton active />
+                                </div>
+                            </div>
+                        </div>
+                    ) : (
+                        <DashboardItem
+                            key={item.id}
+                            dashboardId={dashboard.id}
+                            item={item}
+                            layout={
+                                resizingItem?.i?.toString() === item.id.toString()
+                                    ? resizingItem
+                                    : layoutForItem[item.id]
+                            }
+                            loadDashboardItems={loadDashboardItems}
+                            duplicateDashboardItem={duplicateDashboardItem}
+                            moveDashboardItem={(it: DashboardItemType, dashboardId: number) =>
+                                duplicateDashboardItem(it, dashboardId, true)
+                            }
+                            updateItemColor={updateItemColor}
+                            isDraggingRef={isDragging}
+                            inSharedMode={inSharedMode}
+                            isOnEditMode={dashboardMode === DashboardMode.Edit}
+                            setEditMode={() => setDashboardMode(DashboardMode.Edit, DashboardEventSource.LongPress)}
+                            index={index}
+                            shouldRefresh={itemLoadStates[item.id] === 'refreshing'}
+                            onLoadComplete={() => itemLoadComplete(item.id)}
+                        />
+                    )}
                 </div>
             ))}
         </ReactGridLayout>
@@ -13,6 +13,47 @@ import { DashboardEventSource, eventUsageLogic } from 'lib/utils/eventUsageLogic
 import { Button } from 'antd'
 import { DashboardMode } from '../../types'
 
+// Tiles are loaded a few at a time, the ones in the viewport first, so big dashboards don't flood the API on open
+const MAX_CONCURRENT_ITEM_LOADS = 4
+
+// Load states of a tile: waiting in the queue (for its cached result, to compute its result as it has none yet, or to
+// refresh its rendered result), loading, or done
+const QUEUED_STATES = ['queued', 'queuedCompute', 'queuedRefresh']
+const IN_FLIGHT_STATES = ['fetching', 'rendering', 'refreshing']
+const RENDERED_STATES = ['rendering', 'refreshing', 'queuedRefresh', 'loaded']
+const STARTED_STATES = { queued: 'fetching', queuedCompute: 'rendering', queuedRefresh: 'refreshing' }
+
+function runQueue(values, actions) {
+    const itemLoadQueue = values.itemLoadQueue.slice(0, MAX_CONCURRENT_ITEM_LOADS - values.itemLoadsInFlight)
+    for (const id of itemLoadQueue) {
+        actions.startItemLoad(id, values.itemLoadStates[id])
+    }
+}
+
+// Reports the load of the dashboard once all its tiles are painted, see `startLoadTiming`
+function trackItemLoaded(values, cache) {
+    const timing = cache.loadTiming
+    if (!timing) {
+        return
+    }
+    const now = performance.now()
+    timing.firstItemAt = timing.firstItemAt || now
+    if (values.items.every((item) => values.itemLoadStates[item.id] === 'loaded')) {
+        eventUsageLogic.actions.reportDashboardLoaded(values.allItems, {
+            duration: now - timing.startedAt,
+            firstItemDuration: timing.firstItemAt - timing.startedAt,
+            itemCount: values.items.length,
+            cachedItemCount: timing.cachedItemCount,
+            refresh: timing.refresh,
+        })
+        cache.loadTiming = null
+    }
+}
+
+function startLoadTiming(cache, refresh) {
+    cache.loadTiming = { startedAt: performance.now(), firstItemAt: null, cachedItemCount: 0, refresh }
+}
+
 export const dashboardLogic = kea({
     connect: [dashboardsModel, dashboardItemsModel, eventUsageLogic],
 
@@ -34,6 +75,11 @@ export const dashboardLogic = kea({
         addGraph: true, // takes the user to insights to add a graph
         deleteTag: (tag) => ({ tag }),
         saveNewTag: (tag) => ({ tag }),
+        queueItemLoads: (ids, refresh = false) => ({ ids, refresh }),
+        startItemLoad: (id, queuedState) => ({ id, queuedState }),
+        setItemResult: (id, result, lastRefresh) => ({ id, result, lastRefresh }),
+        itemLoadComplete: (id) => ({ id }),
+        setItemVisible: (id, visible) => ({ id, visible }),
     }),
 
     loaders: ({ actions, props }) => ({
@@ -42,8 +88,12 @@ export const dashboardLogic = kea({
             {
                 loadDashboardItems: async () => {
                     try {
+                        // results are loaded tile by tile, see `queueItemLoads`
                         const dashboard = await api.get(
-                            `api/dashboard/${props.id}/?${toParams({ share_token: props.shareToken })}`
+                            `api/dashboard/${props.id}/?${toParams({
+                                share_token: props.shareToken,
+                                include_results: false,
+                            })}`
                         )
                         actions.setDates(dashboard.filters.date_from, dashboard.filters.date_to, false)
                         eventUsageLogic.actions.reportDashboardViewed(dashboard, !!props.shareToken)
@@ -57,7 +107,10 @@ export const dashboardLogic = kea({
                 },
                 updateDashboard: async (filters) => {
                     return await api.update(
-                        `api/dashboard/${props.id}/?${toParams({ share_token: props.shareToken })}`,
+                        `api/dashboard/${props.id}/?${toParams({
+                            share_token: props.shareToken,
+                            include_results: false,
+                        })}`,
                         { filters }
                     )
                 },
@@ -98,10 +151,43 @@ export const dashboardLogic = kea({
             updateItemColor: (state, { id, color }) => {
                 return { ...state, items: state.items.map((i) => (i.id === id ? { ...i, color } : i)) }
             },
+            setItemResult: (state, { id, result, lastRefresh }) => {
+                return {
+                    ...state,
+                    items: state.items.map((i) => (i.id === id ? { ...i, result, last_refresh: lastRefresh } : i)),
+                }
+            },
             [dashboardItemsModel.actions.duplicateDashboardItemSuccess]: (state, { item }) => {
                 return { ...state, items: item.dashboard === parseInt(props.id) ? [...state.items, item] : state.items }
             },
         },
+        itemLoadStates: [
+            {},
+            {
+                queueItemLoads: (state, { ids, refresh }) => {
+                    const newState = { ...state }
+                    for (const id of ids) {
+                        if (RENDERED_STATES.includes(state[id])) {
+                            if (refresh) {
+                                newState[id] = 'queuedRefresh'
+                            }
+                        } else {
+                            newState[id] = refresh ? 'queuedCompute' : 'queued'
+                        }
+                    }
+                    return newState
+                },
+                startItemLoad: (state, { id, queuedState }) => ({ ...state, [id]: STARTED_STATES[queuedState] }),
+                setItemResult: (state, { id }) => ({ ...state, [id]: 'rendering' }),
+                itemLoadComplete: (state, { id }) => ({ ...state, [id]: 'loaded' }),
+            },
+        ],
+        visibleItems: [
+            {},
+            {
+                setItemVisible: (state, { id, visible }) => ({ ...state, [id]: visible }),
+            },
+        ],
         columns: [
             null,
             {
@@ -240,6 +326,24 @@ export const dashboardLogic = kea({
             },
         ],
         layout: [(s) => [s.layouts, s.sizeKey], (layouts, sizeKey) => layouts[sizeKey]],
+        itemLoadQueue: [
+            // Queued tiles, the visible ones first, then top to bottom and left to right
+            (s) => [s.itemLoadStates, s.visibleItems, s.layoutForItem],
+            (itemLoadStates, visibleItems, layoutForItem) => {
+                const hidden = (id) => (visibleItems[id] ? 0 : 1)
+                const y = (id) => layoutForItem[id]?.y ?? 0
+                const x = (id) => layoutForItem[id]?.x ?? 0
+                return Object.keys(itemLoadStates)
+                    .filter((id) => QUEUED_STATES.includes(itemLoadStates[id]))
+                    .map((id) => parseInt(id))
+                    .sort((a, b) => hidden(a) - hidden(b) || y(a) - y(b) || x(a) - x(b) || a - b)
+            },
+        ],
+        itemLoadsInFlight: [
+            (s) => [s.itemLoadStates],
+            (itemLoadStates) =>
+                Object.values(itemLoadStates).filter((state) => IN_FLIGHT_STATES.includes(state)).length,
+        ],
         layoutForItem: [
             (s) => [s.layout],
             (layout) => {
@@ -268,7 +372,7 @@ export const dashboardLogic = kea({
             }
         },
     }),
-    listeners: ({ actions, values, key, cache }) => ({
+    listeners: ({ actions, values, key, cache, props }) => ({
         addNewDashboard: async () => {
             prompt({ key: `new-dashboard-${key}` }).actions.prompt({
                 title: 'New dashboard',
@@ -307,9 +411,44 @@ export const dashboardLogic = kea({
         updateItemColor: ({ id, color }) => {
             api.update(`api/insight/${id}`, { color })
         },
+        loadDashboardItems: () => startLoadTiming(cache, false),
+        loadDashboardItemsSuccess: () => {
+            const newItems = values.items.filter((item) => !values.itemLoadStates[item.id])
+            if (!newItems.length) {
+                // nothing new to load, e.g. the dashboard was reloaded after an update
+                cache.loadTiming = null
+            }
+            actions.queueItemLoads(newItems.map((item) => item.id))
+        },
+        queueItemLoads: () => runQueue(values, actions),
+        itemLoadComplete: () => {
+            runQueue(values, actions)
+            trackItemLoaded(values, cache)
+        },
+        setItemResult: ({ result }) => {
+            if (result && cache.loadTiming) {
+                cache.loadTiming.cachedItemCount += 1
+            }
+        },
+        startItemLoad: async ({ id, queuedState }) => {
+            if (queuedState !== 'queued') {
+                // the tile computes or refreshes its result itself and reports back with `itemLoadComplete`
+                return
+            }
+            try {
+                const { result, last_refresh } = await api.get(
+                    `api/dashboard/${props.id}/items/${id}/result/?${toParams({ share_token: props.shareToken })}`
+                )
+                actions.setItemResult(id, result, last_refresh)
+            } catch (error) {
+                // the tile will compute its result itself
+                actions.setItemResult(id, null, null)
+            }
+        },
         refreshAllDashboardItems: async (_, breakpoint) => {
             await breakpoint(100)
-            dashboardItemsModel.actions.refreshAllDashboardItems({})
+            startLoadTiming(cache, true)
+            actions.queueItemLoads(values.items.map((item) => item.id), true)
 
             eventUsageLogic.actions.reportDashboardRefreshed(values.lastRefreshed)
         },
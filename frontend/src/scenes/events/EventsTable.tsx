@@ -1,4 +1,4 @@
-import React from 'react'
+import React, { useEffect, useRef } from 'react'
 import { useActions, useValues } from 'kea'
 import dayjs from 'dayjs'
 import { PropertyFilters } from 'lib/components/PropertyFilters/PropertyFilters'
@@ -44,10 +44,23 @@ export function EventsTable({ fixedFilters, filtersEnabled = true, pageKey }: Ev
         isLoading,
         hasNext,
         isLoadingNext,
+        hasPrevious,
+        isLoadingPrevious,
         newEvents,
         eventFilter,
     } = useValues(logic)
-    const { fetchNextEvents, prependNewEvents, setEventFilter } = useActions(logic)
+    const { fetchNextEvents, fetchPreviousEvents, prependNewEvents, setEventFilter } = useActions(logic)
+    const previousEventsRef = useRef<HTMLDivElement>(null)
+
+    useEffect(() => {
+        // Only a window of events is kept, fetch back the ones evicted above when scrolling up to them
+        if (!hasPrevious || isLoadingPrevious || !previousEventsRef.current) {
+            return
+        }
+        const observer = new IntersectionObserver(([entry]) => entry.isIntersecting && fetchPreviousEvents())
+        observer.observe(previousEventsRef.current)
+        return () => observer.disconnect()
+    }, [hasPrevious, isLoadingPrevious])
 
     const showLinkToPerson = !fixedFilters?.person_id
     const columns: ResizableColumnType<EventFormattedType>[] = [
@@ -243,6 +256,19 @@ export function EventsTable({ fixedFilters, filtersEnabled = true, pageKey }: Ev
                 </Col>
             </Row>
             <div>
+                {hasPrevious && (
+                    <div ref={previousEventsRef} style={{ margin: '1rem auto', textAlign: 'center' }}>
+                        <Button onClick={fetchPreviousEvents}>
+                            {isLoadingPrevious ? (
+                                <Spin />
+                            ) : orderBy === 'timestamp' ? (
+                                'Load earlier events'
+                            ) : (
+                                'Load newer events'
+                            )}
+                        </Button>
+                    </div>
+                )}
                 <ResizableTable
                     dataSource={eventsFormatted}
                     loading={isLoading}
@@ -1,20 +1,23 @@
 import React from 'react'
-import { useValues } from 'kea'
+import { useActions, useValues } from 'kea'
 import { VolumeTable, UsageDisabledWarning } from './EventsVolumeTable'
-import { Alert, Skeleton } from 'antd'
+import { Alert, Button, Skeleton } from 'antd'
 import { preflightLogic } from 'scenes/PreflightCheck/logic'
 import { propertyDefinitionsLogic } from './propertyDefinitionsLogic'
 
 export function PropertiesVolumeTable(): JSX.Element | null {
     const { preflight } = useValues(preflightLogic)
-    const { propertyDefinitions, loaded } = useValues(propertyDefinitionsLogic)
+    const { propertyDefinitions, loaded, hasMorePropertyDefinitions, propertyStorageLoading } = useValues(
+        propertyDefinitionsLogic
+    )
+    const { loadPropertyDefinitions } = useActions(propertyDefinitionsLogic)
 
     return loaded ? (
         <>
             {preflight && !preflight?.is_event_property_usage_enabled ? (
                 <UsageDisabledWarning tab="Properties Stats" />
             ) : (
-                propertyDefinitions[0].volume_30_day === null && (
+                propertyDefinitions[0]?.volume_30_day === null && (
                     <>
                         <Alert
                             type="warning"
@@ -24,6 +27,13 @@ export function PropertiesVolumeTable(): JSX.Element | null {
                 )
             )}
             <VolumeTable data={propertyDefinitions} type="property" />
+            {hasMorePropertyDefinitions && (
+                <div className="text-center mt">
+                    <Button onClick={() => loadPropertyDefinitions()} loading={propertyStorageLoading}>
+                        Load more properties
+                    </Button>
+                </div>
+            )}
         </>
     ) : (
         <Skeleton active paragraph={{ rows: 5 }} />
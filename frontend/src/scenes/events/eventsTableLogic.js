@@ -5,6 +5,29 @@ import api from 'lib/api'
 import dayjs from 'dayjs'
 
 const POLL_TIMEOUT = 5000
+// Events kept in memory (and so in the DOM) at once. Once exceeded, the events furthest from where rows were just
+// added are evicted and fetched again by cursor when the user scrolls back to them.
+export const EVENTS_WINDOW_SIZE = 300
+
+const eventTimestamp = (item) => item.timestamp || item.event.timestamp
+
+const appendToWindow = (window, events) => {
+    const all = [...window.events, ...events]
+    return {
+        events: all.slice(-EVENTS_WINDOW_SIZE),
+        evictedBefore: window.evictedBefore || all.length > EVENTS_WINDOW_SIZE,
+        evictedAfter: false, // events after were just fetched
+    }
+}
+
+const prependToWindow = (window, events) => {
+    const all = [...events, ...window.events]
+    return {
+        events: all.slice(0, EVENTS_WINDOW_SIZE),
+        evictedBefore: window.evictedBefore,
+        evictedAfter: window.evictedAfter || all.length > EVENTS_WINDOW_SIZE,
+    }
+}
 
 const formatEvents = (events, newEvents, apiUrl) => {
     let eventsFormatted = []
@@ -50,6 +73,8 @@ export const eventsTableLogic = kea({
         fetchEvents: (nextParams = null) => ({ nextParams }),
         fetchEventsSuccess: (events, hasNext = false, isNext = false) => ({ events, hasNext, isNext }),
         fetchNextEvents: true,
+        fetchPreviousEvents: true,
+        fetchPreviousEventsSuccess: (events, hasPrevious) => ({ events, hasPrevious }),
         fetchOrPollFailure: (error) => ({ error }),
         flipSort: true,
         pollEvents: true,
@@ -93,15 +118,28 @@ export const eventsTableLogic = kea({
                 fetchEventsSuccess: () => false,
             },
         ],
-        events: [
-            [],
+        isLoadingPrevious: [
+            false,
             {
-                fetchEventsSuccess: (state, { events, isNext }) => (isNext ? [...state, ...events] : events),
-                prependNewEvents: (state, { events }) => [...events, ...state],
+                fetchPreviousEvents: () => true,
+                fetchPreviousEventsSuccess: () => false,
+                fetchOrPollFailure: () => false,
             },
         ],
-
-        hasNext: [
+        // The events in memory, and whether events before (above) or after (below) them were evicted
+        eventsWindow: [
+            { events: [], evictedBefore: false, evictedAfter: false },
+            {
+                fetchEventsSuccess: (state, { events, isNext }) =>
+                    isNext ? appendToWindow(state, events) : { events, evictedBefore: false, evictedAfter: false },
+                fetchPreviousEventsSuccess: (state, { events, hasPrevious }) => ({
+                    ...prependToWindow(state, events),
+                    evictedBefore: hasPrevious,
+                }),
+                prependNewEvents: (state, { events }) => prependToWindow(state, events),
+            },
+        ],
+        hasNextPage: [
             false,
             {
                 fetchEvents: () => false,
@@ -155,6 +193,12 @@ export const eventsTableLogic = kea({
                 }
             },
         ],
+        events: [() => [selectors.eventsWindow], (eventsWindow) => eventsWindow.events],
+        hasNext: [
+            () => [selectors.hasNextPage, selectors.eventsWindow],
+            (hasNextPage, eventsWindow) => !!hasNextPage || eventsWindow.evictedAfter,
+        ],
+        hasPrevious: [() => [selectors.eventsWindow], (eventsWindow) => eventsWindow.evictedBefore],
         eventsFormatted: [
             () => [selectors.events, selectors.newEvents],
             (events, newEvents) => formatEvents(events, newEvents, props.apiUrl),
@@ -201,9 +245,34 @@ export const eventsTableLogic = kea({
             const { events, orderBy } = values
 
             actions.fetchEvents({
-                [orderBy === 'timestamp' ? 'after' : 'before']: events[events.length - 1].timestamp,
+                [orderBy === 'timestamp' ? 'after' : 'before']: eventTimestamp(events[events.length - 1]),
             })
         },
+        fetchPreviousEvents: async (_, breakpoint) => {
+            // Events just before the first one in memory: fetched in the opposite order and flipped
+            const { events, orderBy } = values
+            if (events.length === 0) {
+                return
+            }
+            const urlParams = toParams({
+                properties: values.properties,
+                ...(props.fixedFilters || {}),
+                ...(values.eventFilter ? { event: values.eventFilter } : {}),
+                [orderBy === 'timestamp' ? 'before' : 'after']: eventTimestamp(events[0]),
+                orderBy: [orderBy === 'timestamp' ? '-timestamp' : 'timestamp'],
+            })
+
+            let response = null
+            try {
+                response = await api.get(`${props.apiUrl || 'api/event/'}?${urlParams}`)
+            } catch (error) {
+                actions.fetchOrPollFailure(error)
+                return
+            }
+
+            breakpoint()
+            actions.fetchPreviousEventsSuccess([...response.results].reverse(), !!response.next)
+        },
         fetchEvents: [
             async (_, breakpoint) => {
                 if (values.events.length > 0) {
@@ -244,6 +313,11 @@ export const eventsTableLogic = kea({
             if (values.orderBy !== '-timestamp') {
                 return
             }
+            // The latest events were evicted while scrolling down, they come back when scrolling up
+            if (values.hasPrevious) {
+                actions.setPollTimeout(setTimeout(actions.pollEvents, POLL_TIMEOUT))
+                return
+            }
 
             let params = {
                 properties: values.properties,
@@ -255,7 +329,7 @@ export const eventsTableLogic = kea({
             const event = values.events[0]
 
             if (event) {
-                params.after = event.timestamp || event.event.timestamp
+                params.after = eventTimestamp(event)
             }
 
             let events = null
@@ -13,21 +13,34 @@ interface PropertyDefinitionStorage {
     results: PropertyDefinition[]
 }
 
+interface PropertySearchResults {
+    search: string
+    results: PropertyDefinition[]
+}
+
+// Teams can have tens of thousands of properties: only the most used ones are loaded upfront, the rest are searched
+// for on the server (ranked by prefix match and usage) as the user types.
+const PAGE_SIZE = 100
+
+function searchUrl(search: string, params = ''): string {
+    const query = `search=${encodeURIComponent(search)}&limit=${PAGE_SIZE}${params}`
+    return `api/projects/@current/property_definitions/?${query}`
+}
+
 export const propertyDefinitionsLogic = kea<
-    propertyDefinitionsLogicType<PropertyDefinitionStorage, PropertyDefinition, PropertySelectOption>
+    propertyDefinitionsLogicType<
+        PropertyDefinitionStorage,
+        PropertyDefinition,
+        PropertySelectOption,
+        PropertySearchResults
+    >
 >({
     loaders: ({ values }) => ({
         propertyStorage: [
             { results: [], next: null, count: 0 } as PropertyDefinitionStorage,
             {
-                loadPropertyDefinitions: async (initial?: boolean) => {
-                    const url = initial
-                        ? 'api/projects/@current/property_definitions/?limit=5000'
-                        : values.propertyStorage.next
-                    if (!url) {
-                        throw new Error('Incorrect call to propertyDefinitionsLogic.loadPropertyDefinitions')
-                    }
-                    const propertyStorage = await api.get(url)
+                loadPropertyDefinitions: async () => {
+                    const propertyStorage = await api.get(values.propertyStorage.next || searchUrl(''))
                     return {
                         count: propertyStorage.count,
                         results: [...values.propertyStorage.results, ...propertyStorage.results],
@@ -36,28 +49,66 @@ export const propertyDefinitionsLogic = kea<
                 },
             },
         ],
+        numericalPropertyStorage: [
+            [] as PropertyDefinition[],
+            {
+                loadNumericalPropertyDefinitions: async () =>
+                    (await api.get(searchUrl('', '&is_numerical=true'))).results,
+            },
+        ],
+        searchResults: [
+            { search: '', results: [] } as PropertySearchResults,
+            {
+                searchPropertyDefinitions: async (search: string, breakpoint) => {
+                    if (values.searchCache[search]) {
+                        return { search, results: values.searchCache[search] }
+                    }
+                    await breakpoint(200)
+                    const { results } = await api.get(searchUrl(search))
+                    breakpoint()
+                    return { search, results }
+                },
+            },
+        ],
     }),
-    listeners: ({ actions }) => ({
-        loadPropertyDefinitionsSuccess: ({ propertyStorage }) => {
-            if (propertyStorage.next) {
-                actions.loadPropertyDefinitions()
-            }
-        },
-    }),
+    reducers: {
+        loaded: [
+            // Whether the most used property definitions are loaded
+            false,
+            {
+                loadPropertyDefinitionsSuccess: () => true,
+                loadPropertyDefinitionsFailure: () => true,
+            },
+        ],
+        searchCache: [
+            {} as Record<string, PropertyDefinition[]>,
+            {
+                searchPropertyDefinitionsSuccess: (state, { searchResults }) => ({
+                    ...state,
+                    [searchResults.search]: searchResults.results,
+                }),
+            },
+        ],
+    },
     events: ({ actions }) => ({
         afterMount: () => {
-            actions.loadPropertyDefinitions(true)
+            actions.loadPropertyDefinitions()
+            actions.loadNumericalPropertyDefinitions()
         },
     }),
     selectors: {
-        loaded: [
-            // Whether *all* the property definitions are fully loaded
-            (s) => [s.propertyStorage, s.propertyStorageLoading],
-            (propertyStorage, propertyStorageLoading): boolean => !propertyStorageLoading && !propertyStorage.next,
-        ],
+        hasMorePropertyDefinitions: [(s) => [s.propertyStorage], (propertyStorage): boolean => !!propertyStorage.next],
         propertyDefinitions: [
-            (s) => [s.propertyStorage],
-            (propertyStorage): PropertyDefinition[] => propertyStorage.results || [],
+            // Every definition fetched so far, the most used first
+            (s) => [s.propertyStorage, s.numericalPropertyStorage, s.searchCache],
+            (propertyStorage, numericalPropertyStorage, searchCache): PropertyDefinition[] => {
+                const seen = new Set<string>()
+                return [
+                    ...(propertyStorage.results || []),
+                    ...numericalPropertyStorage,
+                    ...Object.values(searchCache).flat(),
+                ].filter((definition) => !seen.has(definition.name) && !!seen.add(definition.name))
+            },
         ],
         transformedPropertyDefinitions: [
             // Transformed propertyDefinitions to use in `Select` components
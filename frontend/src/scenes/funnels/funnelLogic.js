@@ -1,5 +1,6 @@
 import { kea } from 'kea'
 import api from 'lib/api'
+import { getInsight } from 'lib/utils/insightCache'
 import { ViewType, insightLogic } from 'scenes/insights/insightLogic'
 import { autocorrectInterval, objectsEqual, toParams } from 'lib/utils'
 import { insightHistoryLogic } from 'scenes/insights/InsightHistoryPanel/insightHistoryLogic'
@@ -15,12 +16,12 @@ function wait(ms = 1000) {
 const SECONDS_TO_POLL = 3 * 60
 
 async function pollFunnel(params = {}) {
-    let result = await api.get('api/insight/funnel/?' + toParams(params))
-    let start = window.performance.now()
+    const start = window.performance.now()
+    let result = await getInsight('api/insight/funnel/?' + toParams(params), start)
     while (result.result.loading && (window.performance.now() - start) / 1000 < SECONDS_TO_POLL) {
         await wait()
         const { refresh: _, ...restParams } = params // eslint-disable-line
-        result = await api.get('api/insight/funnel/?' + toParams(restParams))
+        result = await getInsight('api/insight/funnel/?' + toParams(restParams), start)
     }
     // if endpoint is still loading after 3 minutes just return default
     if (result.loading) {
@@ -97,7 +98,7 @@ export const funnelLogic = kea({
                     return []
                 }
                 breakpoint()
-                insightLogic.actions.endQuery(ViewType.FUNNELS, result.last_refresh)
+                insightLogic.actions.endQuery(ViewType.FUNNELS, result.last_refresh, undefined, result)
                 actions.setSteps(result.result)
                 return result.result
             },
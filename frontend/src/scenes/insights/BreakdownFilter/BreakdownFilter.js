@@ -1,6 +1,6 @@
 import React, { useState } from 'react'
 import { Tooltip, Select, Tabs, Popover, Button } from 'antd'
-import { useValues } from 'kea'
+import { useActions, useValues } from 'kea'
 import { propertyFilterLogic } from 'lib/components/PropertyFilters/propertyFilterLogic'
 import { PropertyKeyInfo } from 'lib/components/PropertyKeyInfo'
 import { SelectGradientOverflow } from 'lib/components/SelectGradientOverflow'
@@ -12,6 +12,7 @@ const { TabPane } = Tabs
 
 function PropertyFilter({ breakdown, onChange }) {
     const { transformedPropertyDefinitions } = useValues(propertyDefinitionsLogic)
+    const { searchPropertyDefinitions } = useActions(propertyDefinitionsLogic)
     const { personProperties } = useValues(propertyFilterLogic({ pageKey: 'breakdown' }))
     return (
         <SelectGradientOverflow
@@ -21,6 +22,7 @@ function PropertyFilter({ breakdown, onChange }) {
             placeholder={'Break down by'}
             value={breakdown ? breakdown : undefined}
             onChange={(_, item) => onChange(item.value.replace(/event_|person_/gi, ''), item.type)}
+            onSearch={searchPropertyDefinitions}
             filterOption={(input, option) => option.value?.toLowerCase().indexOf(input.toLowerCase()) >= 0}
             data-attr="prop-breakdown-select"
         >
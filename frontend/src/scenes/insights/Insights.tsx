@@ -14,7 +14,7 @@ import { router } from 'kea-router'
 
 import { RetentionContainer } from 'scenes/retention/RetentionContainer'
 
-import { Paths } from 'scenes/paths/Paths'
+import { LazyPaths } from 'scenes/paths/LazyPaths'
 
 import { RetentionTab, SessionTab, TrendTab, PathTab, FunnelTab } from './InsightTabs'
 import { FunnelViz } from 'scenes/funnels/FunnelViz'
@@ -328,7 +328,7 @@ export function Insights(): JSX.Element {
                                                 [`${ViewType.SESSIONS}`]: <TrendInsight view={ViewType.SESSIONS} />,
                                                 [`${ViewType.FUNNELS}`]: <FunnelInsight />,
                                                 [`${ViewType.RETENTION}`]: <RetentionContainer />,
-                                                [`${ViewType.PATHS}`]: <Paths />,
+                                                [`${ViewType.PATHS}`]: <LazyPaths />,
                                             }[activeView]
                                         )}
                                     </div>
@@ -21,6 +21,59 @@ Chart.defaults.global.elements.line.tension = 0
 
 const noop = () => {}
 
+// Line charts plot at most two points (the lowest and the highest) per this many pixels of width
+const PIXELS_PER_BUCKET = 4
+
+/**
+ * Min-max decimation of long series: splits the series into buckets and keeps only the lowest and highest point of
+ * each, so peaks stay visible. Dropped points become `null` (drawn through with `spanGaps`), so indices still match
+ * the labels, the clicked days and the annotations.
+ */
+function decimate(data, buckets) {
+    if (buckets < 1 || data.length <= buckets * 2) {
+        return data
+    }
+    const bucketSize = data.length / buckets
+    const decimated = new Array(data.length).fill(null)
+    for (let bucket = 0; bucket < buckets; bucket++) {
+        const start = Math.floor(bucket * bucketSize)
+        const end = Math.min(data.length, Math.floor((bucket + 1) * bucketSize))
+        let min = start
+        let max = start
+        for (let i = start + 1; i < end; i++) {
+            if (data[i] < data[min]) {
+                min = i
+            }
+            if (data[i] > data[max]) {
+                max = i
+            }
+        }
+        decimated[min] = data[min]
+        decimated[max] = data[max]
+    }
+    decimated[0] = data[0]
+    decimated[data.length - 1] = data[data.length - 1]
+    return decimated
+}
+
+/** Updates the datasets of a chart in place: Chart.js keeps the elements of a dataset on the dataset object. */
+function updateDatasets(chartDatasets, datasets) {
+    datasets.forEach((dataset, index) => {
+        const chartDataset = chartDatasets[index]
+        if (!chartDataset) {
+            chartDatasets.push(dataset)
+            return
+        }
+        for (const key of Object.keys(chartDataset)) {
+            if (key !== '_meta') {
+                delete chartDataset[key]
+            }
+        }
+        Object.assign(chartDataset, dataset)
+    })
+    chartDatasets.splice(datasets.length)
+}
+
 export function LineGraph({
     datasets,
     visibilityMap = null,
@@ -139,11 +192,9 @@ export function LineGraph({
         const axisLineColor = color === 'white' ? '#ddd' : 'rgba(255,255,255,0.2)'
         const axisColor = color === 'white' ? '#999' : 'rgba(255,255,255,0.6)'
 
-        if (typeof myLineChart.current !== 'undefined') {
-            myLineChart.current.destroy()
-        }
         // if chart is line graph, make duplicate lines and overlay to show dotted lines
         const isLineGraph = type === 'line'
+        const buckets = Math.floor(chartRef.current.parentElement.clientWidth / PIXELS_PER_BUCKET)
         datasets = isLineGraph
             ? [
                   ...datasets.map((dataset, index) => {
@@ -154,7 +205,10 @@ export function LineGraph({
                       data.pop()
                       _labels.pop()
                       days.pop()
-                      datasetCopy.data = data
+                      datasetCopy.data = decimate(data, buckets)
+                      if (datasetCopy.data !== data) {
+                          datasetCopy.spanGaps = true
+                      }
                       datasetCopy.labels = _labels
                       datasetCopy.days = days
                       return processDataset(datasetCopy, index)
@@ -359,6 +413,17 @@ export function LineGraph({
             }
         }
 
+        if (myLineChart.current && myLineChart.current.config.type === type) {
+            // update the chart in place rather than building a new one
+            updateDatasets(myLineChart.current.data.datasets, datasets)
+            myLineChart.current.data.labels = labels
+            myLineChart.current.options = options
+            myLineChart.current.update()
+            return
+        }
+        if (typeof myLineChart.current !== 'undefined') {
+            myLineChart.current.destroy()
+        }
         myLineChart.current = new Chart(myChartRef, {
             type,
             data: { labels, datasets },
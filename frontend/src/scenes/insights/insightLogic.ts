@@ -9,6 +9,7 @@ import { trendsLogic } from '../trends/trendsLogic'
 import { funnelLogic } from 'scenes/funnels/funnelLogic'
 import { DashboardItemType, FilterType } from '~/types'
 import api from 'lib/api'
+import { getInsightRequestTiming } from 'lib/utils/insightCache'
 
 export enum ViewType {
     TRENDS = 'TRENDS',
@@ -52,10 +53,16 @@ export const insightLogic = kea<insightLogicType>({
         setCachedUrl: (type, url) => ({ type, url }),
         setAllFilters: (filters) => ({ filters }),
         startQuery: true,
-        endQuery: (view: string, lastRefresh: string | null, exception?: Record<string, any>) => ({
+        endQuery: (
+            view: string,
+            lastRefresh: string | null,
+            exception?: Record<string, any>,
+            response?: Record<string, any> // from `getInsight`, to report how long loading the insight took
+        ) => ({
             view,
             lastRefresh,
             exception,
+            response,
         }),
         setMaybeShowTimeoutMessage: (showTimeoutMessage: boolean) => ({ showTimeoutMessage }),
         setShowTimeoutMessage: (showTimeoutMessage: boolean) => ({ showTimeoutMessage }),
@@ -171,8 +178,25 @@ export const insightLogic = kea<insightLogicType>({
             )
             actions.setIsLoading(true)
         },
-        endQuery: ({ view, lastRefresh, exception }) => {
+        endQuery: ({ view, lastRefresh, exception, response }) => {
             clearTimeout(values.timeout || undefined)
+            const requestTiming = getInsightRequestTiming(response)
+            if (requestTiming && !exception) {
+                const { startedAt, ...timing } = requestTiming
+                const respondedAt = performance.now()
+                // the result is rendered right after `endQuery`, painted by the next frame
+                requestAnimationFrame(() =>
+                    requestAnimationFrame(() => {
+                        const paintedAt = performance.now()
+                        eventUsageLogic.actions.reportInsightLoaded(view, {
+                            ...timing,
+                            duration: paintedAt - startedAt,
+                            renderDuration: paintedAt - respondedAt,
+                            isCached: !!response?.is_cached,
+                        })
+                    })
+                )
+            }
             if (view === values.activeView) {
                 actions.setShowTimeoutMessage(values.maybeShowTimeoutMessage)
                 actions.setShowErrorMessage(values.maybeShowErrorMessage)
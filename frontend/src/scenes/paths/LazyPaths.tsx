@@ -0,0 +1,15 @@
+import React, { Suspense } from 'react'
+import { Loading } from 'lib/utils'
+
+// d3 and d3-sankey are only loaded once a paths graph is shown
+const Paths = React.lazy(() =>
+    import(/* webpackChunkName: 'paths' */ './Paths').then(({ Paths }) => ({ default: Paths }))
+)
+
+export function LazyPaths(props: Record<string, any>): JSX.Element {
+    return (
+        <Suspense fallback={<Loading />}>
+            <Paths {...props} />
+        </Suspense>
+    )
+}
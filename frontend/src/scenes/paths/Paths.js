@@ -8,6 +8,8 @@ import * as d3 from 'd3'
 import * as Sankey from 'd3-sankey'
 import { AUTOCAPTURE, PAGEVIEW, pathsLogic } from 'scenes/paths/pathsLogic'
 import { useWindowSize } from 'lib/hooks/useWindowSize'
+import { createWorker } from 'lib/utils/createWorker'
+import { hydratePathsLayout, isOtherPathsNode } from 'scenes/paths/pathsLayout'
 
 function rounded_rect(x, y, w, h, r, tl, tr, bl, br) {
     var retval
@@ -84,6 +86,10 @@ function NoData() {
     )
 }
 
+function LayoutError() {
+    return <div style={{ padding: '1rem' }}>Something went wrong while drawing these paths. Please try again.</div>
+}
+
 const DEFAULT_PATHS_ID = 'default_paths'
 
 export function Paths({ dashboardItemId = null, filters = null, color = 'white' }) {
@@ -93,10 +99,47 @@ export function Paths({ dashboardItemId = null, filters = null, color = 'white'
 
     const [modalVisible, setModalVisible] = useState(false)
     const [event, setEvent] = useState(null)
+    const [layout, setLayout] = useState(null)
+    const [layoutError, setLayoutError] = useState(false)
+
+    // the sankey layout is computed in a worker, see `pathsWorker`
+    const layoutWorker = useRef(null)
+    const layoutRequestId = useRef(0)
+    useEffect(() => {
+        const worker = createWorker('paths_worker')
+        worker.onmessage = ({ data }) => {
+            // skip layouts of paths or sizes that have changed since
+            if (data.id === layoutRequestId.current) {
+                setLayout(data.layout || null)
+                setLayoutError(!!data.error)
+            }
+        }
+        worker.onerror = () => {
+            setLayout(null)
+            setLayoutError(true)
+        }
+        layoutWorker.current = worker
+        return () => worker.terminate()
+    }, [])
+
+    useEffect(() => {
+        layoutRequestId.current += 1
+        setLayoutError(false)
+        if (!paths || paths.nodes.length === 0 || pathsLoading) {
+            setLayout(null)
+            return
+        }
+        layoutWorker.current.postMessage({
+            id: layoutRequestId.current,
+            paths: { nodes: paths.nodes, links: paths.links },
+            width: canvas.current.offsetWidth,
+            height: canvas.current.offsetHeight,
+        })
+    }, [paths, !pathsLoading, size])
 
     useEffect(() => {
         renderPaths()
-    }, [paths, !pathsLoading, size, color])
+    }, [layout, color])
 
     function renderPaths() {
         const elements = document
@@ -104,7 +147,7 @@ export function Paths({ dashboardItemId = null, filters = null, color = 'white'
             .querySelectorAll(`.paths svg`)
         elements.forEach((node) => node.parentNode.removeChild(node))
 
-        if (!paths || paths.nodes.length === 0) {
+        if (!layout) {
             return
         }
         let width = canvas.current.offsetWidth
@@ -117,17 +160,10 @@ export function Paths({ dashboardItemId = null, filters = null, color = 'white'
             .style('width', width)
             .style('height', height)
 
-        let sankey = new Sankey.sankey()
-            .nodeId((d) => d.name)
-            .nodeAlign(Sankey.sankeyLeft)
-            .nodeSort(null)
-            .nodeWidth(15)
-            .size([width, height])
-
-        const { nodes, links } = sankey({
-            nodes: paths.nodes.map((d) => ({ ...d })),
-            links: paths.links.map((d) => ({ ...d })),
-        })
+        // nodes and links of no value have no height, they are not drawn
+        const hydratedLayout = hydratePathsLayout(layout)
+        const nodes = hydratedLayout.nodes.filter((d) => d.value > 0)
+        const links = hydratedLayout.links.filter((d) => d.value > 0)
 
         svg.append('g')
             .selectAll('rect')
@@ -240,10 +276,9 @@ export function Paths({ dashboardItemId = null, filters = null, color = 'white'
             .attr('y', (d) => (d.y1 + d.y0) / 2)
             .attr('dy', '0.35em')
             .attr('text-anchor', (d) => (d.x0 < width / 2 ? 'start' : 'end'))
-            .attr('display', (d) => (d.value > 0 ? 'inherit' : 'none'))
             .text(loadedFilter?.path_type === PAGEVIEW ? pageUrl : pathText)
             .on('click', async (node) => {
-                if (loadedFilter.path_type === AUTOCAPTURE) {
+                if (loadedFilter.path_type === AUTOCAPTURE && !isOtherPathsNode(node)) {
                     setModalVisible(true)
                     setEvent(null)
                     let result = await api.get('api/event/' + node.id)
@@ -277,6 +312,7 @@ export function Paths({ dashboardItemId = null, filters = null, color = 'white'
                 {pathsLoading && <Loading />}
                 <div ref={canvas} className="paths" data-attr="paths-viz">
                     {!pathsLoading && paths && paths.nodes.length === 0 && !paths.error && <NoData />}
+                    {!pathsLoading && layoutError && <LayoutError />}
                 </div>
             </div>
             <Modal
@@ -0,0 +1,54 @@
+import * as Sankey from 'd3-sankey'
+
+// Node the server collapses the least visited nodes of a step into, see `collapse_paths` in `posthog/queries/paths.py`
+export const OTHER_PATHS_NODE = '(other)'
+
+export function isOtherPathsNode(node) {
+    return node.name.replace(/(^[0-9]+_)/, '') === OTHER_PATHS_NODE
+}
+
+/**
+ * Runs the d3-sankey layout of paths. Called from `pathsWorker`, so the result only holds plain data that can be
+ * posted back to the page: links point to their nodes by index and nodes to their links by index.
+ */
+export function layoutPaths({ nodes, links }, width, height) {
+    const sankey = new Sankey.sankey()
+        .nodeId((d) => d.name)
+        .nodeAlign(Sankey.sankeyLeft)
+        .nodeSort(null)
+        .nodeWidth(15)
+        .size([width, height])
+
+    const graph = sankey({
+        nodes: nodes.map((d) => ({ ...d })),
+        links: links.map((d) => ({ ...d })),
+    })
+
+    return {
+        nodes: graph.nodes.map(({ sourceLinks, targetLinks, ...node }) => ({
+            ...node,
+            sourceLinks: sourceLinks.map((link) => link.index),
+            targetLinks: targetLinks.map((link) => link.index),
+        })),
+        links: graph.links.map(({ source, target, ...link }) => ({
+            ...link,
+            source: source.index,
+            target: target.index,
+        })),
+    }
+}
+
+/** Turns the indices of a `layoutPaths` result back into references, as d3 rendering expects them. */
+export function hydratePathsLayout({ nodes, links }) {
+    const hydratedNodes = nodes.map((node) => ({ ...node }))
+    const hydratedLinks = links.map((link) => ({
+        ...link,
+        source: hydratedNodes[link.source],
+        target: hydratedNodes[link.target],
+    }))
+    for (const node of hydratedNodes) {
+        node.sourceLinks = node.sourceLinks.map((index) => hydratedLinks[index])
+        node.targetLinks = node.targetLinks.map((index) => hydratedLinks[index])
+    }
+    return { nodes: hydratedNodes, links: hydratedLinks }
+}
@@ -1,6 +1,6 @@
 import { kea } from 'kea'
 import { toParams, objectsEqual } from 'lib/utils'
-import api from 'lib/api'
+import { getInsight } from 'lib/utils/insightCache'
 import { router } from 'kea-router'
 import { ViewType, insightLogic } from 'scenes/insights/insightLogic'
 import { insightHistoryLogic } from 'scenes/insights/InsightHistoryPanel/insightHistoryLogic'
@@ -73,13 +73,13 @@ export const pathsLogic = kea<pathsLogicType<PathResult, PropertyFilter, FilterT
                 let paths
                 insightLogic.actions.startQuery()
                 try {
-                    paths = await api.get(`api/insight/path${params ? `/?${params}` : ''}`)
+                    paths = await getInsight(`api/insight/path${params ? `/?${params}` : ''}`)
                 } catch (e) {
                     insightLogic.actions.endQuery(ViewType.PATHS, null, e)
                     return { paths: [], filter, error: true }
                 }
                 breakpoint()
-                insightLogic.actions.endQuery(ViewType.PATHS, paths.last_refresh)
+                insightLogic.actions.endQuery(ViewType.PATHS, paths.last_refresh, undefined, paths)
                 return { paths: paths.result, filter }
             },
         },
@@ -0,0 +1,15 @@
+/*
+ * Web Worker laying out the paths sankey, so paths with many nodes don't block the page. Built as its own bundle
+ * (see `webpack.config.js`), started by `Paths`.
+ *
+ * Receives `{ id, paths, width, height }` and posts back `{ id, layout }` or `{ id, error }`.
+ */
+import { layoutPaths } from './pathsLayout'
+
+self.onmessage = ({ data: { id, paths, width, height } }) => {
+    try {
+        self.postMessage({ id, layout: layoutPaths(paths, width, height) })
+    } catch (error) {
+        self.postMessage({ id, error: error.message || String(error) })
+    }
+}
@@ -89,7 +89,13 @@ export function Cohorts(): JSX.Element {
             ),
             render: function RenderCalculation(_: any, cohort: CohortType) {
                 if (cohort.is_static) {
-                    return <>N/A</>
+                    return cohort.is_calculating ? (
+                        <span>
+                            Copying {cohort.static_synced_count || 0} people <Spin />
+                        </span>
+                    ) : (
+                        <>N/A</>
+                    )
                 }
                 return cohort.is_calculating ? (
                     <span>
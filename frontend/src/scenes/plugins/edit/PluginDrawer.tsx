@@ -1,7 +1,7 @@
-import React, { useEffect } from 'react'
+import React, { Suspense, useEffect } from 'react'
 import { useActions, useValues } from 'kea'
 import { pluginsLogic } from 'scenes/plugins/pluginsLogic'
-import { Button, Form, Popconfirm, Space, Switch, Tooltip } from 'antd'
+import { Button, Form, Popconfirm, Space, Spin, Switch, Tooltip } from 'antd'
 import { DeleteOutlined, CodeOutlined, LockFilled, GlobalOutlined, RollbackOutlined } from '@ant-design/icons'
 import { userLogic } from 'scenes/userLogic'
 import { PluginImage } from 'scenes/plugins/plugin/PluginImage'
@@ -10,7 +10,6 @@ import { LocalPluginTag } from 'scenes/plugins/plugin/LocalPluginTag'
 import { defaultConfigForPlugin, getConfigSchemaArray } from 'scenes/plugins/utils'
 import Markdown from 'react-markdown'
 import { SourcePluginTag } from 'scenes/plugins/plugin/SourcePluginTag'
-import { PluginSource } from './PluginSource'
 import { PluginConfigChoice, PluginConfigSchema } from '@posthog/plugin-scaffold'
 import { PluginField } from 'scenes/plugins/edit/PluginField'
 import { endWithPunctation } from 'lib/utils'
@@ -18,6 +17,13 @@ import { canGloballyManagePlugins, canInstallPlugins } from '../access'
 import { ExtraPluginButtons } from '../plugin/PluginCard'
 import { preflightLogic } from 'scenes/PreflightCheck/logic'
 
+// Monaco is only loaded once the source of a plugin is edited
+const PluginSource = React.lazy(() =>
+    import(/* webpackChunkName: 'pluginSource' */ './PluginSource').then(({ PluginSource }) => ({
+        default: PluginSource,
+    }))
+)
+
 function EnabledDisabledSwitch({
     value,
     onChange,
@@ -268,7 +274,11 @@ export function PluginDrawer(): JSX.Element {
                     ) : null}
                 </Form>
             </Drawer>
-            {editingPlugin?.plugin_type === 'source' ? <PluginSource /> : null}
+            {editingPlugin?.plugin_type === 'source' ? (
+                <Suspense fallback={<Spin />}>
+                    <PluginSource />
+                </Suspense>
+            ) : null}
         </>
     )
 }
@@ -1,6 +1,7 @@
 import { kea } from 'kea'
 import { router } from 'kea-router'
 import api from 'lib/api'
+import { getInsight } from 'lib/utils/insightCache'
 import { toParams, objectsEqual } from 'lib/utils'
 import { ViewType, insightLogic } from 'scenes/insights/insightLogic'
 import { insightHistoryLogic } from 'scenes/insights/InsightHistoryPanel/insightHistoryLogic'
@@ -73,13 +74,13 @@ export const retentionTableLogic = kea<
                 let res
                 const urlParams = toParams({ ...values.filters, ...(refresh ? { refresh: true } : {}) })
                 try {
-                    res = await api.get(`api/insight/retention/?${urlParams}`)
+                    res = await getInsight(`api/insight/retention/?${urlParams}`)
                 } catch (e) {
                     insightLogic.actions.endQuery(ViewType.RETENTION, null, e)
                     return []
                 }
                 breakpoint()
-                insightLogic.actions.endQuery(ViewType.RETENTION, res.last_refresh)
+                insightLogic.actions.endQuery(ViewType.RETENTION, res.last_refresh, undefined, res)
                 return res.result
             },
         },
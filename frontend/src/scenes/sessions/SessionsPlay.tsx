@@ -49,6 +49,7 @@ export function SessionsPlay(): JSX.Element {
         session,
         sessionPlayerData,
         sessionPlayerDataLoading,
+        recordingFullyLoaded,
         loadingNextRecording,
         sessionDate,
         addingTagShown,
@@ -147,6 +148,9 @@ export function SessionsPlay(): JSX.Element {
                                 <div className="mb-05">
                                     <FieldTimeOutlined /> {formatDuration(eventIndex.getDuration())} session on{' '}
                                     {sessionDate}
+                                    {!recordingFullyLoaded && (
+                                        <SyncOutlined spin style={{ marginLeft: 4 }} title="Loading the rest" />
+                                    )}
                                 </div>
                                 <div>
                                     <UserOutlined style={{ marginRight: 4 }} />
@@ -1,4 +1,4 @@
-import React from 'react'
+import React, { Suspense } from 'react'
 import { useValues, useActions } from 'kea'
 import { Button, Spin, Space, Tooltip } from 'antd'
 import { Link } from 'lib/components/Link'
@@ -16,7 +16,6 @@ import {
     PlaySquareOutlined,
 } from '@ant-design/icons'
 import { SessionsPlayerButton, sessionPlayerUrl } from './SessionsPlayerButton'
-import { SessionsPlay } from './SessionsPlay'
 import { commandPaletteLogic } from 'lib/components/CommandPalette/commandPaletteLogic'
 import { LinkButton } from 'lib/components/LinkButton'
 import { SessionsFilterBox } from 'scenes/sessions/filters/SessionsFilterBox'
@@ -36,6 +35,13 @@ interface SessionsTableProps {
     isPersonPage?: boolean
 }
 
+// rrweb and the player are only loaded once a recording is opened
+const SessionsPlay = React.lazy(() =>
+    import(/* webpackChunkName: 'sessionsPlay' */ './SessionsPlay').then(({ SessionsPlay }) => ({
+        default: SessionsPlay,
+    }))
+)
+
 function SessionPlayerDrawer({ isPersonPage = false }: { isPersonPage: boolean }): JSX.Element {
     const { closeSessionPlayer } = useActions(sessionsTableLogic)
     return (
@@ -44,7 +50,9 @@ function SessionPlayerDrawer({ isPersonPage = false }: { isPersonPage: boolean }
                 <a onClick={closeSessionPlayer}>
                     <ArrowLeftOutlined /> Back to {isPersonPage ? 'persons' : 'sessions'}
                 </a>
-                <SessionsPlay />
+                <Suspense fallback={<Spin />}>
+                    <SessionsPlay />
+                </Suspense>
             </>
         </Drawer>
     )
@@ -14,6 +14,7 @@ interface Props {
 
 export function EventPropertyFilter({ filter, selector }: Props): JSX.Element {
     const { transformedPropertyDefinitions } = useValues(propertyDefinitionsLogic)
+    const { searchPropertyDefinitions } = useActions(propertyDefinitionsLogic)
     const { updateFilter } = useActions(sessionsFiltersLogic)
 
     const property = filter.properties && filter.properties.length > 0 ? filter.properties[0] : null
@@ -32,6 +33,7 @@ export function EventPropertyFilter({ filter, selector }: Props): JSX.Element {
                         options: transformedPropertyDefinitions,
                     },
                 ]}
+                onSearch={searchPropertyDefinitions}
                 onChange={(_, key) => {
                     updateFilter(
                         {
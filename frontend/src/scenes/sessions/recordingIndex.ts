@@ -0,0 +1,39 @@
+import { findCurrent } from '@posthog/react-rrweb-player'
+import { PageChangeEvent, RecordingIndexData, RecordingMetadata } from './snapshotDecoder'
+
+export const EMPTY_RECORDING_INDEX: RecordingIndexData = {
+    baseTime: null,
+    endTime: null,
+    pageChangeEvents: [],
+    recordingMetadata: [],
+}
+
+/** Appends the index of a newly decoded window, windows arrive in order. */
+export function mergeRecordingIndex(index: RecordingIndexData, next: RecordingIndexData): RecordingIndexData {
+    return {
+        baseTime: index.baseTime ?? next.baseTime,
+        endTime: next.endTime ?? index.endTime,
+        pageChangeEvents: index.pageChangeEvents.concat(next.pageChangeEvents),
+        recordingMetadata: index.recordingMetadata.concat(next.recordingMetadata),
+    }
+}
+
+/** Same lookups as `EventIndex` of `@posthog/react-rrweb-player`, over the index built by the snapshot worker. */
+export class RecordingIndex {
+    data: RecordingIndexData
+
+    constructor(data: RecordingIndexData) {
+        this.data = data
+    }
+
+    getDuration = (): number =>
+        this.data.baseTime !== null && this.data.endTime !== null ? this.data.endTime - this.data.baseTime : 0
+
+    pageChangeEvents = (): PageChangeEvent[] => this.data.pageChangeEvents
+
+    getPageMetadata = (playerTime: number): [PageChangeEvent, number] =>
+        findCurrent(playerTime, this.data.pageChangeEvents)
+
+    getRecordingMetadata = (playerTime: number): [RecordingMetadata, number] =>
+        findCurrent(playerTime, this.data.recordingMetadata)
+}
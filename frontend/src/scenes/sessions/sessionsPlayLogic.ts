@@ -1,23 +1,29 @@
 import { kea } from 'kea'
 import { eventWithTime } from 'rrweb/typings/types'
-import api from 'lib/api'
 import { eventToName, toParams } from 'lib/utils'
 import { sessionsPlayLogicType } from './sessionsPlayLogicType'
 import { PersonType, SessionType } from '~/types'
 import dayjs from 'dayjs'
-import { EventIndex } from '@posthog/react-rrweb-player'
 import { sessionsTableLogic } from 'scenes/sessions/sessionsTableLogic'
 import { toast } from 'react-toastify'
+import { createWorker } from 'lib/utils/createWorker'
+import { RecordingIndexData, RecordingWindow, SnapshotWorkerMessage } from './snapshotDecoder'
+import { EMPTY_RECORDING_INDEX, mergeRecordingIndex, RecordingIndex } from './recordingIndex'
 
 type SessionRecordingId = string
 
 interface SessionPlayerData {
     snapshots: eventWithTime[]
     person: PersonType | null
-    start_time: string
+    start_time: string | null
 }
 
-export const sessionsPlayLogic = kea<sessionsPlayLogicType<SessionPlayerData, EventIndex, SessionType>>({
+// Stored snapshot rows per request, a row is either a single snapshot or a compressed chunk of up to 512kB
+const SNAPSHOTS_PAGE_SIZE = 10
+
+export const sessionsPlayLogic = kea<
+    sessionsPlayLogicType<SessionPlayerData, RecordingIndex, RecordingIndexData, RecordingWindow, SessionType>
+>({
     connect: {
         values: [sessionsTableLogic, ['sessions', 'pagination', 'orderedSessionRecordingIds', 'loadedSessionEvents']],
         actions: [
@@ -26,6 +32,9 @@ export const sessionsPlayLogic = kea<sessionsPlayLogicType<SessionPlayerData, Ev
         ],
     },
     actions: {
+        loadRecording: (sessionRecordingId: SessionRecordingId) => ({ sessionRecordingId }),
+        loadRecordingWindow: (recordingWindow: RecordingWindow) => ({ recordingWindow }),
+        loadRecordingFailure: (error: string) => ({ error }),
         toggleAddingTagShown: () => {},
         setAddingTag: (payload: string) => ({ payload }),
         goToNext: true,
@@ -36,13 +45,42 @@ export const sessionsPlayLogic = kea<sessionsPlayLogicType<SessionPlayerData, Ev
         sessionRecordingId: [
             null as SessionRecordingId | null,
             {
-                loadRecording: (_, sessionRecordingId) => sessionRecordingId,
+                loadRecording: (_, { sessionRecordingId }) => sessionRecordingId,
             },
         ],
         sessionPlayerData: [
             null as null | SessionPlayerData,
             {
                 loadRecording: () => null,
+                loadRecordingWindow: (state, { recordingWindow }) => ({
+                    snapshots: state ? state.snapshots.concat(recordingWindow.snapshots) : recordingWindow.snapshots,
+                    person: state ? state.person : recordingWindow.person,
+                    start_time: state ? state.start_time : recordingWindow.start_time,
+                }),
+            },
+        ],
+        sessionPlayerDataLoading: [
+            // Only until the first window is decoded, playback starts while the rest is loading
+            false,
+            {
+                loadRecording: () => true,
+                loadRecordingWindow: () => false,
+                loadRecordingFailure: () => false,
+            },
+        ],
+        recordingFullyLoaded: [
+            false,
+            {
+                loadRecording: () => false,
+                loadRecordingWindow: (_, { recordingWindow }) => recordingWindow.done,
+                loadRecordingFailure: () => true,
+            },
+        ],
+        recordingIndexData: [
+            EMPTY_RECORDING_INDEX as RecordingIndexData,
+            {
+                loadRecording: () => EMPTY_RECORDING_INDEX,
+                loadRecordingWindow: (state, { recordingWindow }) => mergeRecordingIndex(state, recordingWindow.index),
             },
         ],
         addingTagShown: [
@@ -66,7 +104,36 @@ export const sessionsPlayLogic = kea<sessionsPlayLogicType<SessionPlayerData, Ev
             },
         ],
     },
-    listeners: ({ values, actions }) => ({
+    listeners: ({ values, actions, cache }) => ({
+        loadRecording: ({ sessionRecordingId }) => {
+            cache.snapshotWorker?.terminate()
+            const worker = createWorker('snapshot_worker')
+            worker.onmessage = ({ data }: MessageEvent<SnapshotWorkerMessage>) => {
+                if (data.type === 'window') {
+                    actions.loadRecordingWindow(data.window)
+                } else {
+                    actions.loadRecordingFailure(data.error)
+                }
+            }
+            const params = toParams({
+                session_recording_id: sessionRecordingId,
+                save_view: true,
+                limit: SNAPSHOTS_PAGE_SIZE,
+            })
+            worker.postMessage({ url: new URL(`/api/event/session_recording?${params}`, window.location.href).href })
+            cache.snapshotWorker = worker
+        },
+        loadRecordingWindow: ({ recordingWindow }) => {
+            if (recordingWindow.done) {
+                cache.snapshotWorker?.terminate()
+                cache.snapshotWorker = null
+            }
+        },
+        loadRecordingFailure: ({ error }) => {
+            cache.snapshotWorker?.terminate()
+            cache.snapshotWorker = null
+            toast.error(`Could not load the recording: ${error}`)
+        },
         toggleAddingTagShown: () => {
             // Clear text when tag input is dismissed
             if (!values.addingTagShown) {
@@ -109,12 +176,10 @@ export const sessionsPlayLogic = kea<sessionsPlayLogicType<SessionPlayerData, Ev
                 },
             },
         ],
-        sessionPlayerData: {
-            loadRecording: async (sessionRecordingId: string): Promise<SessionPlayerData> => {
-                const params = toParams({ session_recording_id: sessionRecordingId, save_view: true })
-                const response = await api.get(`api/event/session_recording?${params}`)
-                return response.result
-            },
+    }),
+    events: ({ cache }) => ({
+        beforeUnmount: () => {
+            cache.snapshotWorker?.terminate()
         },
     }),
     selectors: {
@@ -128,8 +193,8 @@ export const sessionsPlayLogic = kea<sessionsPlayLogicType<SessionPlayerData, Ev
             },
         ],
         eventIndex: [
-            (selectors) => [selectors.sessionPlayerData],
-            (sessionPlayerData: SessionPlayerData): EventIndex => new EventIndex(sessionPlayerData?.snapshots || []),
+            (selectors) => [selectors.recordingIndexData],
+            (recordingIndexData: RecordingIndexData): RecordingIndex => new RecordingIndex(recordingIndexData),
         ],
         recordingIndex: [
             (selectors) => [selectors.orderedSessionRecordingIds, selectors.sessionRecordingId],
@@ -0,0 +1,131 @@
+import { gunzipSync } from 'fflate'
+import { eventWithTime } from 'rrweb/typings/types'
+import { PersonType } from '~/types'
+
+// rrweb event types, see `EventType` and `IncrementalSource` in rrweb
+const META_EVENT = 4
+const INCREMENTAL_SNAPSHOT_EVENT = 3
+const VIEWPORT_RESIZE_SOURCE = 4
+
+export interface CompressedSnapshotChunk {
+    chunk_id: string
+    chunk_index: number
+    chunk_count: number
+    data: string
+    compression: 'gzip-base64'
+    has_full_snapshot: boolean
+}
+
+export type StoredSnapshot = eventWithTime | CompressedSnapshotChunk
+
+export interface SnapshotPage {
+    snapshots: StoredSnapshot[]
+    person: PersonType | null
+    start_time: string | null
+    next: string | null
+}
+
+export interface PageChangeEvent {
+    playerTime: number
+    href: string
+}
+
+export interface RecordingMetadata {
+    playerTime: number
+    width: number
+    height: number
+    resolution: string
+}
+
+export interface RecordingIndexData {
+    baseTime: number | null
+    endTime: number | null
+    pageChangeEvents: PageChangeEvent[]
+    recordingMetadata: RecordingMetadata[]
+}
+
+export interface RecordingWindow {
+    snapshots: eventWithTime[]
+    index: RecordingIndexData
+    person: PersonType | null
+    start_time: string | null
+    done: boolean
+}
+
+export type SnapshotWorkerMessage = { type: 'window'; window: RecordingWindow } | { type: 'error'; error: string }
+
+function isChunk(snapshot: StoredSnapshot): snapshot is CompressedSnapshotChunk {
+    return 'chunk_id' in snapshot
+}
+
+/** Reverses `compress_to_string` of `posthog/helpers/session_recording.py`: base64, then gzip, then UTF-16 JSON. */
+export function decompressChunks(chunks: CompressedSnapshotChunk[]): eventWithTime[] {
+    const base64 = chunks
+        .sort((a, b) => a.chunk_index - b.chunk_index)
+        .map((chunk) => chunk.data)
+        .join('')
+    const binary = atob(base64)
+    const bytes = new Uint8Array(binary.length)
+    for (let i = 0; i < binary.length; i++) {
+        bytes[i] = binary.charCodeAt(i)
+    }
+    return JSON.parse(new TextDecoder('utf-16').decode(gunzipSync(bytes)))
+}
+
+/**
+ * Turns pages of stored snapshots into playable windows. Chunks of one compressed batch can be split across pages,
+ * incomplete batches are held back until the rest of their chunks arrive.
+ */
+export class SnapshotDecoder {
+    pendingChunks: Record<string, CompressedSnapshotChunk[]> = {}
+    baseTime: number | null = null
+
+    decode(stored: StoredSnapshot[]): eventWithTime[] {
+        const snapshots: eventWithTime[] = []
+        for (const snapshot of stored) {
+            if (!isChunk(snapshot)) {
+                snapshots.push(snapshot)
+                continue
+            }
+            const chunks = (this.pendingChunks[snapshot.chunk_id] = this.pendingChunks[snapshot.chunk_id] || [])
+            chunks.push(snapshot)
+            if (chunks.length === snapshot.chunk_count) {
+                delete this.pendingChunks[snapshot.chunk_id]
+                snapshots.push(...decompressChunks(chunks))
+            }
+        }
+        return snapshots.sort((a, b) => a.timestamp - b.timestamp)
+    }
+
+    index(snapshots: eventWithTime[]): RecordingIndexData {
+        if (this.baseTime === null && snapshots.length > 0) {
+            this.baseTime = snapshots[0].timestamp
+        }
+        const baseTime = this.baseTime || 0
+        const index: RecordingIndexData = {
+            baseTime: this.baseTime,
+            endTime: snapshots.length > 0 ? snapshots[snapshots.length - 1].timestamp : null,
+            pageChangeEvents: [],
+            recordingMetadata: [],
+        }
+        for (const snapshot of snapshots) {
+            const data = snapshot.data as Record<string, any>
+            const playerTime = snapshot.timestamp - baseTime
+            if (snapshot.type === META_EVENT) {
+                index.pageChangeEvents.push({ playerTime, href: data.href })
+            }
+            if (
+                snapshot.type === META_EVENT ||
+                (snapshot.type === INCREMENTAL_SNAPSHOT_EVENT && data.source === VIEWPORT_RESIZE_SOURCE)
+            ) {
+                index.recordingMetadata.push({
+                    playerTime,
+                    width: data.width,
+                    height: data.height,
+                    resolution: `${data.width} x ${data.height}`,
+                })
+            }
+        }
+        return index
+    }
+}
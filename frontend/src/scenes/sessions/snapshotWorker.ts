@@ -0,0 +1,51 @@
+/*
+ * Web Worker fetching, decompressing and indexing the snapshots of a session recording, so multi-hour recordings
+ * don't lock up the page. Built as its own bundle (see `webpack.config.js`), started by `sessionsPlayLogic`.
+ *
+ * Receives the absolute URL of the first page of `api/event/session_recording` and posts a `RecordingWindow` for
+ * every page, in order, so playback can start as soon as the first one is decoded.
+ */
+import { SnapshotDecoder, SnapshotPage, SnapshotWorkerMessage } from './snapshotDecoder'
+
+const ctx = (self as unknown) as Worker
+
+function post(message: SnapshotWorkerMessage): void {
+    ctx.postMessage(message)
+}
+
+/** The view of the recording is saved with its first page only. */
+function nextPageUrl(next: string, firstPageUrl: string): string {
+    const url = new URL(next, new URL(firstPageUrl).origin)
+    url.searchParams.delete('save_view')
+    return url.href
+}
+
+async function loadRecording(firstPageUrl: string): Promise<void> {
+    const decoder = new SnapshotDecoder()
+    let url: string | null = firstPageUrl
+
+    while (url) {
+        const response: Response = await fetch(url, { credentials: 'same-origin' })
+        if (!response.ok) {
+            throw new Error(`Loading the recording failed with status ${response.status}`)
+        }
+        const page: SnapshotPage = (await response.json()).result
+        const snapshots = decoder.decode(page.snapshots)
+        url = page.next ? nextPageUrl(page.next, firstPageUrl) : null
+
+        post({
+            type: 'window',
+            window: {
+                snapshots,
+                index: decoder.index(snapshots),
+                person: page.person,
+                start_time: page.start_time,
+                done: !url,
+            },
+        })
+    }
+}
+
+ctx.onmessage = ({ data }: MessageEvent<{ url: string }>) => {
+    loadRecording(data.url).catch((error) => post({ type: 'error', error: error.message || String(error) }))
+}
@@ -1,6 +1,7 @@
 import { kea } from 'kea'
 
 import api from 'lib/api'
+import { getInsight } from 'lib/utils/insightCache'
 import { autocorrectInterval, errorToast, objectsEqual, toParams as toAPIParams } from 'lib/utils'
 import { actionsModel } from '~/models/actionsModel'
 import { router } from 'kea-router'
@@ -54,6 +55,9 @@ interface PeopleParamType {
     lifecycle_type?: string
 }
 
+// Series shown on the graph by default, e.g. for breakdowns with hundreds of values. Others can be shown from the legend.
+export const VISIBLE_SERIES_LIMIT = 20
+
 function cleanFilters(filters: Partial<FilterType>): Record<string, any> {
     return {
         insight: ViewType.TRENDS,
@@ -166,13 +170,13 @@ export const trendsLogic = kea<
                 let response
                 try {
                     if (values.filters?.insight === ViewType.SESSIONS || values.filters?.session) {
-                        response = await api.get(
+                        response = await getInsight(
                             'api/insight/session/?' +
                                 (refresh ? 'refresh=true&' : '') +
                                 toAPIParams(filterClientSideParams(values.filters))
                         )
                     } else {
-                        response = await api.get(
+                        response = await getInsight(
                             'api/insight/trend/?' +
                                 (refresh ? 'refresh=true&' : '') +
                                 toAPIParams(filterClientSideParams(values.filters))
@@ -185,7 +189,12 @@ export const trendsLogic = kea<
                     return []
                 }
                 breakpoint()
-                insightLogic.actions.endQuery(values.filters.insight || ViewType.TRENDS, response.last_refresh)
+                insightLogic.actions.endQuery(
+                    values.filters.insight || ViewType.TRENDS,
+                    response.last_refresh,
+                    undefined,
+                    response
+                )
 
                 return response
             },
@@ -424,9 +433,10 @@ export const trendsLogic = kea<
                 people = await api.get(`api/action/people/?${filterParams}`)
             }
             breakpoint()
+            // `total_count` is exact when the endpoint pages with a cursor, otherwise it counts as pages load
             actions.setPeople(
                 people.results[0]?.people,
-                people.results[0]?.count,
+                people.results[0]?.total_count ?? people.results[0]?.count,
                 action,
                 label,
                 date_from,
@@ -443,7 +453,7 @@ export const trendsLogic = kea<
                 breakpoint()
                 actions.setPeople(
                     [...currPeople, ...people.results[0]?.people],
-                    count + people.results[0]?.count,
+                    people.results[0]?.total_count ?? count + people.results[0]?.count,
                     action,
                     label,
                     day,
@@ -466,18 +476,17 @@ export const trendsLogic = kea<
 
             let indexedResults
             if (values.filters.insight !== ViewType.LIFECYCLE) {
-                indexedResults = values.results.map((element, index) => {
-                    actions.setVisibilityById({ [`${index}`]: true })
-                    return { ...element, id: index }
-                })
+                indexedResults = values.results.map((element, index) => ({ ...element, id: index }))
             } else {
                 indexedResults = values.results
                     .filter((result) => values.toggledLifecycles.includes(String(result.status)))
-                    .map((result, idx) => {
-                        actions.setVisibilityById({ [`${idx}`]: true })
-                        return { ...result, id: idx }
-                    })
+                    .map((result, idx) => ({ ...result, id: idx }))
+            }
+            const visibility: Record<number, boolean> = {}
+            for (const { id } of indexedResults) {
+                visibility[id] = id < VISIBLE_SERIES_LIMIT
             }
+            actions.setVisibilityById(visibility)
             actions.setIndexedResults(indexedResults)
         },
         [dashboardItemsModel.actionTypes.refreshAllDashboardItems]: (filters: Record<string, any>) => {
@@ -1,14 +1,25 @@
-import React from 'react'
+import React, { Suspense } from 'react'
 import { ToolbarButton } from '~/toolbar/button/ToolbarButton'
 import Draggable from 'react-draggable'
 import { toolbarButtonLogic } from '~/toolbar/button/toolbarButtonLogic'
 import { useActions, useValues } from 'kea'
-import { HeatmapStats } from '~/toolbar/stats/HeatmapStats'
 import { Fire } from '~/toolbar/button/icons/Fire'
 import { Flag } from '~/toolbar/button/icons/Flag'
-import { ActionsTab } from '~/toolbar/actions/ActionsTab'
 import { ButtonWindow } from '~/toolbar/button/ButtonWindow'
 import { posthog } from '~/toolbar/posthog'
+import { Spin } from 'antd'
+
+// loaded when their window is first opened
+const HeatmapStats = React.lazy(() =>
+    import(/* webpackChunkName: 'toolbar_heatmap_stats' */ '~/toolbar/stats/HeatmapStats').then(({ HeatmapStats }) => ({
+        default: HeatmapStats,
+    }))
+)
+const ActionsTab = React.lazy(() =>
+    import(/* webpackChunkName: 'toolbar_actions' */ '~/toolbar/actions/ActionsTab').then(({ ActionsTab }) => ({
+        default: ActionsTab,
+    }))
+)
 
 export function DraggableButton(): JSX.Element {
     const { dragPosition, heatmapPosition, heatmapWindowVisible, actionsWindowVisible, actionsPosition } = useValues(
@@ -46,7 +57,9 @@ export function DraggableButton(): JSX.Element {
                 savePosition={saveHeatmapPosition}
             >
                 <div className="toolbar-block">
-                    <HeatmapStats />
+                    <Suspense fallback={<Spin />}>
+                        <HeatmapStats />
+                    </Suspense>
                 </div>
             </ButtonWindow>
 
@@ -59,7 +72,9 @@ export function DraggableButton(): JSX.Element {
                 position={actionsPosition}
                 savePosition={saveActionsPosition}
             >
-                <ActionsTab />
+                <Suspense fallback={<Spin />}>
+                    <ActionsTab />
+                </Suspense>
             </ButtonWindow>
         </>
     )
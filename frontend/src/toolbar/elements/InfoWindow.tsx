@@ -1,8 +1,15 @@
-import React from 'react'
+import React, { Suspense } from 'react'
 import { useActions, useValues } from 'kea'
 import { CloseOutlined } from '@ant-design/icons'
 import { elementsLogic } from '~/toolbar/elements/elementsLogic'
-import { ElementInfo } from '~/toolbar/elements/ElementInfo'
+import { Spin } from 'antd'
+
+// loaded when the first element is inspected
+const ElementInfo = React.lazy(() =>
+    import(/* webpackChunkName: 'toolbar_element_info' */ '~/toolbar/elements/ElementInfo').then(({ ElementInfo }) => ({
+        default: ElementInfo,
+    }))
+)
 
 export function InfoWindow(): JSX.Element | null {
     const { hoverElement, hoverElementMeta, selectedElement, selectedElementMeta } = useValues(elementsLogic)
@@ -100,7 +107,9 @@ export function InfoWindow(): JSX.Element | null {
                 </div>
             ) : null}
             <div style={{ minHeight, maxHeight, overflow: 'auto' }}>
-                <ElementInfo />
+                <Suspense fallback={<Spin />}>
+                    <ElementInfo />
+                </Suspense>
             </div>
         </div>
     )
@@ -1,33 +1,16 @@
-import 'react-toastify/dist/ReactToastify.css'
-import '~/toolbar/styles.scss'
-import '~/global.scss' /* Contains PostHog's main styling configurations */
-import '~/antd.less' /* Imports Ant Design's components */
-
-import React from 'react'
-import ReactDOM from 'react-dom'
-import Simmer from '@posthog/simmerjs'
-import { getContext } from 'kea'
-import { Provider } from 'react-redux'
-import { initKea } from '~/initKea'
-import { ToolbarApp } from '~/toolbar/ToolbarApp'
+/*
+ * Bootstrap of the toolbar, the only part loaded up front on the sites the toolbar is injected into. The toolbar
+ * itself is loaded when it's opened, and the heavier features (heatmap stats, actions, element info) when first used.
+ * Its size is budgeted in `webpack.config.js`.
+ */
 import { EditorProps } from '~/types'
 
-initKea()
-;(window as any)['simmer'] = new Simmer(window, { depth: 8 })
 ;(window as any)['ph_load_editor'] = function (editorParams: EditorProps) {
-    const container = document.createElement('div')
-    document.body.appendChild(container)
+    // chunks are served next to this bundle, not by the site the toolbar is injected into
+    const jsURL = editorParams.jsURL || editorParams.apiURL || ''
+    __webpack_public_path__ = `${jsURL}${jsURL.endsWith('/') ? '' : '/'}static/`
 
-    ReactDOM.render(
-        <Provider store={getContext().store}>
-            <ToolbarApp
-                {...editorParams}
-                actionId={
-                    typeof editorParams.actionId === 'string' ? parseInt(editorParams.actionId) : editorParams.actionId
-                }
-                jsURL={editorParams.jsURL || editorParams.apiURL}
-            />
-        </Provider>,
-        container
+    import(/* webpackChunkName: 'toolbar_app' */ '~/toolbar/loadToolbar').then(({ loadToolbar }) =>
+        loadToolbar(editorParams)
     )
 }
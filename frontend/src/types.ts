@@ -302,6 +302,7 @@ export interface CohortType {
     is_calculating?: boolean
     last_calculation?: string
     is_static?: boolean
+    static_synced_count?: number
     name?: string
     csv?: File
     groups: CohortGroupType[]
@@ -46,6 +46,7 @@ class CohortSerializer(serializers.ModelSerializer):
             "errors_calculating",
             "count",
             "is_static",
+            "static_synced_count",
         ]
         read_only_fields = [
             "id",
@@ -55,6 +56,7 @@ class CohortSerializer(serializers.ModelSerializer):
             "last_calculation",
             "errors_calculating",
             "count",
+            "static_synced_count",
         ]
 
     def _handle_csv(self, file, cohort: Cohort) -> None:
@@ -21,7 +21,13 @@ from posthog.auth import PersonalAPIKeyAuthentication, PublicTokenAuthentication
 from posthog.helpers import create_dashboard_from_template
 from posthog.models import Dashboard, DashboardItem, Team
 from posthog.permissions import ProjectMembershipNecessaryPermissions
-from posthog.utils import get_safe_cache, render_template
+from posthog.utils import get_safe_cache, get_safe_cache_many, render_template
+
+
+def include_results(context: Dict[str, Any]) -> bool:
+    """Dashboards requested with `include_results=false` only return the metadata of their items, not the results."""
+    request = context.get("request")
+    return not request or request.GET.get("include_results", "true").lower() != "false"
 
 
 class DashboardSerializer(serializers.ModelSerializer):
@@ -98,6 +104,10 @@ class DashboardSerializer(serializers.ModelSerializer):
             return None
         items = dashboard.items.filter(deleted=False).order_by("order").all()
         self.context.update({"dashboard": dashboard})
+        if include_results(self.context):
+            # fetch the cached results of all items in one round trip instead of one per item
+            filters_hashes = [item.filters_hash for item in items if item.filters_hash]
+            self.context["cached_results"] = get_safe_cache_many(filters_hashes)
         return DashboardItemSerializer(items, many=True, context=self.context).data
 
 
@@ -140,6 +150,17 @@ class DashboardsViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
         serializer = DashboardSerializer(dashboard, context={"view": self, "request": request})
         return response.Response(serializer.data)
 
+    @action(methods=["GET"], detail=True, url_path=r"items/(?P<item_id>[0-9]+)/result")
+    def item_result(self, request: Request, pk=None, item_id=None, **kwargs) -> response.Response:
+        """
+        Cached result of a single item, for dashboards loaded with `include_results=false` that fetch their tiles one
+        by one. Never computes anything, items without a fresh cached result get `null`.
+        """
+        dashboard = get_object_or_404(self.get_queryset(), pk=pk)
+        item = get_object_or_404(dashboard.items.filter(deleted=False), pk=item_id)
+        serializer = DashboardItemSerializer(item, context={"view": self, "request": request, "dashboard": dashboard})
+        return response.Response({key: serializer.data[key] for key in ("id", "result", "last_refresh")})
+
     def get_parents_query_dict(self) -> Dict[str, Any]:  # to be moved to a separate Legacy*ViewSet Class
         if not self.request.user.is_authenticated or "share_token" in self.request.GET or not self.request.user.team:
             return {}
@@ -173,6 +194,13 @@ class DashboardItemSerializer(serializers.ModelSerializer):
             "created_by",
         ]
 
+    def get_fields(self):
+        fields = super().get_fields()
+        if not include_results(self.context):
+            fields.pop("result")
+            fields["last_refresh"] = serializers.DateTimeField(read_only=True)
+        return fields
+
     def create(self, validated_data: Dict, *args: Any, **kwargs: Any) -> DashboardItem:
         request = self.context["request"]
         team = Team.objects.get(id=self.context["team_id"])
@@ -203,7 +231,11 @@ class DashboardItemSerializer(serializers.ModelSerializer):
         if not dashboard_item.filters_hash:
             return None
 
-        result = get_safe_cache(dashboard_item.filters_hash)
+        cached_results = self.context.get("cached_results")
+        if cached_results is not None:
+            result = cached_results.get(dashboard_item.filters_hash)
+        else:
+            result = get_safe_cache(dashboard_item.filters_hash)
         if not result or result.get("task_id", None):
             return None
         return result.get("result")
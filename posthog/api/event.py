@@ -1,8 +1,9 @@
 import json
 from datetime import timedelta
-from typing import Any, Dict, List, Optional, Union, cast
+from typing import Any, Dict, List, Optional, Set, Tuple, Union, cast
 
-from django.db.models import Prefetch, QuerySet
+from django.db.models import OuterRef, QuerySet, Subquery
+from django.db.models.fields.json import KeyTransform
 from django.db.models.query_utils import Q
 from django.utils import timezone
 from django.utils.timezone import now
@@ -14,7 +15,8 @@ from rest_framework.settings import api_settings
 from rest_framework_csv import renderers as csvrenderers
 
 from posthog.api.routing import StructuredViewSetMixin
-from posthog.models import Element, ElementGroup, Event, Filter, Person, PersonDistinctId
+from posthog.api.utils import format_next_url
+from posthog.models import Element, ElementGroup, Event, Filter, PersonDistinctId
 from posthog.models.action import Action
 from posthog.models.event import EventManager
 from posthog.models.filters.sessions_filter import SessionEventsFilter, SessionsFilter
@@ -25,6 +27,10 @@ from posthog.queries.sessions.session_recording import SessionRecording
 from posthog.utils import convert_property_value, flatten, relative_date_parse
 
 
+# Person properties sent along with every event of the list, the rest would bloat the payload
+EVENT_PERSON_PROPERTIES = ["email", "name", "username"]
+
+
 class ElementSerializer(serializers.ModelSerializer):
     event = serializers.CharField()
 
@@ -88,6 +94,10 @@ class EventSerializer(serializers.HyperlinkedModelSerializer):
         return representation
 
 
+# Each stored snapshot chunk holds up to 512kB of compressed data
+SESSION_RECORDING_MAX_PAGE_SIZE = 100
+
+
 class EventViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
     legacy_team_compatibility = True  # to be moved to a separate Legacy*ViewSet Class
 
@@ -131,45 +141,88 @@ class EventViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
                 queryset = queryset.filter(properties_to_Q(filter.properties, team_id=self.team_id))
         return queryset
 
+    def _run_session_recording(self, session_recording: SessionRecording, request: request.Request) -> Dict[str, Any]:
+        session_recording_id = request.GET["session_recording_id"]
+        if not request.GET.get("limit"):
+            return session_recording.run(
+                team=self.team, filter=Filter(request=request), session_recording_id=session_recording_id
+            )
+
+        offset, limit = self._recording_page(request)
+        result = session_recording.run_page(
+            team=self.team, session_recording_id=session_recording_id, offset=offset, limit=limit
+        )
+        result["next"] = format_next_url(request, offset, limit) if result.pop("has_next") else None
+        return result
+
+    def _recording_page(self, request: request.Request) -> Tuple[int, int]:
+        try:
+            offset = int(request.GET.get("offset", 0))
+            limit = int(request.GET.get("limit", SESSION_RECORDING_MAX_PAGE_SIZE))
+        except ValueError:
+            raise serializers.ValidationError("The query parameters offset and limit must be integers.")
+        return max(offset, 0), min(max(limit, 1), SESSION_RECORDING_MAX_PAGE_SIZE)
+
+    def _save_recording_view(self, request: request.Request) -> None:
+        # every page of a recording is a request of its own, the view is saved once, with the first one
+        if request.GET.get("save_view") and self._recording_page(request)[0] == 0:
+            SessionRecordingViewed.objects.get_or_create(
+                team=self.team, user=request.user, session_id=request.GET["session_recording_id"]
+            )
+
     def _prefetch_events(self, events: List[Event]) -> List[Event]:
         team_id = self.team_id
-        distinct_ids = []
-        hash_ids = []
-        for event in events:
-            distinct_ids.append(event.distinct_id)
-            if event.elements_hash:
-                hash_ids.append(event.elements_hash)
-        people = Person.objects.filter(
-            team_id=team_id, persondistinctid__distinct_id__in=distinct_ids
-        ).prefetch_related(Prefetch("persondistinctid_set", to_attr="distinct_ids_cache"))
-        if len(hash_ids) > 0:
-            groups = ElementGroup.objects.filter(team_id=team_id, hash__in=hash_ids).prefetch_related("element_set")
-        else:
-            groups = ElementGroup.objects.none()
+        distinct_ids = {event.distinct_id for event in events}
+        hashes = {event.elements_hash for event in events if event.elements_hash}
+
+        people = self._serialized_people_by_distinct_id(distinct_ids) if distinct_ids else {}
+        groups: Dict[str, ElementGroup] = {}
+        if hashes:
+            groups_query = ElementGroup.objects.filter(team_id=team_id, hash__in=hashes).prefetch_related("element_set")
+            groups = {group.hash: group for group in groups_query}
         for event in events:
-            try:
-                for person in people:
-                    if event.distinct_id in person.distinct_ids:
-                        event.serialized_person = {  # type: ignore
-                            "is_identified": person.is_identified,
-                            "distinct_ids": [
-                                person.distinct_ids[0],
-                            ],  # only send the first one to avoid a payload bloat
-                            "properties": {
-                                key: person.properties[key]
-                                for key in ["email", "name", "username"]
-                                if key in person.properties
-                            },
-                        }
-                        break
-            except IndexError:
-                event.serialized_person = None  # type: ignore
-            try:
-                event.elements_group_cache = [group for group in groups if group.hash == event.elements_hash][0]  # type: ignore
-            except IndexError:
-                event.elements_group_cache = None  # type: ignore
+            if event.distinct_id in people:
+                event.serialized_person = people[event.distinct_id]  # type: ignore
+            event.elements_group_cache = groups.get(event.elements_hash)  # type: ignore
         return events
 
+    def _serialized_people_by_distinct_id(self, distinct_ids: Set[str]) -> Dict[str, Dict[str, Any]]:
+        """
+        The person of every distinct id, in one query selecting only the fields sent with events: the identified flag,
+        the person's first distinct id (sending all of them bloats the payload) and `EVENT_PERSON_PROPERTIES`.
+        """
+        first_distinct_id = (
+            PersonDistinctId.objects.filter(person_id=OuterRef("person_id")).order_by("id").values("distinct_id")[:1]
+        )
+        rows = (
+            PersonDistinctId.objects.filter(team_id=self.team_id, distinct_id__in=distinct_ids)
+            .annotate(
+                first_distinct_id=Subquery(first_distinct_id),
+                **{
+                    "property_{}".format(key): KeyTransform(key, "person__properties")
+                    for key in EVENT_PERSON_PROPERTIES
+                },
+            )
+            .values(
+                "distinct_id",
+                "person__is_identified",
+                "first_distinct_id",
+                *["property_{}".format(key) for key in EVENT_PERSON_PROPERTIES],
+            )
+        )
+        return {
+            row["distinct_id"]: {
+                "is_identified": row["person__is_identified"],
+                "distinct_ids": [row["first_distinct_id"]],
+                "properties": {
+                    key: row["property_{}".format(key)]
+                    for key in EVENT_PERSON_PROPERTIES
+                    if row["property_{}".format(key)] is not None
+                },
+            }
+            for row in rows
+        }
+
     def list(self, request: request.Request, *args: Any, **kwargs: Any) -> response.Response:
         is_csv_request = self.request.accepted_renderer.format == "csv"
         monday = now() + timedelta(days=-now().weekday())
@@ -296,6 +349,7 @@ class EventViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
     # params:
     # - session_recording_id: (string) id of the session recording
     # - save_view: (boolean) save view of the recording
+    # - limit, offset: (int) page through the snapshots as stored, leaving chunked snapshots compressed
     # ******************************************
     @action(methods=["GET"], detail=False)
     def session_recording(self, request: request.Request, *args: Any, **kwargs: Any) -> response.Response:
@@ -308,13 +362,8 @@ class EventViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
                 },
                 status=400,
             )
-        session_recording = SessionRecording().run(
-            team=self.team, filter=Filter(request=request), session_recording_id=request.GET["session_recording_id"]
-        )
+        session_recording = self._run_session_recording(SessionRecording(), request)
 
-        if request.GET.get("save_view"):
-            SessionRecordingViewed.objects.get_or_create(
-                team=self.team, user=request.user, session_id=request.GET["session_recording_id"]
-            )
+        self._save_recording_view(request)
 
         return response.Response({"result": session_recording})
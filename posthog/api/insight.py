@@ -12,7 +12,7 @@ from rest_framework.response import Response
 
 from posthog.api.routing import StructuredViewSetMixin
 from posthog.api.shared import UserBasicSerializer
-from posthog.api.utils import format_next_url
+from posthog.api.utils import format_next_url, insight_response
 from posthog.celery import update_cache_item_task
 from posthog.constants import FROM_DASHBOARD, INSIGHT, INSIGHT_FUNNELS, INSIGHT_PATHS, TRENDS_STICKINESS
 from posthog.decorators import CacheType, cached_function
@@ -148,7 +148,7 @@ class InsightViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
         result = self.calculate_trends(request)
         filter = Filter(request=request)
         next = format_next_url(request, filter.offset, 20) if len(result["result"]) > 20 else None
-        return Response({**result, "next": next})
+        return insight_response(request, {**result, "next": next})
 
     @cached_function()
     def calculate_trends(self, request: request.Request) -> Dict[str, Any]:
@@ -176,7 +176,7 @@ class InsightViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
     # ******************************************
     @action(methods=["GET"], detail=False)
     def session(self, request: request.Request, *args: Any, **kwargs: Any) -> Response:
-        return Response(self.calculate_session(request))
+        return insight_response(request, self.calculate_session(request))
 
     @cached_function()
     def calculate_session(self, request: request.Request) -> Dict[str, Any]:
@@ -197,7 +197,7 @@ class InsightViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
     def funnel(self, request: request.Request, *args: Any, **kwargs: Any) -> Response:
         result = self.calculate_funnel(request)
 
-        return Response(result)
+        return insight_response(request, result)
 
     @cached_function()
     def calculate_funnel(self, request: request.Request) -> Dict[str, Any]:
@@ -237,7 +237,7 @@ class InsightViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
     @action(methods=["GET"], detail=False)
     def retention(self, request: request.Request, *args: Any, **kwargs: Any) -> Response:
         result = self.calculate_retention(request)
-        return Response(result)
+        return insight_response(request, result)
 
     @cached_function()
     def calculate_retention(self, request: request.Request) -> Dict[str, Any]:
@@ -259,7 +259,7 @@ class InsightViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
     @action(methods=["GET"], detail=False)
     def path(self, request: request.Request, *args: Any, **kwargs: Any) -> Response:
         result = self.calculate_path(request)
-        return Response(result)
+        return insight_response(request, result)
 
     @cached_function()
     def calculate_path(self, request: request.Request) -> Dict[str, Any]:
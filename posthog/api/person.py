@@ -1,6 +1,7 @@
 import json
 import warnings
-from typing import Any, Dict, List, Optional, Union, cast
+from datetime import datetime
+from typing import Any, Dict, List, Optional, Tuple, Union, cast
 
 from django.db.models import Count, Func, Prefetch, Q, QuerySet
 from django_filters import rest_framework as filters
@@ -15,8 +16,9 @@ from rest_framework_csv import renderers as csvrenderers
 
 from posthog.api.routing import StructuredViewSetMixin
 from posthog.api.utils import format_next_url, get_target_entity
+from posthog.columnar.store import record_deletion
 from posthog.constants import TRENDS_TABLE
-from posthog.models import Cohort, Event, Filter, Person, User
+from posthog.models import Cohort, Entity, Event, EventFirstSeen, Filter, Person, Team, User
 from posthog.models.filters import RetentionFilter
 from posthog.models.filters.stickiness_filter import StickinessFilter
 from posthog.permissions import ProjectMembershipNecessaryPermissions
@@ -133,6 +135,9 @@ class PersonViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
             person = Person.objects.get(team_id=self.team_id, pk=pk)
             events = Event.objects.filter(team_id=self.team_id, distinct_id__in=person.distinct_ids)
             events.delete()
+            # a distinct id that comes back later is new again
+            EventFirstSeen.objects.filter(team_id=self.team_id, distinct_id__in=person.distinct_ids).delete()
+            record_deletion(self.team_id, person.distinct_ids)
             person.delete()
             return response.Response(status=204)
         except Person.DoesNotExist:
@@ -233,13 +238,26 @@ class PersonViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
 
         limit = int(request.GET.get("limit", 100))
 
-        next_url: Optional[str] = request.get_full_path()
-        people = self.lifecycle_class().get_people(
-            target_date=target_date_parsed, filter=filter, team_id=team.pk, lifecycle_type=lifecycle_type, limit=limit,
+        people, total_count, next_url = self._lifecycle_people(
+            request, filter, team, target_date_parsed, lifecycle_type, limit
+        )
+        return response.Response(
+            {"results": [{"people": people, "count": len(people), "total_count": total_count}], "next": next_url}
         )
-        next_url = paginated_result(people, request, filter.offset)
 
-        return response.Response({"results": [{"people": people, "count": len(people)}], "next": next_url})
+    def _lifecycle_people(
+        self,
+        request: request.Request,
+        filter: Filter,
+        team: Team,
+        target_date: datetime,
+        lifecycle_type: str,
+        limit: int,
+    ) -> Tuple[List, Optional[int], Optional[str]]:
+        people = self.lifecycle_class().get_people(
+            target_date=target_date, filter=filter, team_id=team.pk, lifecycle_type=lifecycle_type, limit=limit,
+        )
+        return people, None, paginated_result(people, request, filter.offset)
 
     @action(methods=["GET"], detail=False)
     def retention(self, request: request.Request) -> response.Response:
@@ -253,14 +271,17 @@ class PersonViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
             )
         filter = RetentionFilter(request=request)
 
-        if display == TRENDS_TABLE:
+        people, total_count, next_url = self._retention_people(request, filter, team, display == TRENDS_TABLE)
+        return response.Response({"result": people, "total_count": total_count, "next": next_url})
+
+    def _retention_people(
+        self, request: request.Request, filter: RetentionFilter, team: Team, in_period: bool
+    ) -> Tuple[List, Optional[int], Optional[str]]:
+        if in_period:
             people = self.retention_class().people_in_period(filter, team)
         else:
             people = self.retention_class().people(filter, team)
-
-        next_url = paginated_result(people, request, filter.offset)
-
-        return response.Response({"result": people, "next": next_url})
+        return people, None, paginated_result(people, request, filter.offset)
 
     @action(methods=["GET"], detail=False)
     def stickiness(self, request: request.Request) -> response.Response:
@@ -275,9 +296,16 @@ class PersonViewSet(StructuredViewSetMixin, viewsets.ModelViewSet):
 
         target_entity = get_target_entity(request)
 
+        people, total_count, next_url = self._stickiness_people(request, filter, team, target_entity)
+        return response.Response(
+            {"results": [{"people": people, "count": len(people), "total_count": total_count}], "next": next_url}
+        )
+
+    def _stickiness_people(
+        self, request: request.Request, filter: StickinessFilter, team: Team, target_entity: Entity
+    ) -> Tuple[List, Optional[int], Optional[str]]:
         people = self.stickiness_class().people(target_entity, filter, team)
-        next_url = paginated_result(people, request, filter.offset)
-        return response.Response({"results": [{"people": people, "count": len(people)}], "next": next_url})
+        return people, None, paginated_result(people, request, filter.offset)
 
     @action(methods=["GET"], detail=False)
     def cohorts(self, request: request.Request) -> response.Response:
@@ -1,3 +1,4 @@
+from django.db.models import Case, F, IntegerField, QuerySet, Value, When
 from rest_framework import filters, mixins, permissions, serializers, viewsets
 
 from posthog.api.routing import StructuredViewSetMixin
@@ -28,4 +29,24 @@ class PropertyDefinitionViewSet(
     search_fields = ["name"]
 
     def get_queryset(self):
-        return self.filter_queryset_by_parents_lookups(PropertyDefinition.objects.all()).order_by(self.ordering)
+        queryset = self.filter_queryset_by_parents_lookups(PropertyDefinition.objects.all())
+        if self.request.GET.get("is_numerical"):
+            queryset = queryset.filter(is_numerical=self.request.GET["is_numerical"].lower() == "true")
+        if "search" in self.request.GET:
+            return self._rank_search_results(queryset, self.request.GET["search"].strip())
+        return queryset.order_by(self.ordering)
+
+    def _rank_search_results(self, queryset: QuerySet, search: str) -> QuerySet:
+        """
+        Typeahead order: exact matches first, then names starting with the search (ignoring the `$` of
+        PostHog's own properties), then any other match. Within each group the most queried properties come first.
+        """
+        return queryset.annotate(
+            search_rank=Case(
+                When(name__iexact=search, then=Value(0)),
+                When(name__istartswith=search, then=Value(1)),
+                When(name__istartswith=f"${search}", then=Value(1)),
+                default=Value(2),
+                output_field=IntegerField(),
+            )
+        ).order_by("search_rank", F("query_usage_30_day").desc(nulls_last=True), self.ordering)
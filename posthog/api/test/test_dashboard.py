@@ -144,6 +144,39 @@ class TestDashboard(APIBaseTest):
         self.assertAlmostEqual(Dashboard.objects.get().last_accessed_at, now(), delta=timezone.timedelta(seconds=5))
         self.assertEqual(response["items"][0]["result"][0]["count"], 0)
 
+    def test_dashboard_without_results_and_item_result(self):
+        dashboard = Dashboard.objects.create(team=self.team, name="dashboard")
+        filter_dict = {"events": [{"id": "$pageview"}]}
+        item = DashboardItem.objects.create(dashboard=dashboard, filters=filter_dict, team=self.team)
+
+        # cache results
+        self.client.get("/api/insight/trend/?events=%s" % json.dumps(filter_dict["events"]))
+
+        response = self.client.get("/api/dashboard/%s/?include_results=false" % dashboard.pk).json()
+        self.assertNotIn("result", response["items"][0])
+        self.assertIsNotNone(response["items"][0]["last_refresh"])
+
+        response = self.client.get("/api/dashboard/%s/items/%s/result/" % (dashboard.pk, item.pk))
+        self.assertEqual(response.status_code, status.HTTP_200_OK)
+        self.assertEqual(response.json()["id"], item.pk)
+        self.assertEqual(response.json()["result"][0]["count"], 0)
+        self.assertIsNotNone(response.json()["last_refresh"])
+
+        other_dashboard = Dashboard.objects.create(team=self.team, name="other dashboard")
+        response = self.client.get("/api/dashboard/%s/items/%s/result/" % (other_dashboard.pk, item.pk))
+        self.assertEqual(response.status_code, status.HTTP_404_NOT_FOUND)
+
+    def test_item_result_with_share_token(self):
+        dashboard = Dashboard.objects.create(team=self.team, name="dashboard", is_shared=True, share_token="abc")
+        item = DashboardItem.objects.create(
+            dashboard=dashboard, filters={"events": [{"id": "$pageview"}]}, team=self.team,
+        )
+        self.client.logout()
+
+        response = self.client.get("/api/dashboard/%s/items/%s/result/?share_token=abc" % (dashboard.pk, item.pk))
+        self.assertEqual(response.status_code, status.HTTP_200_OK)
+        self.assertEqual(response.json()["result"], None)
+
     def test_no_cache_available(self):
         dashboard = Dashboard.objects.create(team=self.team, name="dashboard")
         filter_dict = {
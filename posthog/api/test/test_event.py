@@ -8,6 +8,7 @@ from freezegun import freeze_time
 
 from posthog.constants import RDBMS
 from posthog.models import Action, ActionStep, Element, Event, Organization, Person, Team
+from posthog.models.session_recording_event import SessionRecordingViewed
 from posthog.queries.sessions.sessions_list import SESSIONS_LIST_DEFAULT_LIMIT
 from posthog.test.base import APIBaseTest
 from posthog.utils import relative_date_parse
@@ -39,7 +40,7 @@ def factory_test_event_api(event_factory, person_factory, _):
                 event="$pageview", team=self.team, distinct_id="some-other-one", properties={"$ip": "8.8.8.8"}
             )
 
-            expected_queries = 4 if settings.PRIMARY_DB == RDBMS.CLICKHOUSE else 11
+            expected_queries = 4 if settings.PRIMARY_DB == RDBMS.CLICKHOUSE else 10
 
             with self.assertNumQueries(expected_queries):
                 response = self.client.get("/api/event/?distinct_id=2").json()
@@ -62,7 +63,7 @@ def factory_test_event_api(event_factory, person_factory, _):
                 event="another event", team=self.team, distinct_id="2", properties={"$ip": "8.8.8.8"},
             )
 
-            expected_queries = 4 if settings.PRIMARY_DB == RDBMS.CLICKHOUSE else 8
+            expected_queries = 4 if settings.PRIMARY_DB == RDBMS.CLICKHOUSE else 7
 
             with self.assertNumQueries(expected_queries):
                 response = self.client.get("/api/event/?event=event_name").json()
@@ -79,7 +80,7 @@ def factory_test_event_api(event_factory, person_factory, _):
                 event="event_name", team=self.team, distinct_id="2", properties={"$browser": "Safari"},
             )
 
-            expected_queries = 4 if settings.PRIMARY_DB == RDBMS.CLICKHOUSE else 8
+            expected_queries = 4 if settings.PRIMARY_DB == RDBMS.CLICKHOUSE else 7
 
             with self.assertNumQueries(expected_queries):
                 response = self.client.get(
@@ -266,6 +267,18 @@ def factory_test_event_api(event_factory, person_factory, _):
             self.assertEqual(response["results"][0]["id"], event2.pk)
             self.assertEqual(response["results"][1]["id"], event3.pk)
 
+        def test_ascending_order_after_cursor(self):
+            person_factory(team=self.team, distinct_ids=["1"])
+            for day in [7, 8, 9, 10]:
+                with freeze_time(f"2020-01-{day:02d}"):
+                    event_factory(team=self.team, event=f"event {day}", distinct_id="1")
+
+            with freeze_time("2020-01-11"):
+                response = self.client.get(
+                    '/api/event/?after=2020-01-07T12:00:00.000Z&orderBy=["timestamp"]&distinct_id=1'
+                ).json()
+            self.assertEqual([event["event"] for event in response["results"]], ["event 8", "event 9", "event 10"])
+
         def test_pagination(self):
             person_factory(team=self.team, distinct_ids=["1"])
             for idx in range(0, 150):
@@ -389,6 +402,18 @@ def factory_test_event_api(event_factory, person_factory, _):
                 "CSV export should return up to CSV_EXPORT_LIMIT events (+ headers row)",
             )
 
+        def test_session_recording_invalid_page(self):
+            response = self.client.get("/api/event/session_recording/?session_recording_id=1&limit=all")
+            self.assertEqual(response.status_code, 400)
+
+        def test_session_recording_view_saved_with_first_page(self):
+            url = "/api/event/session_recording/?session_recording_id=1&save_view=true&limit=2"
+            self.assertEqual(self.client.get(url + "&offset=2").status_code, 200)
+            self.assertFalse(SessionRecordingViewed.objects.filter(team=self.team, session_id="1").exists())
+
+            self.assertEqual(self.client.get(url).status_code, 200)
+            self.assertTrue(SessionRecordingViewed.objects.filter(team=self.team, session_id="1").exists())
+
     return TestEvents
 
 
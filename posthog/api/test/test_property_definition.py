@@ -98,3 +98,26 @@ class TestPropertyDefinitionAPI(APIBaseTest):
         self.assertEqual(response.json()["count"], 2)
         for item in response.json()["results"]:
             self.assertIn(item["name"], ["is_first_movie", "first_visit"])
+
+    def test_search_ranks_prefix_matches_and_usage(self):
+        PropertyDefinition.objects.filter(team=self.demo_team, name="is_first_movie").update(query_usage_30_day=5)
+        PropertyDefinition.objects.create(team=self.demo_team, name="$first_seen", query_usage_30_day=1)
+        PropertyDefinition.objects.create(team=self.demo_team, name="first", query_usage_30_day=0)
+
+        response = self.client.get("/api/projects/@current/property_definitions/?search=first")
+        self.assertEqual(response.status_code, status.HTTP_200_OK)
+        self.assertEqual(
+            [item["name"] for item in response.json()["results"]],
+            ["first", "$first_seen", "first_visit", "is_first_movie"],
+        )
+
+        # an empty search ranks every property by usage, for the suggestions shown before anything is typed
+        response = self.client.get("/api/projects/@current/property_definitions/?search=&limit=2")
+        self.assertEqual([item["name"] for item in response.json()["results"]], ["is_first_movie", "$first_seen"])
+
+    def test_filter_numerical_property_definitions(self):
+        response = self.client.get("/api/projects/@current/property_definitions/?is_numerical=true")
+        self.assertEqual(response.status_code, status.HTTP_200_OK)
+        self.assertEqual(
+            sorted(item["name"] for item in response.json()["results"]), ["app_rating", "purchase", "purchase_value"]
+        )
@@ -1,9 +1,20 @@
-from typing import Optional
+import json
+import re
+from typing import Any, Callable, Dict, List, Optional, Tuple
+from uuid import uuid4
 
-from rest_framework import request
+from django.core.cache import cache
+from rest_framework import request, status
+from rest_framework.exceptions import ValidationError
+from rest_framework.response import Response
 
 from posthog.constants import ENTITY_ID, ENTITY_MATH, ENTITY_TYPE
 from posthog.models import Entity
+from posthog.utils import generate_cache_key, get_safe_cache
+
+PEOPLE_DRILLDOWN_PAGE_SIZE = 100
+PEOPLE_DRILLDOWN_TTL = 10 * 60  # seconds
+PEOPLE_DRILLDOWN_CACHED_PEOPLE = 10 * PEOPLE_DRILLDOWN_PAGE_SIZE
 
 
 def get_target_entity(request: request.Request) -> Entity:
@@ -30,3 +41,71 @@ def format_next_url(request: request.Request, offset: int, page_size: int):
             "{}{}offset={}".format(next_url, "&" if "?" in next_url else "?", offset + page_size)
         )
     return next_url
+
+
+def insight_response(request: request.Request, data: Dict[str, Any]) -> Response:
+    """
+    Tags the insight result with an ETag, and answers with an empty 304 when the client already has that result.
+    `last_refresh` and `is_cached` change without the result changing, so they aren't part of the tag.
+    """
+    etag = '"{}"'.format(generate_cache_key(json.dumps(data.get("result"), default=str)))
+    if etag in [tag.strip() for tag in request.headers.get("If-None-Match", "").split(",")]:
+        return Response(status=status.HTTP_304_NOT_MODIFIED, headers={"ETag": etag})
+    return Response(data, headers={"ETag": etag})
+
+
+def _parse_people_cursor(cursor: Optional[str]) -> Tuple[str, int]:
+    if not cursor:
+        return uuid4().hex, 0
+    set_id, _, position = cursor.partition(".")
+    if not re.fullmatch(r"[0-9a-f]{32}", set_id) or not position.isdigit():
+        raise ValidationError({"cursor": "Invalid cursor."})
+    return set_id, int(position)
+
+
+def _window_covers(window: Dict[str, Any], position: int, page_size: int) -> bool:
+    window_end = window["start"] + len(window["people"])
+    return window["start"] <= position and (position + page_size <= window_end or window_end == window["count"])
+
+
+def people_drilldown(
+    request: request.Request,
+    team_id: int,
+    compute: Callable[[], List[Any]],
+    serialize: Callable[[List[Any]], Any],
+    page_size: int = PEOPLE_DRILLDOWN_PAGE_SIZE,
+) -> Tuple[Any, int, Optional[str]]:
+    """
+    Pages through the people of an insight drilldown. The matching people (as returned by `compute`, e.g. person
+    uuids) are computed on the first page, and a window of them of `PEOPLE_DRILLDOWN_CACHED_PEOPLE` starting at that
+    page is kept for `PEOPLE_DRILLDOWN_TTL`: the `cursor` of the next pages points into that window, so they are cheap
+    slices of it. Once a page falls outside of the window, or the window expired, the people are computed again from
+    the filters, which the next page url keeps, and the window moves to that page.
+
+    `compute` has to return the people in the same order every time, for the windows to line up.
+
+    Returns the page serialized by `serialize`, the total count of people and the url of the next page.
+    """
+    set_id, position = _parse_people_cursor(request.GET.get("cursor"))
+    cache_key = "people_drilldown_{}_{}".format(team_id, set_id)
+
+    window = get_safe_cache(cache_key)
+    if window is None or not _window_covers(window, position, page_size):
+        people = list(compute())
+        window = {
+            "start": position,
+            "people": people[position : position + max(PEOPLE_DRILLDOWN_CACHED_PEOPLE, page_size)],
+            "count": len(people),
+        }
+        cache.set(cache_key, window, PEOPLE_DRILLDOWN_TTL)
+
+    start = position - window["start"]
+    next_position = position + page_size
+    next_url = None
+    if next_position < window["count"]:
+        params = request.GET.copy()
+        params.pop("offset", None)
+        params["cursor"] = "{}.{}".format(set_id, next_position)
+        next_url = request.build_absolute_uri("{}?{}".format(request.path, params.urlencode()))
+
+    return serialize(window["people"][start : start + page_size]), window["count"], next_url
@@ -1,15 +1,20 @@
+import json
 import os
 import time
+from typing import Optional
 
 import statsd
 from celery import Celery
 from celery.schedules import crontab
+from celery.signals import before_task_publish
 from django.conf import settings
 from django.db import connection
 from django.utils import timezone
 
+from posthog.columnar import is_columnar_store_enabled
 from posthog.ee import is_ee_enabled
 from posthog.redis import get_client
+from posthog.task_concurrency import limit_concurrency
 
 # set the default Django settings module for the 'celery' program.
 os.environ.setdefault("DJANGO_SETTINGS_MODULE", "posthog.settings")
@@ -25,9 +30,21 @@ app.config_from_object("django.conf:settings", namespace="CELERY")
 # Load task modules from all registered Django app configs.
 app.autodiscover_tasks()
 
-# Make sure Redis doesn't add too many connections
+# Reuse a bounded number of broker connections per worker instead of opening one per published message
 # https://stackoverflow.com/questions/47106592/redis-connections-not-being-released-after-celery-task-is-complete
-app.conf.broker_pool_limit = 0
+app.conf.broker_pool_limit = settings.CELERY_BROKER_POOL_LIMIT
+app.conf.redis_max_connections = settings.REDIS_MAX_CONNECTIONS
+
+# Honor message priorities within each queue (0 is the highest), redis emulates them with one list per step
+app.conf.broker_transport_options = {
+    **app.conf.broker_transport_options,
+    "priority_steps": list(range(10)),
+    "queue_order_strategy": "priority",
+}
+PRIORITY_STEP_SEPARATOR = "\x06\x16"  # kombu's default separator between the queue name and the priority step
+
+# Header used to report how long messages wait in each queue
+PUBLISHED_AT_HEADER = "posthog_published_at"
 
 # How frequently do we want to calculate action -> event relationships if async is enabled
 ACTION_EVENT_MAPPING_INTERVAL_SECONDS = settings.ACTION_EVENT_MAPPING_INTERVAL_SECONDS
@@ -38,10 +55,19 @@ EVENT_PROPERTY_USAGE_INTERVAL_SECONDS = settings.EVENT_PROPERTY_USAGE_INTERVAL_S
 # How frequently do we want to check if dashboard items need to be recalculated
 UPDATE_CACHED_DASHBOARD_ITEMS_INTERVAL_SECONDS = settings.UPDATE_CACHED_DASHBOARD_ITEMS_INTERVAL_SECONDS
 
+# How frequently do we want to copy new events to the columnar store if it's enabled
+COLUMNAR_STORE_SYNC_INTERVAL_SECONDS = settings.COLUMNAR_STORE_SYNC_INTERVAL_SECONDS
+
 if settings.STATSD_HOST is not None:
     statsd.Connection.set_defaults(host=settings.STATSD_HOST, port=settings.STATSD_PORT)
 
 
+@before_task_publish.connect
+def stamp_published_at(headers=None, **kwargs):
+    if headers is not None:
+        headers[PUBLISHED_AT_HEADER] = time.time()
+
+
 @app.on_after_configure.connect
 def setup_periodic_tasks(sender, **kwargs):
     if not settings.DEBUG:
@@ -91,6 +117,14 @@ def setup_periodic_tasks(sender, **kwargs):
             expires=ACTION_EVENT_MAPPING_INTERVAL_SECONDS,
         )
 
+    if is_columnar_store_enabled():
+        sender.add_periodic_task(
+            COLUMNAR_STORE_SYNC_INTERVAL_SECONDS,
+            sync_columnar_store.s(),
+            name="sync columnar store",
+            expires=COLUMNAR_STORE_SYNC_INTERVAL_SECONDS,
+        )
+
     sender.add_periodic_task(120, calculate_cohort.s(), name="recalculate cohorts")
 
     if settings.ASYNC_EVENT_PROPERTY_USAGE:
@@ -196,12 +230,40 @@ def clickhouse_mutation_count():
         pass
 
 
+def _queue_priority_keys(queue: str):
+    yield queue
+    for step in app.conf.broker_transport_options["priority_steps"][1:]:
+        yield "{}{}{}".format(queue, PRIORITY_STEP_SEPARATOR, step)
+
+
+def _oldest_message_age(message: Optional[bytes], now: float) -> float:
+    if not message:
+        return 0
+    published_at = json.loads(message).get("headers", {}).get(PUBLISHED_AT_HEADER)
+    return max(now - published_at, 0) if published_at else 0
+
+
 @app.task(ignore_result=True)
 def redis_celery_queue_depth():
     try:
         g = statsd.Gauge("%s_posthog_celery" % (settings.STATSD_PREFIX,))
-        llen = get_client().llen("celery")
-        g.send("queue_depth", llen)
+        client = get_client()
+        now = time.time()
+        total_depth = 0
+        for queue in ["celery", *settings.CELERY_WORKLOAD_QUEUES]:
+            keys = list(_queue_priority_keys(queue))
+            # messages are pushed on the left and consumed from the right, so the oldest one is at index -1
+            pipeline = client.pipeline(transaction=False)
+            for key in keys:
+                pipeline.llen(key)
+                pipeline.lindex(key, -1)
+            results = pipeline.execute()
+            depth = sum(results[0::2])
+            age = max(_oldest_message_age(message, now) for message in results[1::2])
+            total_depth += depth
+            g.send("celery_{queue}_queue_depth".format(queue=queue), depth)
+            g.send("celery_{queue}_queue_age_seconds".format(queue=queue), age)
+        g.send("queue_depth", total_depth)
     except:
         # if we can't connect to statsd don't complain about it.
         # not every installation will have statsd available
@@ -260,6 +322,7 @@ def check_cached_items():
 
 
 @app.task(ignore_result=True)
+@limit_concurrency("update_cache_item")
 def update_cache_item_task(key: str, cache_type, payload: dict) -> None:
     from posthog.tasks.update_cache import update_cache_item
 
@@ -286,6 +349,13 @@ def calculate_event_property_usage():
     calculate_event_property_usage()
 
 
+@app.task(ignore_result=True)
+def sync_columnar_store():
+    from posthog.tasks.sync_columnar_store import sync_columnar_store
+
+    sync_columnar_store()
+
+
 @app.task(ignore_result=True)
 def calculate_billing_daily_usage():
     try:
@@ -0,0 +1,18 @@
+"""
+Columnar copy of the events for Postgres installs.
+
+Funnels, trends and retention scan a lot of events per query, which `posthog_event` isn't laid out for. When
+`COLUMNAR_STORE_PATH` is set, the events and the distinct id to person mapping are mirrored into an embedded DuckDB
+file and the queries that can be answered from it are, everything else still runs against Postgres.
+"""
+import importlib.util
+
+from django.conf import settings
+
+from posthog.ee import is_ee_enabled
+
+
+def is_columnar_store_enabled() -> bool:
+    return (
+        bool(settings.COLUMNAR_STORE_PATH) and not is_ee_enabled() and importlib.util.find_spec("duckdb") is not None
+    )
@@ -0,0 +1,303 @@
+"""
+Funnel, trends and retention queries over the columnar store.
+
+Each returns the same rows as the Postgres query it stands in for, or None when the store is disabled, unavailable or
+behind the end of the filter's date range, or the filter uses something that isn't mirrored (actions, person, element
+and cohort properties, other operators), in which case the caller runs its Postgres query.
+"""
+from collections import namedtuple
+from datetime import datetime
+from typing import Any, Dict, List, Optional, Tuple, Union
+from uuid import UUID
+
+import pytz
+
+from posthog.columnar import is_columnar_store_enabled
+from posthog.columnar.store import execute
+from posthog.constants import RETENTION_FIRST_TIME, TREND_FILTER_TYPE_EVENTS
+from posthog.models.entity import Entity
+from posthog.models.filters import Filter, RetentionFilter
+from posthog.models.property import Property
+from posthog.models.team import Team
+from posthog.queries.base import filter_date_bounds
+
+SUPPORTED_OPERATORS = (None, "exact", "is_not", "icontains", "not_icontains", "is_set", "is_not_set")
+INTERVALS = ("minute", "hour", "day", "week", "month")
+
+EVENTS_WITH_PEOPLE = """
+    events e
+    JOIN person_distinct_ids pdi ON pdi.team_id = e.team_id AND pdi.distinct_id = e.distinct_id
+"""
+
+# Same period arithmetic as `Retention._get_trunc_func`
+RETENTION_PERIODS: Dict[str, Tuple[str, str]] = {
+    "Hour": ("hour", "floor((epoch({to}) - epoch({since})) / 3600.0)"),
+    "Day": ("day", "floor((epoch({to}) - epoch({since})) / 86400.0)"),
+    "Week": ("week", "floor((epoch({to}) - epoch({since})) / 604800.0)"),
+    "Month": ("month", "datediff('month', {since}, {to})"),
+}
+
+Conditions = Tuple[str, List[Any]]
+
+
+def funnel_steps(filter: Filter, team_id: int) -> Optional[List[Any]]:
+    """Rows of `Funnel._build_query`: the uuid of every person who did the first step and when they did each step."""
+    steps = _funnel_steps_query(filter, team_id)
+    if steps is None:
+        return None
+    query, params = steps
+    step_columns = ", ".join(f"step_{index}.step_ts AS step_{index}" for index in range(len(filter.entities)))
+    rows = execute(
+        f"{query} SELECT step_0.person_uuid, {step_columns} FROM {_join_steps(filter)}", params, filter.date_to
+    )
+    if rows is None:
+        return None
+    FunnelPerson = namedtuple(  # type: ignore
+        "FunnelPerson", ["uuid"] + [f"step_{index}" for index in range(len(filter.entities))]
+    )
+    return [FunnelPerson(UUID(row[0]), *row[1:]) for row in rows]
+
+
+def funnel_trends(filter: Filter, team_id: int, within_time: str) -> Optional[List[Any]]:
+    """Rows of `Funnel._build_trends_query`: how many people did each step, by the interval of their first step."""
+    if filter.interval not in INTERVALS:
+        return None
+    steps = _funnel_steps_query(filter, team_id, within_time)
+    if steps is None:
+        return None
+    query, params = steps
+    step_counts = ", ".join(f"count(step_{index}.step_ts) AS step_{index}" for index in range(len(filter.entities)))
+    rows = execute(
+        f"""
+        {query}
+        SELECT date_trunc('{filter.interval}', step_0.step_ts{_week_shift(filter.interval)}) AS period, {step_counts}
+        FROM {_join_steps(filter)}
+        GROUP BY period
+        """,
+        params,
+        filter.date_to,
+    )
+    if rows is None:
+        return None
+    StepsAtDate = namedtuple(  # type: ignore
+        "StepsAtDate", ["date"] + [f"step_{index}_count" for index in range(len(filter.entities))]
+    )
+    return [StepsAtDate(*row) for row in rows]
+
+
+def trend_counts(entity: Entity, filter: Filter, team_id: int) -> Optional[Tuple[List[Dict[str, Any]], int]]:
+    """
+    Events (or people with `dau`) per interval, shaped like the aggregates `group_events_to_date` takes, and the total
+    over the whole range.
+    """
+    interval = filter.interval or "day"
+    if not is_columnar_store_enabled() or entity.type != TREND_FILTER_TYPE_EVENTS or interval not in INTERVALS:
+        return None
+    conditions = _event_conditions(team_id, entity.id, _filter_properties(filter, team_id) + entity.properties)
+    if conditions is None:
+        return None
+    date_from, date_to = filter_date_bounds(filter)
+    where, params = _with_date_bounds(conditions, date_from, date_to)
+    aggregate = "count(DISTINCT pdi.person_id)" if entity.math == "dau" else "count(*)"
+    rows = execute(
+        f"""
+        SELECT date_trunc('{interval}', e.timestamp{_week_shift(interval)}) AS period, {aggregate}
+        FROM events e
+        LEFT JOIN person_distinct_ids pdi ON pdi.team_id = e.team_id AND pdi.distinct_id = e.distinct_id
+        WHERE {where}
+        GROUP BY GROUPING SETS ((period), ())
+        """,
+        params,
+        date_to,
+    )
+    if rows is None:
+        return None
+    aggregates = [
+        {interval: period.replace(tzinfo=pytz.utc), "count": count} for period, count in rows if period is not None
+    ]
+    total = next((count for period, count in rows if period is None), 0)
+    return aggregates, total
+
+
+def retention_counts(filter: RetentionFilter, team_id: int) -> Optional[Dict[Tuple[int, int], Dict[str, Any]]]:
+    """Same `{(first period, period): {"count": people}}` as `Retention._execute_sql`."""
+    target, returning = filter.target_entity, filter.returning_entity
+    if (
+        not is_columnar_store_enabled()
+        or target.type != TREND_FILTER_TYPE_EVENTS
+        or returning.type != TREND_FILTER_TYPE_EVENTS
+        or filter.period not in RETENTION_PERIODS
+        or filter.date_from is None
+    ):
+        return None
+    properties = _property_conditions(_filter_properties(filter, team_id))
+    if properties is None:
+        return None
+    property_where, property_params = properties
+    date_from, date_to = _date_filter_bounds(filter)
+    filtered_where, filtered_params = _with_date_bounds(("TRUE", []), date_from, date_to, column="timestamp")
+
+    trunc, index = RETENTION_PERIODS[filter.period]
+    first_index = index.format(since="?", to="first_periods.first_date")
+    period_index = index.format(since="first_periods.first_date", to="filtered.timestamp")
+    if filter.retention_type == RETENTION_FIRST_TIME:
+        first_where, first_params = _with_date_bounds(("TRUE", []), date_from, date_to, column="first_date")
+        first_query = f"""
+            SELECT * FROM (
+                SELECT person_id, min(date_trunc('{trunc}', timestamp)) AS first_date
+                FROM scoped WHERE event = ? GROUP BY person_id
+            ) WHERE {first_where}
+        """
+    else:
+        first_params = []
+        first_query = f"""
+            SELECT DISTINCT person_id, date_trunc('{trunc}', timestamp) AS first_date FROM filtered WHERE event = ?
+        """
+
+    rows = execute(
+        f"""
+        WITH scoped AS (
+            SELECT pdi.person_id, e.event, e.timestamp FROM {EVENTS_WITH_PEOPLE}
+            WHERE e.team_id = ? AND e.event IN (?, ?) AND {property_where}
+        ),
+        filtered AS (SELECT * FROM scoped WHERE {filtered_where}),
+        first_periods AS ({first_query})
+        SELECT first_index, period_index, count(DISTINCT person_id) FROM (
+            SELECT first_periods.person_id, {first_index} AS first_index, {period_index} AS period_index
+            FROM first_periods JOIN filtered ON filtered.person_id = first_periods.person_id
+            WHERE filtered.event = ? AND filtered.timestamp >= first_periods.first_date
+            UNION ALL
+            SELECT first_periods.person_id, {first_index} AS first_index, 0 AS period_index FROM first_periods
+        ) GROUP BY first_index, period_index
+        """,
+        [team_id, target.id, returning.id, *property_params]
+        + filtered_params
+        + [target.id, *first_params]
+        + [_to_utc(filter.date_from), returning.id, _to_utc(filter.date_from)],
+        filter.date_to,
+    )
+    if rows is None:
+        return None
+    return {(int(first), int(period)): {"count": count} for first, period, count in rows}
+
+
+def _funnel_steps_query(filter: Filter, team_id: int, within_time: Optional[str] = None) -> Optional[Conditions]:
+    """`WITH step_0 AS (...), step_1 AS (...)`, one row per person with the time of their first matching event."""
+    if not is_columnar_store_enabled():
+        return None
+    date_from, date_to = _date_filter_bounds(filter)
+    properties = _filter_properties(filter, team_id)
+    ctes, params = [], []
+    for index, step in enumerate(filter.entities):
+        if step.type != TREND_FILTER_TYPE_EVENTS:
+            return None
+        conditions = _event_conditions(team_id, step.id, properties + step.properties)
+        if conditions is None:
+            return None
+        where, step_params = _with_date_bounds(conditions, date_from, date_to)
+        if index == 0:
+            ctes.append(
+                f"""step_0 AS (
+                    SELECT pdi.person_id, min(pdi.person_uuid) AS person_uuid, min(e.timestamp) AS step_ts
+                    FROM {EVENTS_WITH_PEOPLE} WHERE {where} GROUP BY pdi.person_id
+                )"""
+            )
+        else:
+            previous = f"step_{index - 1}"
+            within = f" AND e.timestamp < {previous}.step_ts + INTERVAL '{within_time}'" if within_time else ""
+            ctes.append(
+                f"""step_{index} AS (
+                    SELECT {previous}.person_id, min(e.timestamp) AS step_ts
+                    FROM {previous}
+                    JOIN person_distinct_ids pdi ON pdi.person_id = {previous}.person_id
+                    JOIN events e ON e.team_id = pdi.team_id AND e.distinct_id = pdi.distinct_id
+                    WHERE {where} AND e.timestamp >= {previous}.step_ts{within}
+                    GROUP BY {previous}.person_id
+                )"""
+            )
+        params.extend(step_params)
+    return "WITH " + ", ".join(ctes), params
+
+
+def _join_steps(filter: Filter) -> str:
+    return "step_0 " + " ".join(
+        f"LEFT JOIN step_{index} ON step_{index}.person_id = step_0.person_id"
+        for index in range(1, len(filter.entities))
+    )
+
+
+def _week_shift(interval: str) -> str:
+    # Weeks start on Sunday, like `get_interval_annotation`
+    return " + INTERVAL 1 DAY" if interval == "week" else ""
+
+
+def _filter_properties(filter: Union[Filter, RetentionFilter], team_id: int) -> List[Property]:
+    properties = list(filter.properties)
+    if filter.filter_test_accounts:
+        test_account_filters = Team.objects.only("test_account_filters").get(id=team_id).test_account_filters
+        properties.extend(Property(**prop) for prop in test_account_filters)
+    return properties
+
+
+def _date_filter_bounds(filter: Union[Filter, RetentionFilter]) -> Tuple[Optional[datetime], Optional[datetime]]:
+    # Same bounds as `date_filter_Q`
+    if filter._date_from == "all":
+        return None, None
+    return filter.date_from, filter.date_to
+
+
+def _with_date_bounds(
+    conditions: Conditions, date_from: Optional[datetime], date_to: Optional[datetime], column: str = "e.timestamp"
+) -> Conditions:
+    where, params = conditions
+    if date_from:
+        where += f" AND {column} >= ?"
+        params = params + [_to_utc(date_from)]
+    if date_to:
+        where += f" AND {column} <= ?"
+        params = params + [_to_utc(date_to)]
+    return where, params
+
+
+def _event_conditions(team_id: int, event: str, properties: List[Property]) -> Optional[Conditions]:
+    translated = _property_conditions(properties)
+    if translated is None:
+        return None
+    where, params = translated
+    return f"e.team_id = ? AND e.event = ? AND {where}", [team_id, event, *params]
+
+
+def _property_conditions(properties: List[Property]) -> Optional[Conditions]:
+    """Same matching as `Property.property_to_Q`, for the event properties and operators the store supports."""
+    conditions, params = ["TRUE"], []
+    for prop in properties:
+        if prop.type != "event" or prop.operator not in SUPPORTED_OPERATORS or '"' in prop.key or "\\" in prop.key:
+            return None
+        path = '$."{}"'.format(prop.key)
+        if prop.operator in ("is_set", "is_not_set"):
+            conditions.append(
+                "json_extract(e.properties, ?) IS {}NULL".format("NOT " if prop.operator == "is_set" else "")
+            )
+            params.append(path)
+            continue
+
+        value = prop._parse_value(prop.value)
+        values = value if isinstance(value, list) else [value]
+        # JSON equality in Postgres only matches values of the same type, only strings are compared here
+        if not values or not all(isinstance(item, str) for item in values):
+            return None
+        if prop.operator in ("icontains", "not_icontains"):
+            if len(values) > 1:
+                return None
+            condition = "contains(lower(json_extract_string(e.properties, ?)), lower(?))"
+        else:
+            condition = "json_extract_string(e.properties, ?) IN ({})".format(", ".join("?" for _ in values))
+        if prop.operator in ("is_not", "not_icontains"):
+            condition = f"coalesce(NOT {condition}, TRUE)"
+        conditions.append(condition)
+        params.extend([path, *values])
+    return " AND ".join(conditions), params
+
+
+def _to_utc(timestamp: datetime) -> datetime:
+    return timestamp.astimezone(pytz.utc).replace(tzinfo=None) if timestamp.tzinfo else timestamp
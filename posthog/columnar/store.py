@@ -0,0 +1,241 @@
+"""
+The DuckDB file behind the columnar store.
+
+It holds a copy of `posthog_event` and of `posthog_persondistinctid`, refreshed by `sync_columnar_store` (a periodic
+celery task, or `./manage.py sync_columnar_store` locally). Events are ingested by the plugin server straight into
+Postgres, so rather than hooking into the save path the sync tails `posthog_event` and `posthog_persondistinctid` by
+id, and applies the deletions recorded by `record_deletion` as `ColumnarStoreDeletion` rows. Merging people moves
+existing distinct id rows to another person in place, which tailing doesn't see: the mapping is reloaded whole every
+`PERSON_DISTINCT_IDS_RELOAD_INTERVAL`.
+
+Each sync records a watermark: every event created before it has been copied. Queries are only answered from the store
+when the watermark covers the end of their date range, or is at most `MAX_STALENESS` old.
+
+DuckDB allows a single writing process per file: only the sync writes, and queries open the file read only. While the
+sync holds the file, before it first ran, or when it's behind, `execute` returns None and the queries run against
+Postgres instead.
+"""
+import json
+import logging
+import tempfile
+from contextlib import contextmanager
+from datetime import datetime, timedelta
+from typing import Any, Iterator, List, Optional, Sequence
+
+import pytz
+from django.conf import settings
+from django.db import connection as postgres_connection
+from django.db.models import QuerySet
+from django.utils import timezone
+
+from posthog.columnar import is_columnar_store_enabled
+from posthog.models import ColumnarStoreDeletion, Event, PersonDistinctId
+
+logger = logging.getLogger(__name__)
+
+SYNC_BATCH_SIZE = 50000
+# Bounds how long a single sync holds the file, and with it how long queries fall back to Postgres
+SYNC_MAX_BATCHES = 20
+# Ids are handed out when an insert starts, an event is only copied once transactions that could still commit a lower
+# id are long done
+SYNC_LAG = timedelta(minutes=1)
+# How far behind the watermark can be for queries whose range ends after it to still be answered from the store
+MAX_STALENESS = timedelta(minutes=5)
+# How often the whole distinct id mapping is reloaded to pick up merged people
+PERSON_DISTINCT_IDS_RELOAD_INTERVAL = timedelta(days=1)
+
+SCHEMA = (
+    """
+    CREATE TABLE IF NOT EXISTS events (
+        id BIGINT,
+        team_id INTEGER,
+        event VARCHAR,
+        distinct_id VARCHAR,
+        timestamp TIMESTAMP,
+        properties VARCHAR
+    )
+    """,
+    """
+    CREATE TABLE IF NOT EXISTS person_distinct_ids (
+        id BIGINT,
+        team_id INTEGER,
+        distinct_id VARCHAR,
+        person_id INTEGER,
+        person_uuid VARCHAR,
+        PRIMARY KEY (team_id, distinct_id)
+    )
+    """,
+    "CREATE TABLE IF NOT EXISTS sync_state (name VARCHAR PRIMARY KEY, value BIGINT)",
+)
+
+
+@contextmanager
+def connect(read_only: bool = True) -> Iterator[Any]:
+    import duckdb
+
+    connection = duckdb.connect(settings.COLUMNAR_STORE_PATH, read_only=read_only)
+    try:
+        yield connection
+    finally:
+        connection.close()
+
+
+def execute(query: str, params: Sequence[Any], date_to: datetime) -> Optional[List[tuple]]:
+    """Runs `query` if the store has every event up to `date_to` or is recent enough, None otherwise."""
+    import duckdb
+
+    try:
+        with connect() as connection:
+            watermark = datetime.fromtimestamp(_get_state(connection, "events_watermark"), tz=pytz.utc)
+            date_to = date_to if date_to.tzinfo else pytz.utc.localize(date_to)
+            if watermark < date_to and watermark < timezone.now() - MAX_STALENESS:
+                logger.info("Columnar store behind (watermark %s), falling back to Postgres", watermark)
+                return None
+            return connection.execute(query, list(params)).fetchall()
+    except duckdb.Error as err:
+        logger.warning("Columnar store unavailable, falling back to Postgres: %s", err)
+        return None
+
+
+def record_deletion(team_id: int, distinct_ids: Optional[List[str]] = None) -> None:
+    """Has the next sync delete the events of `distinct_ids`, or of the whole team, from the store."""
+    if not is_columnar_store_enabled():
+        return
+    if distinct_ids is None:
+        ColumnarStoreDeletion.objects.create(team_id=team_id)
+    else:
+        ColumnarStoreDeletion.objects.bulk_create(
+            [ColumnarStoreDeletion(team_id=team_id, distinct_id=distinct_id) for distinct_id in distinct_ids]
+        )
+
+
+def sync_columnar_store(batch_size: int = SYNC_BATCH_SIZE, max_batches: Optional[int] = SYNC_MAX_BATCHES) -> int:
+    """
+    Applies the deletions, copies the distinct ids and events added to Postgres since the last sync. Returns the number
+    of events copied.
+    """
+    with connect(read_only=False) as connection:
+        for statement in SCHEMA:
+            connection.execute(statement)
+        _sync_deletions(connection)
+        _sync_person_distinct_ids(connection)
+        return _sync_events(connection, batch_size, max_batches)
+
+
+def _sync_events(connection: Any, batch_size: int, max_batches: Optional[int]) -> int:
+    copied = 0
+    batches = 0
+    settled_before = timezone.now() - SYNC_LAG
+    # Stays None when the sync stops at max_batches with events left, the watermark is then the last event copied
+    watermark: Optional[datetime] = None
+    while max_batches is None or batches < max_batches:
+        rows = list(
+            Event.objects.filter(id__gt=_get_state(connection, "events"))
+            .order_by("id")
+            .values_list("id", "team_id", "event", "distinct_id", "timestamp", "properties", "created_at")[:batch_size]
+        )
+        settled = []
+        for row in rows:
+            if row[6] is not None and row[6] > settled_before:
+                break
+            settled.append(row)
+        if len(settled) < batch_size:
+            # Either every event is copied or the next one isn't settled yet
+            watermark = settled_before
+        if not settled:
+            break
+
+        last = settled[-1]
+        connection.begin()
+        connection.executemany(
+            "INSERT INTO events VALUES (?, ?, ?, ?, ?, ?)",
+            [
+                (id, team_id, event, distinct_id, _to_utc(timestamp), json.dumps(properties))
+                for id, team_id, event, distinct_id, timestamp, properties, _ in settled
+            ],
+        )
+        _set_state(connection, "events", last[0])
+        _set_state(connection, "events_watermark", int((watermark or last[6] or last[4]).timestamp()))
+        connection.commit()
+
+        copied += len(settled)
+        batches += 1
+        if watermark is not None:
+            break
+
+    if watermark is not None and copied == 0:
+        _set_state(connection, "events_watermark", int(watermark.timestamp()))
+    return copied
+
+
+def _sync_deletions(connection: Any) -> None:
+    deletions = list(ColumnarStoreDeletion.objects.order_by("id").values_list("id", "team_id", "distinct_id"))
+    if not deletions:
+        return
+    connection.begin()
+    for _, team_id, distinct_id in deletions:
+        for table in ("events", "person_distinct_ids"):
+            if distinct_id is None:
+                connection.execute("DELETE FROM {} WHERE team_id = ?".format(table), [team_id])
+            else:
+                connection.execute(
+                    "DELETE FROM {} WHERE team_id = ? AND distinct_id = ?".format(table), [team_id, distinct_id]
+                )
+    connection.commit()
+    # If this fails, the next sync deletes the same events again
+    ColumnarStoreDeletion.objects.filter(id__lte=deletions[-1][0]).delete()
+
+
+def _sync_person_distinct_ids(connection: Any) -> None:
+    """
+    Copies the distinct ids added since the last sync, or reloads the whole mapping once it's been
+    `PERSON_DISTINCT_IDS_RELOAD_INTERVAL` since the last reload. Queries keep reading the previous mapping until the
+    transaction commits.
+    """
+    now = timezone.now()
+    last_reload = datetime.fromtimestamp(_get_state(connection, "person_distinct_ids_reloaded"), tz=pytz.utc)
+    rows = PersonDistinctId.objects.order_by("id").values_list(
+        "id", "team_id", "distinct_id", "person_id", "person__uuid"
+    )
+
+    connection.begin()
+    if now - last_reload >= PERSON_DISTINCT_IDS_RELOAD_INTERVAL:
+        connection.execute("DELETE FROM person_distinct_ids")
+        _copy_from_postgres(connection, "person_distinct_ids", rows)
+        _set_state(connection, "person_distinct_ids_reloaded", int(now.timestamp()))
+    else:
+        # A distinct id deleted and added back keeps its key but gets a new id
+        connection.execute(
+            "CREATE OR REPLACE TEMP TABLE new_person_distinct_ids AS SELECT * FROM person_distinct_ids LIMIT 0"
+        )
+        _copy_from_postgres(
+            connection, "new_person_distinct_ids", rows.filter(id__gt=_get_state(connection, "person_distinct_ids"))
+        )
+        connection.execute("INSERT OR REPLACE INTO person_distinct_ids SELECT * FROM new_person_distinct_ids")
+        connection.execute("DROP TABLE new_person_distinct_ids")
+    last_id = connection.execute("SELECT max(id) FROM person_distinct_ids").fetchone()[0]
+    _set_state(connection, "person_distinct_ids", max(last_id or 0, _get_state(connection, "person_distinct_ids")))
+    connection.commit()
+
+
+def _copy_from_postgres(connection: Any, table: str, rows: QuerySet) -> None:
+    """Bulk loads the rows of a `values_list` queryset into `table`, through a CSV file written by Postgres' COPY."""
+    with tempfile.NamedTemporaryFile(mode="w", suffix=".csv") as csv_file:
+        with postgres_connection.cursor() as cursor:
+            query = cursor.mogrify(*rows.query.sql_with_params()).decode()
+            cursor.copy_expert("COPY ({}) TO STDOUT WITH CSV".format(query), csv_file)
+        csv_file.flush()
+        connection.execute("COPY {} FROM '{}' (FORMAT CSV)".format(table, csv_file.name))
+
+
+def _get_state(connection: Any, name: str) -> int:
+    row = connection.execute("SELECT value FROM sync_state WHERE name = ?", [name]).fetchone()
+    return row[0] if row else 0
+
+
+def _set_state(connection: Any, name: str, value: int) -> None:
+    connection.execute("INSERT OR REPLACE INTO sync_state VALUES (?, ?)", [name, value])
+
+
+def _to_utc(timestamp: datetime) -> datetime:
+    return timestamp.astimezone(pytz.utc).replace(tzinfo=None)
@@ -0,0 +1,258 @@
+import importlib.util
+import os
+import tempfile
+from contextlib import contextmanager
+from unittest import skipUnless
+
+from django.test import override_settings
+from freezegun import freeze_time
+
+from posthog.columnar.queries import _property_conditions, funnel_steps, funnel_trends, retention_counts, trend_counts
+from posthog.columnar.store import connect, record_deletion, sync_columnar_store
+from posthog.constants import INSIGHT_FUNNELS, RETENTION_FIRST_TIME, RETENTION_RECURRING, TRENDS_LINEAR, TRENDS_TABLE
+from posthog.models import Event, Person
+from posthog.models.entity import Entity
+from posthog.models.filters import Filter, RetentionFilter
+from posthog.models.property import Property
+from posthog.queries.funnel import TRENDS_WITHIN_TIME, Funnel
+from posthog.queries.retention import Retention
+from posthog.queries.trends import Trends
+from posthog.test.base import APIBaseTest
+
+DUCKDB_INSTALLED = importlib.util.find_spec("duckdb") is not None
+
+
+@contextmanager
+def columnar_store():
+    with tempfile.TemporaryDirectory() as directory:
+        with override_settings(COLUMNAR_STORE_PATH=os.path.join(directory, "events.duckdb")):
+            yield
+
+
+class TestColumnarQueries(APIBaseTest):
+    def _create_events(self):
+        Person.objects.create(team=self.team, distinct_ids=["returning", "returning_anonymous"])
+        Person.objects.create(team=self.team, distinct_ids=["once"])
+        for timestamp, event, distinct_id in [
+            ("2021-01-02T10:00:00Z", "user signed up", "returning_anonymous"),
+            ("2021-01-02T11:00:00Z", "paid", "returning"),
+            ("2021-01-03T09:00:00Z", "user signed up", "returning"),
+            ("2021-01-03T12:00:00Z", "user signed up", "once"),
+            ("2021-01-04T12:00:00Z", "paid", "once"),
+            ("2021-01-09T23:00:00Z", "user signed up", "returning"),
+            ("2021-01-10T01:00:00Z", "user signed up", "returning"),
+            ("2021-01-11T08:00:00Z", "paid", "returning"),
+        ]:
+            with freeze_time(timestamp):
+                Event.objects.create(team=self.team, event=event, distinct_id=distinct_id)
+
+    def _funnel_filter(self, properties=None):
+        return Filter(
+            data={
+                "events": [
+                    {"id": "user signed up", "type": "events", "order": 0},
+                    {"id": "paid", "type": "events", "order": 1},
+                ],
+                "properties": properties or [],
+                "insight": INSIGHT_FUNNELS,
+            }
+        )
+
+    def _person_uuids(self):
+        with connect() as connection:
+            return dict(
+                connection.execute(
+                    "SELECT distinct_id, person_uuid FROM person_distinct_ids WHERE team_id = ?", [self.team.pk]
+                ).fetchall()
+            )
+
+    def test_property_conditions(self):
+        self.assertEqual(
+            _property_conditions([Property(key="$browser", value="Chrome")]),
+            ("TRUE AND json_extract_string(e.properties, ?) IN (?)", ['$."$browser"', "Chrome"]),
+        )
+        self.assertEqual(
+            _property_conditions([Property(key="$browser", value="chr", operator="not_icontains")]),
+            (
+                "TRUE AND coalesce(NOT contains(lower(json_extract_string(e.properties, ?)), lower(?)), TRUE)",
+                ['$."$browser"', "chr"],
+            ),
+        )
+        # Not mirrored, the caller falls back to Postgres
+        self.assertIsNone(_property_conditions([Property(key="email", value="a@b.com", type="person")]))
+        self.assertIsNone(_property_conditions([Property(key="$browser", value="^Chr", operator="regex")]))
+        self.assertIsNone(_property_conditions([Property(key="amount", value=5)]))
+
+    def test_disabled_without_path(self):
+        with override_settings(COLUMNAR_STORE_PATH=""):
+            self.assertIsNone(funnel_steps(self._funnel_filter(), self.team.pk))
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_funnel_same_as_postgres(self):
+        Person.objects.create(team=self.team, distinct_ids=["stopped_after_signup"])
+        Person.objects.create(team=self.team, distinct_ids=["paid", "paid_anonymous"])
+        with freeze_time("2021-01-01T12:00:00Z"):
+            Event.objects.create(team=self.team, event="user signed up", distinct_id="stopped_after_signup")
+            Event.objects.create(
+                team=self.team, event="user signed up", distinct_id="paid_anonymous", properties={"$browser": "Chrome"}
+            )
+        with freeze_time("2021-01-01T13:00:00Z"):
+            Event.objects.create(team=self.team, event="paid", distinct_id="paid", properties={"$browser": "Chrome"})
+
+        with tempfile.TemporaryDirectory() as directory, freeze_time("2021-01-02T00:00:00Z"):
+            with override_settings(COLUMNAR_STORE_PATH=os.path.join(directory, "events.duckdb")):
+                self.assertEqual(sync_columnar_store(), 3)
+                columnar = Funnel(filter=self._funnel_filter(), team=self.team).run()
+                columnar_chrome = Funnel(
+                    filter=self._funnel_filter([{"key": "$browser", "value": "Chrome"}]), team=self.team
+                ).run()
+            postgres = Funnel(filter=self._funnel_filter(), team=self.team).run()
+
+        self.assertEqual([step["count"] for step in columnar], [2, 1])
+        self.assertEqual([step["count"] for step in columnar], [step["count"] for step in postgres])
+        self.assertEqual(columnar[0]["average_time"], postgres[0]["average_time"])
+        self.assertEqual(set(columnar[0]["people"]), set(postgres[0]["people"]))
+        self.assertEqual([step["count"] for step in columnar_chrome], [1, 1])
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_funnel_trends_same_as_postgres(self):
+        self._create_events()
+        filter = Filter(
+            data={
+                "insight": INSIGHT_FUNNELS,
+                "display": TRENDS_LINEAR,
+                "interval": "day",
+                "date_from": "2021-01-01",
+                "date_to": "2021-01-12",
+                "events": [{"id": "user signed up", "order": 0}, {"id": "paid", "order": 1}],
+            }
+        )
+        with columnar_store(), freeze_time("2021-01-12T00:00:00Z"):
+            sync_columnar_store()
+            self.assertIsNotNone(funnel_trends(filter, self.team.pk, TRENDS_WITHIN_TIME))
+            columnar = Funnel(filter=filter, team=self.team).run()
+        with freeze_time("2021-01-12T00:00:00Z"):
+            postgres = Funnel(filter=filter, team=self.team).run()
+
+        self.assertEqual(columnar, postgres)
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_trends_same_as_postgres(self):
+        self._create_events()
+        filters = [
+            # Weeks start on Sunday, 2021-01-09 and 2021-01-10 fall in different weeks
+            Filter(data={"interval": "week", "date_from": "2020-12-27", "events": [{"id": "user signed up"}]}),
+            Filter(data={"date_from": "2021-01-01", "events": [{"id": "user signed up", "math": "dau"}]}),
+            # The total over the range comes from the grouping set without the period
+            Filter(
+                data={"display": TRENDS_TABLE, "date_from": "2021-01-01", "events": [{"id": "paid", "math": "dau"}]}
+            ),
+            Filter(data={"display": TRENDS_TABLE, "date_from": "2021-01-01", "events": [{"id": "user signed up"}]}),
+        ]
+        with columnar_store(), freeze_time("2021-01-12T00:00:00Z"):
+            sync_columnar_store()
+            for filter in filters:
+                self.assertIsNotNone(trend_counts(filter.entities[0], filter, self.team.pk))
+            columnar = [Trends().run(filter, self.team) for filter in filters]
+        with freeze_time("2021-01-12T00:00:00Z"):
+            postgres = [Trends().run(filter, self.team) for filter in filters]
+
+        for columnar_result, postgres_result in zip(columnar, postgres):
+            self.assertEqual(columnar_result[0]["data"], postgres_result[0]["data"])
+            self.assertEqual(columnar_result[0]["days"], postgres_result[0]["days"])
+            self.assertEqual(columnar_result[0].get("aggregated_value"), postgres_result[0].get("aggregated_value"))
+        self.assertEqual(columnar[2][0]["aggregated_value"], 2)
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_retention_same_as_postgres(self):
+        self._create_events()
+        filters = [
+            RetentionFilter(
+                data={
+                    "date_to": "2021-01-11",
+                    "total_intervals": 10,
+                    "retention_type": retention_type,
+                    "target_entity": {"id": "user signed up", "type": "events"},
+                    "returning_entity": {"id": "paid", "type": "events"},
+                }
+            )
+            for retention_type in (RETENTION_RECURRING, RETENTION_FIRST_TIME)
+        ]
+        with columnar_store(), freeze_time("2021-01-12T00:00:00Z"):
+            sync_columnar_store()
+            for filter in filters:
+                self.assertIsNotNone(retention_counts(filter, self.team.pk))
+            columnar = [Retention().run(filter, self.team) for filter in filters]
+        with freeze_time("2021-01-12T00:00:00Z"):
+            postgres = [Retention().run(filter, self.team) for filter in filters]
+
+        self.assertEqual(columnar, postgres)
+        self.assertNotEqual(columnar[0], columnar[1])
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_sync_skips_unsettled_events(self):
+        Person.objects.create(team=self.team, distinct_ids=["person"])
+        with freeze_time("2021-01-01T12:00:00Z"):
+            Event.objects.create(team=self.team, event="user signed up", distinct_id="person")
+        with freeze_time("2021-01-01T12:00:30Z"):
+            Event.objects.create(team=self.team, event="paid", distinct_id="person")
+        filter = self._funnel_filter()
+
+        with columnar_store():
+            # The second event could still have a transaction with a lower id committing behind it
+            with freeze_time("2021-01-01T12:01:15Z"):
+                self.assertEqual(sync_columnar_store(), 1)
+                self.assertEqual([row.step_1 for row in funnel_steps(filter, self.team.pk)], [None])
+            with freeze_time("2021-01-01T12:02:00Z"):
+                self.assertEqual(sync_columnar_store(), 1)
+                self.assertEqual(sync_columnar_store(), 0)
+                self.assertIsNotNone(funnel_steps(filter, self.team.pk)[0].step_1)
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_falls_back_when_behind(self):
+        self._create_events()
+        filter = self._funnel_filter()
+        with columnar_store():
+            with freeze_time("2021-01-12T00:00:00Z"):
+                sync_columnar_store()
+                self.assertIsNotNone(funnel_steps(filter, self.team.pk))
+            # Ranges ending before the watermark are still complete
+            with freeze_time("2021-01-13T00:00:00Z"):
+                self.assertIsNotNone(funnel_steps(filter.with_data({"date_to": "2021-01-11"}), self.team.pk))
+                self.assertIsNone(funnel_steps(filter, self.team.pk))
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_deletions_are_synced(self):
+        self._create_events()
+        entity = Entity({"id": "user signed up", "type": "events"})
+        filter = Filter(data={"date_from": "2021-01-01", "events": [{"id": "user signed up"}]})
+        with columnar_store(), freeze_time("2021-01-12T00:00:00Z"):
+            sync_columnar_store()
+            self.assertEqual(trend_counts(entity, filter, self.team.pk)[1], 5)
+
+            response = self.client.delete(f"/api/person/{Person.objects.get(persondistinctid__distinct_id='once').pk}/")
+            self.assertEqual(response.status_code, 204)
+            sync_columnar_store()
+            self.assertEqual(trend_counts(entity, filter, self.team.pk)[1], 4)
+
+            record_deletion(self.team.pk)
+            sync_columnar_store()
+            self.assertEqual(trend_counts(entity, filter, self.team.pk)[1], 0)
+
+    @skipUnless(DUCKDB_INSTALLED, "duckdb isn't installed")
+    def test_distinct_ids_are_tailed_and_reloaded(self):
+        with columnar_store():
+            with freeze_time("2021-01-12T00:00:00Z"):
+                first = Person.objects.create(team=self.team, distinct_ids=["first"])
+                sync_columnar_store()
+                second = Person.objects.create(team=self.team, distinct_ids=["second"])
+                sync_columnar_store()
+                self.assertEqual(self._person_uuids(), {"first": str(first.uuid), "second": str(second.uuid)})
+
+                # Merges move existing rows, they only show up on the next reload
+                first.merge_people([second])
+                sync_columnar_store()
+                self.assertEqual(self._person_uuids()["second"], str(second.uuid))
+            with freeze_time("2021-01-13T00:00:00Z"):
+                sync_columnar_store()
+                self.assertEqual(self._person_uuids(), {"first": str(first.uuid), "second": str(first.uuid)})
@@ -76,6 +76,7 @@ RETENTION_TYPE = "retention_type"
 TOTAL_INTERVALS = "total_intervals"
 SELECTED_INTERVAL = "selected_interval"
 START_POINT = "start_point"
+STEP_LIMIT = "step_limit"
 TARGET_ENTITY = "target_entity"
 RETURNING_ENTITY = "returning_entity"
 OFFSET = "offset"
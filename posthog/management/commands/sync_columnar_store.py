@@ -0,0 +1,18 @@
+from django.core.management.base import BaseCommand
+
+from posthog.columnar import is_columnar_store_enabled
+from posthog.columnar.store import SYNC_BATCH_SIZE, sync_columnar_store
+
+
+class Command(BaseCommand):
+    help = "Copy the events not in the columnar store yet, e.g. to backfill it after setting COLUMNAR_STORE_PATH"
+
+    def add_arguments(self, parser):
+        parser.add_argument("--batch-size", type=int, default=SYNC_BATCH_SIZE, help="Events copied per transaction")
+
+    def handle(self, *args, **options):
+        if not is_columnar_store_enabled():
+            print("The columnar store is disabled, set COLUMNAR_STORE_PATH and install duckdb to enable it.")
+            return
+        copied = sync_columnar_store(batch_size=options["batch_size"], max_batches=None)
+        print(f"Copied {copied} events to the columnar store.")
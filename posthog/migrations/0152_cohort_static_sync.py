@@ -0,0 +1,17 @@
+# Generated by Django 3.1.8 on 2021-04-28 10:12
+
+from django.db import migrations, models
+
+
+class Migration(migrations.Migration):
+
+    dependencies = [
+        ("posthog", "0151_plugin_preinstalled"),
+    ]
+
+    operations = [
+        migrations.AddField(
+            model_name="cohort", name="static_sync_cursor", field=models.UUIDField(blank=True, null=True),
+        ),
+        migrations.AddField(model_name="cohort", name="static_synced_count", field=models.IntegerField(default=0),),
+    ]
@@ -0,0 +1,57 @@
+# Generated by Django 3.1.8 on 2021-05-04 09:12
+
+import django.db.models.deletion
+from django.db import migrations, models
+
+UPDATE_FIRST_SEEN_FUNCTION_SQL = """
+CREATE OR REPLACE FUNCTION posthog_update_event_first_seen() RETURNS trigger AS $$
+BEGIN
+    -- Most events aren't the first of their distinct id, those only read the unique index. The upsert below locks the
+    -- existing row even when it doesn't update it, which would serialize concurrent inserts of the same distinct id.
+    IF NEW.event IS NOT NULL AND NOT EXISTS (
+        SELECT 1 FROM posthog_eventfirstseen
+        WHERE team_id = NEW.team_id AND event = NEW.event AND distinct_id = NEW.distinct_id
+        AND timestamp <= NEW.timestamp
+    ) THEN
+        INSERT INTO posthog_eventfirstseen (team_id, event, distinct_id, timestamp)
+        VALUES (NEW.team_id, NEW.event, NEW.distinct_id, NEW.timestamp)
+        ON CONFLICT (team_id, event, distinct_id) DO UPDATE SET timestamp = EXCLUDED.timestamp
+        WHERE posthog_eventfirstseen.timestamp > EXCLUDED.timestamp;
+    END IF;
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER posthog_event_first_seen AFTER INSERT ON posthog_event
+FOR EACH ROW EXECUTE PROCEDURE posthog_update_event_first_seen();
+"""
+
+DROP_FIRST_SEEN_FUNCTION_SQL = """
+DROP TRIGGER IF EXISTS posthog_event_first_seen ON posthog_event;
+DROP FUNCTION IF EXISTS posthog_update_event_first_seen();
+"""
+
+
+class Migration(migrations.Migration):
+
+    dependencies = [
+        ("posthog", "0152_cohort_static_sync"),
+    ]
+
+    operations = [
+        migrations.CreateModel(
+            name="EventFirstSeen",
+            fields=[
+                ("id", models.AutoField(auto_created=True, primary_key=True, serialize=False, verbose_name="ID")),
+                ("event", models.CharField(max_length=200)),
+                ("distinct_id", models.CharField(max_length=200)),
+                ("timestamp", models.DateTimeField()),
+                ("team", models.ForeignKey(on_delete=django.db.models.deletion.CASCADE, to="posthog.team")),
+            ],
+        ),
+        migrations.AddConstraint(
+            model_name="eventfirstseen",
+            constraint=models.UniqueConstraint(fields=("team", "event", "distinct_id"), name="unique_event_first_seen"),
+        ),
+        migrations.RunSQL(UPDATE_FIRST_SEEN_FUNCTION_SQL, reverse_sql=DROP_FIRST_SEEN_FUNCTION_SQL),
+    ]
@@ -0,0 +1,22 @@
+# Generated by Django 3.1.8 on 2021-05-06 10:21
+
+from django.db import migrations, models
+
+
+class Migration(migrations.Migration):
+
+    dependencies = [
+        ("posthog", "0152_cohort_static_sync"),
+    ]
+
+    operations = [
+        migrations.CreateModel(
+            name="ColumnarStoreDeletion",
+            fields=[
+                ("id", models.AutoField(auto_created=True, primary_key=True, serialize=False, verbose_name="ID")),
+                ("team_id", models.IntegerField()),
+                ("distinct_id", models.CharField(max_length=400, null=True)),
+                ("created_at", models.DateTimeField(auto_now_add=True)),
+            ],
+        ),
+    ]
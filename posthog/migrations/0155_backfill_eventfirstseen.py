@@ -0,0 +1,34 @@
+# Generated by Django 3.1.8 on 2021-05-06 14:02
+
+from django.db import migrations
+
+# Events inserted while this runs are covered by the trigger of 0153, created first
+BACKFILL_FIRST_SEEN_SQL = """
+INSERT INTO posthog_eventfirstseen (team_id, event, distinct_id, timestamp)
+SELECT team_id, event, distinct_id, MIN(timestamp) FROM posthog_event WHERE team_id = %s AND event IS NOT NULL
+GROUP BY team_id, event, distinct_id
+ON CONFLICT (team_id, event, distinct_id) DO UPDATE SET timestamp = EXCLUDED.timestamp
+WHERE posthog_eventfirstseen.timestamp > EXCLUDED.timestamp
+"""
+
+
+def backfill_first_seen(apps, schema_editor):
+    # Not atomic, each team commits on its own: the rows the backfill writes are locked until it commits, and
+    # ingesting an event of the same distinct id waits on that lock in the trigger
+    Team = apps.get_model("posthog", "Team")
+    for team_id in Team.objects.order_by("id").values_list("id", flat=True):
+        with schema_editor.connection.cursor() as cursor:
+            cursor.execute(BACKFILL_FIRST_SEEN_SQL, [team_id])
+
+
+class Migration(migrations.Migration):
+    atomic = False
+
+    dependencies = [
+        ("posthog", "0153_eventfirstseen"),
+        ("posthog", "0154_columnarstoredeletion"),
+    ]
+
+    operations = [
+        migrations.RunPython(backfill_first_seen, migrations.RunPython.noop),
+    ]
@@ -2,6 +2,7 @@ from .action import Action
 from .action_step import ActionStep
 from .annotation import Annotation
 from .cohort import Cohort, CohortPeople
+from .columnar_store_deletion import ColumnarStoreDeletion
 from .dashboard import Dashboard
 from .dashboard_item import DashboardItem
 from .element import Element
@@ -9,6 +10,7 @@ from .element_group import ElementGroup
 from .entity import Entity
 from .event import Event
 from .event_definition import EventDefinition
+from .event_first_seen import EventFirstSeen
 from .feature_flag import FeatureFlag
 from .filters import Filter, RetentionFilter
 from .messaging import MessagingRecord
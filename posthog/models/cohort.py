@@ -1,4 +1,4 @@
-from typing import Any, Dict, List, Optional
+from typing import Any, Dict, Iterable, List, Optional
 
 from dateutil.relativedelta import relativedelta
 from django.conf import settings
@@ -60,6 +60,9 @@ class Cohort(models.Model):
     errors_calculating: models.IntegerField = models.IntegerField(default=0)
 
     is_static: models.BooleanField = models.BooleanField(default=False)
+    # Progress of copying a static cohort's people into Postgres, see `insert_users_batches_by_uuid`
+    static_sync_cursor: models.UUIDField = models.UUIDField(null=True, blank=True)
+    static_synced_count: models.IntegerField = models.IntegerField(default=0)
 
     objects = CohortManager()
 
@@ -157,17 +160,39 @@ class Cohort(models.Model):
         try:
             cursor = connection.cursor()
             for i in range(0, len(items), batchsize):
-                batch = items[i : i + batchsize]
-                persons_query = (
-                    Person.objects.filter(team_id=self.team_id).filter(uuid__in=batch).exclude(cohort__id=self.id)
-                )
-                sql, params = persons_query.distinct("pk").only("pk").query.sql_with_params()
-                query = UPDATE_QUERY.format(
-                    cohort_id=self.pk,
-                    values_query=sql.replace('FROM "posthog_person"', ', {} FROM "posthog_person"'.format(self.pk), 1,),
-                )
-                cursor.execute(query, params)
+                self._insert_users_batch_by_uuid(cursor, items[i : i + batchsize])
+
+            self.is_calculating = False
+            self.last_calculation = timezone.now()
+            self.errors_calculating = 0
+            self.save()
+        except Exception as err:
+            if settings.DEBUG:
+                raise err
+            self.is_calculating = False
+            self.errors_calculating = F("errors_calculating") + 1
+            self.save()
+            capture_exception(err)
 
+    def insert_users_batches_by_uuid(self, batches: Iterable[List[str]]) -> None:
+        """
+        Streams batches of person uuids, sorted by uuid, into the cohort. Every batch is committed along with its last
+        uuid and the number of people synced so far, so an interrupted sync resumes after `static_sync_cursor`.
+        """
+        if self.static_sync_cursor is None:
+            self.static_synced_count = 0
+        try:
+            cursor = connection.cursor()
+            for batch in batches:
+                with transaction.atomic():
+                    self._insert_users_batch_by_uuid(cursor, batch)
+                    self.static_sync_cursor = batch[-1]
+                    self.static_synced_count += len(batch)
+                    Cohort.objects.filter(pk=self.pk).update(
+                        static_sync_cursor=self.static_sync_cursor, static_synced_count=self.static_synced_count
+                    )
+
+            self.static_sync_cursor = None
             self.is_calculating = False
             self.last_calculation = timezone.now()
             self.errors_calculating = 0
@@ -180,6 +205,15 @@ class Cohort(models.Model):
             self.save()
             capture_exception(err)
 
+    def _insert_users_batch_by_uuid(self, cursor, batch: List[str]) -> None:
+        persons_query = Person.objects.filter(team_id=self.team_id).filter(uuid__in=batch).exclude(cohort__id=self.id)
+        sql, params = persons_query.distinct("pk").only("pk").query.sql_with_params()
+        query = UPDATE_QUERY.format(
+            cohort_id=self.pk,
+            values_query=sql.replace('FROM "posthog_person"', ', {} FROM "posthog_person"'.format(self.pk), 1,),
+        )
+        cursor.execute(query, params)
+
     def __str__(self):
         return self.name
 
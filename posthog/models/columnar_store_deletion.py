@@ -0,0 +1,15 @@
+from django.db import models
+
+
+class ColumnarStoreDeletion(models.Model):
+    """
+    Events deleted from Postgres, for `sync_columnar_store` to delete them from the columnar store too: the sync tails
+    `posthog_event` by id, so it doesn't see rows going away. Either the events of one distinct id, or with no
+    `distinct_id` the whole team's. Rows are removed once the sync applied them.
+
+    `team_id` isn't a foreign key, deleting a team has to leave its row behind.
+    """
+
+    team_id: models.IntegerField = models.IntegerField()
+    distinct_id: models.CharField = models.CharField(max_length=400, null=True)
+    created_at: models.DateTimeField = models.DateTimeField(auto_now_add=True)
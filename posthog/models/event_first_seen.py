@@ -0,0 +1,21 @@
+from django.db import models
+
+from posthog.models.team import Team
+
+
+class EventFirstSeen(models.Model):
+    """
+    When each distinct id first sent each event, so lifecycle queries don't need to scan the whole events history.
+    Kept up to date by a trigger on `posthog_event` inserts (see migration 0153), events are ingested straight into
+    Postgres by the plugin server.
+    """
+
+    team: models.ForeignKey = models.ForeignKey(Team, on_delete=models.CASCADE)
+    event: models.CharField = models.CharField(max_length=200)
+    distinct_id: models.CharField = models.CharField(max_length=200)
+    timestamp: models.DateTimeField = models.DateTimeField()
+
+    class Meta:
+        constraints = [
+            models.UniqueConstraint(fields=["team", "event", "distinct_id"], name="unique_event_first_seen"),
+        ]
@@ -1,6 +1,16 @@
 from typing import Dict, Optional, Tuple
 
-from posthog.constants import AUTOCAPTURE_EVENT, CUSTOM_EVENT, PAGEVIEW_EVENT, PATH_TYPE, SCREEN_EVENT, START_POINT
+from rest_framework.exceptions import ValidationError
+
+from posthog.constants import (
+    AUTOCAPTURE_EVENT,
+    CUSTOM_EVENT,
+    PAGEVIEW_EVENT,
+    PATH_TYPE,
+    SCREEN_EVENT,
+    START_POINT,
+    STEP_LIMIT,
+)
 from posthog.models.filters.mixins.common import BaseParamMixin
 from posthog.models.filters.mixins.utils import cached_property, include_dict
 
@@ -25,6 +35,22 @@ class StartPointMixin(BaseParamMixin):
         return {"start_point": self.start_point} if self.start_point else {}
 
 
+class StepLimitMixin(BaseParamMixin):
+    DEFAULT_STEP_LIMIT = 10
+
+    @cached_property
+    def step_limit(self) -> int:
+        """Nodes shown per step, the rest are collapsed into one "other" node."""
+        try:
+            return max(int(self._data.get(STEP_LIMIT, self.DEFAULT_STEP_LIMIT)), 1)
+        except (TypeError, ValueError):
+            raise ValidationError("step_limit must be an integer.")
+
+    @include_dict
+    def step_limit_to_dict(self):
+        return {"step_limit": self.step_limit} if STEP_LIMIT in self._data else {}
+
+
 class PropTypeDerivedMixin(PathTypeMixin):
     @cached_property
     def prop_type(self) -> str:
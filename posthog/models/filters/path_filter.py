@@ -9,6 +9,7 @@ from posthog.models.filters.mixins.paths import (
     ComparatorDerivedMixin,
     PropTypeDerivedMixin,
     StartPointMixin,
+    StepLimitMixin,
     TargetEventDerivedMixin,
 )
 from posthog.models.filters.mixins.property import PropertyMixin
@@ -16,6 +17,7 @@ from posthog.models.filters.mixins.property import PropertyMixin
 
 class PathFilter(
     StartPointMixin,
+    StepLimitMixin,
     TargetEventDerivedMixin,
     ComparatorDerivedMixin,
     PropTypeDerivedMixin,
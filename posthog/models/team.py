@@ -167,5 +167,8 @@ class Team(UUIDClassicModel):
 
 @receiver(models.signals.pre_delete, sender=Team)
 def team_deleted(sender, instance, **kwargs):
+    from posthog.columnar.store import record_deletion
+
     instance.event_set.all().delete()
+    record_deletion(instance.pk)
     instance.elementgroup_set.all().delete()
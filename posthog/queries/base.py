@@ -1,6 +1,6 @@
 import copy
-from datetime import timedelta
-from typing import Any, Callable, Dict, List, Optional, Union, cast
+from datetime import datetime, timedelta
+from typing import Any, Callable, Dict, List, Optional, Tuple, Union, cast
 
 from dateutil.relativedelta import relativedelta
 from django.db.models import Exists, OuterRef, Q, QuerySet
@@ -89,15 +89,8 @@ TIME_IN_SECONDS: Dict[str, Any] = {
     "month": 3600 * 24 * 30,
 }
 
-"""
-filter_events takes team_id, filter, entity and generates a Q objects that you can use to filter a QuerySet
-"""
-
-
-def filter_events(
-    team_id: int, filter, entity: Optional[Entity] = None, include_dates: bool = True, interval_annotation=None
-) -> Q:
-    filters = Q()
+def filter_date_bounds(filter) -> Tuple[Optional[datetime], datetime]:
+    """Timestamps of the events falling in the intervals between `filter.date_from` and `filter.date_to`."""
     relativity = relativedelta(days=1)
     date_from = filter.date_from
     if filter.interval == "hour":
@@ -110,11 +103,23 @@ def filter_events(
     elif filter.interval == "month":
         relativity = relativedelta(months=1) - relativity  # go to last day of month instead of first of next
         date_from = filter.date_from.replace(day=1)
+    return date_from, filter.date_to + relativity
+
 
-    if filter.date_from and include_dates:
-        filters &= Q(timestamp__gte=date_from)
+"""
+filter_events takes team_id, filter, entity and generates a Q objects that you can use to filter a QuerySet
+"""
+
+
+def filter_events(
+    team_id: int, filter, entity: Optional[Entity] = None, include_dates: bool = True, interval_annotation=None
+) -> Q:
+    filters = Q()
     if include_dates:
-        filters &= Q(timestamp__lte=filter.date_to + relativity)
+        date_from, date_to = filter_date_bounds(filter)
+        if date_from:
+            filters &= Q(timestamp__gte=date_from)
+        filters &= Q(timestamp__lte=date_to)
     if filter.properties or filter.filter_test_accounts:
         filters &= properties_to_Q(filter.properties, team_id=team_id, filter_test_accounts=filter.filter_test_accounts)
     if entity and entity.properties:
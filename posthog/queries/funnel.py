@@ -10,12 +10,16 @@ from django.db.models import IntegerField, Min, Value
 from django.utils import timezone
 from psycopg2 import sql
 
+from posthog.columnar.queries import funnel_steps, funnel_trends
 from posthog.constants import TREND_FILTER_TYPE_ACTIONS, TREND_FILTER_TYPE_EVENTS, TRENDS_LINEAR
 from posthog.models import Action, Entity, Event, Filter, Person, Team
 from posthog.models.utils import namedtuplefetchall
 from posthog.queries.base import BaseQuery, properties_to_Q
 from posthog.utils import append_data, format_label_date, get_daterange
 
+# Funnel trends only count conversions within a day of the first step
+TRENDS_WITHIN_TIME = "1 day"
+
 
 class Funnel(BaseQuery):
 
@@ -191,7 +195,7 @@ class Funnel(BaseQuery):
         ).format(
             interval=sql.Literal(filter.interval),
             particular_steps=sql.SQL(",\n").join(particular_steps),
-            steps_query=self._build_query(self._gen_lateral_bodies(within_time="'1 day'")),
+            steps_query=self._build_query(self._gen_lateral_bodies(within_time="'{}'".format(TRENDS_WITHIN_TIME))),
             interval_field=sql.SQL("step_0")
             if filter.interval != "week"
             else sql.SQL("(\"step_0\" + interval '1 day') AT TIME ZONE 'UTC'"),
@@ -205,10 +209,12 @@ class Funnel(BaseQuery):
 
     def _get_trends(self) -> List[Dict[str, Any]]:
         serialized: Dict[str, Any] = {"count": 0, "data": [], "days": [], "labels": []}
-        with connection.cursor() as cursor:
-            qstring = self._build_trends_query(self._filter).as_string(cursor.connection)
-            cursor.execute(qstring)
-            steps_at_dates = namedtuplefetchall(cursor)
+        steps_at_dates = funnel_trends(self._filter, self._team.pk, TRENDS_WITHIN_TIME)
+        if steps_at_dates is None:
+            with connection.cursor() as cursor:
+                qstring = self._build_trends_query(self._filter).as_string(cursor.connection)
+                cursor.execute(qstring)
+                steps_at_dates = namedtuplefetchall(cursor)
 
         date_range = get_daterange(
             self._filter.date_from or steps_at_dates[0].date, self._filter.date_to, frequency=self._filter.interval
@@ -288,8 +294,10 @@ class Funnel(BaseQuery):
         if self._filter.display == TRENDS_LINEAR:
             return self._get_trends()
 
-        with connection.cursor() as cursor:
-            qstring = self._build_query(self._gen_lateral_bodies()).as_string(cursor.connection)
-            cursor.execute(qstring)
-            results = namedtuplefetchall(cursor)
+        results = funnel_steps(self._filter, self._team.pk)
+        if results is None:
+            with connection.cursor() as cursor:
+                qstring = self._build_query(self._gen_lateral_bodies()).as_string(cursor.connection)
+                cursor.execute(qstring)
+                results = namedtuplefetchall(cursor)
         return self.data_to_return(results)
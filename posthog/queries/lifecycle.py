@@ -6,7 +6,7 @@ from django.db import connection
 from django.db.models.query import Prefetch
 from django.utils import timezone
 
-from posthog.constants import TREND_FILTER_TYPE_ACTIONS
+from posthog.constants import TREND_FILTER_TYPE_ACTIONS, TREND_FILTER_TYPE_EVENTS
 from posthog.models.entity import Entity
 from posthog.models.event import Event
 from posthog.models.filters import Filter
@@ -151,21 +151,7 @@ SELECT array_agg(day_start ORDER BY day_start ASC), array_agg(counts ORDER BY da
                                                     OR (lag_id = lagged.person_id AND lag_day < subsequent_day - INTERVAL %(one_interval)s)
                                              ) dormant_days
                                     ) e
-                                        JOIN (
-                                   SELECT DISTINCT _person_id as person_id,
-                                                   DATE_TRUNC(%(interval)s,
-                                                              min("posthog_event"."timestamp") AT TIME ZONE 'UTC') earliest
-                                   FROM ({earliest_events}) posthog_event
-                                    JOIN
-                                    (SELECT person_id as _person_id,
-                                            distinct_id
-                                        FROM posthog_persondistinctid
-                                        WHERE team_id = %(team_id)s) pdi on posthog_event.distinct_id = pdi.distinct_id
-                                   {action_join}
-                                   WHERE team_id = %(team_id)s
-                                     AND {event_condition}
-                                   GROUP BY _person_id
-                               ) earliest ON e.person_id = earliest.person_id
+                                        JOIN ({earliest}) earliest ON e.person_id = earliest.person_id
                   ) grouped_counts
              WHERE subsequent_day <= %(date_to)s
                AND subsequent_day >= %(date_from)s
@@ -181,6 +167,29 @@ INNER JOIN posthog_action_events
 ON posthog_event.id = posthog_action_events.event_id
 """
 
+EARLIEST_EVENTS_SQL = """
+SELECT DISTINCT _person_id as person_id,
+                DATE_TRUNC(%(interval)s, min("posthog_event"."timestamp") AT TIME ZONE 'UTC') earliest
+FROM ({earliest_events}) posthog_event
+JOIN
+(SELECT person_id as _person_id,
+        distinct_id
+    FROM posthog_persondistinctid
+    WHERE team_id = %(team_id)s) pdi on posthog_event.distinct_id = pdi.distinct_id
+{action_join}
+WHERE team_id = %(team_id)s
+    AND {event_condition}
+GROUP BY _person_id
+"""
+
+EARLIEST_FIRST_SEEN_SQL = """
+SELECT pdi.person_id, DATE_TRUNC(%(interval)s, min(first_seen.timestamp) AT TIME ZONE 'UTC') earliest
+FROM posthog_eventfirstseen first_seen
+JOIN posthog_persondistinctid pdi ON pdi.distinct_id = first_seen.distinct_id AND pdi.team_id = %(team_id)s
+WHERE first_seen.team_id = %(team_id)s AND first_seen.event = %(event)s
+GROUP BY pdi.person_id
+"""
+
 LIFECYCLE_PEOPLE_SQL = """
 SELECT person_id, subsequent_day, status
 FROM (
@@ -300,21 +309,7 @@ FROM (
                             OR (lag_id = lagged.person_id AND lag_day < subsequent_day - INTERVAL %(one_interval)s)
                         ) dormant_days
             ) e
-                JOIN (
-            SELECT DISTINCT _person_id as person_id,
-                            DATE_TRUNC(%(interval)s,
-                                        min("posthog_event"."timestamp") AT TIME ZONE 'UTC') earliest
-            FROM ({earliest_events}) posthog_event
-            JOIN
-            (SELECT person_id as _person_id,
-                    distinct_id
-                FROM posthog_persondistinctid
-                WHERE team_id = %(team_id)s) pdi on posthog_event.distinct_id = pdi.distinct_id
-            {action_join}
-            WHERE team_id = %(team_id)s
-                AND {event_condition}
-            GROUP BY _person_id
-        ) earliest ON e.person_id = earliest.person_id
+                JOIN ({earliest}) earliest ON e.person_id = earliest.person_id
     ) e
     WHERE status = %(status)s
     AND DATE_TRUNC(%(interval)s, %(target_date)s) = subsequent_day
@@ -322,6 +317,16 @@ FROM (
 """
 
 
+def can_use_first_seen(filter: Filter, entity: Entity) -> bool:
+    """First seen dates are kept per event, regardless of properties."""
+    return (
+        entity.type == TREND_FILTER_TYPE_EVENTS
+        and not filter.properties
+        and not entity.properties
+        and not filter.filter_test_accounts
+    )
+
+
 def get_interval(period: str) -> Union[timedelta, relativedelta]:
     if period == "minute":
         return timedelta(minutes=1)
@@ -392,15 +397,7 @@ class LifecycleTrend:
             Event.objects.filter(team_id=team_id).add_person_id(team_id).filter(filter_events(team_id, filter, entity))
         )
         event_query, event_params = queryset_to_named_query(filtered_events, "events")
-
-        earliest_events_filtered = (
-            Event.objects.filter(team_id=team_id)
-            .add_person_id(team_id)
-            .filter(filter_events(team_id, filter, entity, include_dates=False))
-        )
-        earliest_events_query, earliest_events_params = queryset_to_named_query(
-            earliest_events_filtered, "earliest_events"
-        )
+        earliest_query, earliest_params = self._earliest_query(entity, filter, team_id)
 
         with connection.cursor() as cursor:
             cursor.execute(
@@ -410,7 +407,7 @@ class LifecycleTrend:
                         "action_id" if entity.type == TREND_FILTER_TYPE_ACTIONS else "event"
                     ),
                     events=event_query,
-                    earliest_events=earliest_events_query,
+                    earliest=earliest_query,
                 ),
                 {
                     "team_id": team_id,
@@ -424,7 +421,7 @@ class LifecycleTrend:
                     "date_to": date_to,
                     "after_date_to": after_date_to,
                     **event_params,
-                    **earliest_events_params,
+                    **earliest_params,
                 },
             )
             res = []
@@ -452,15 +449,7 @@ class LifecycleTrend:
             Event.objects.filter(team_id=team_id).add_person_id(team_id).filter(filter_events(team_id, filter, entity))
         )
         event_query, event_params = queryset_to_named_query(filtered_events)
-
-        earliest_events_filtered = (
-            Event.objects.filter(team_id=team_id)
-            .add_person_id(team_id)
-            .filter(filter_events(team_id, filter, entity, include_dates=False))
-        )
-        earliest_events_query, earliest_events_params = queryset_to_named_query(
-            earliest_events_filtered, "earliest_events"
-        )
+        earliest_query, earliest_params = self._earliest_query(entity, filter, team_id)
 
         with connection.cursor() as cursor:
             cursor.execute(
@@ -470,7 +459,7 @@ class LifecycleTrend:
                         "action_id" if entity.type == TREND_FILTER_TYPE_ACTIONS else "event"
                     ),
                     events=event_query,
-                    earliest_events=earliest_events_query,
+                    earliest=earliest_query,
                 ),
                 {
                     "team_id": team_id,
@@ -488,7 +477,7 @@ class LifecycleTrend:
                     "offset": filter.offset,
                     "limit": limit,
                     **event_params,
-                    **earliest_events_params,
+                    **earliest_params,
                 },
             )
             pids = cursor.fetchall()
@@ -500,6 +489,30 @@ class LifecycleTrend:
 
             return PersonSerializer(people, many=True).data
 
+    def _earliest_query(self, entity: Entity, filter: Filter, team_id: int) -> Tuple[str, Dict[str, Any]]:
+        """When each person first did the entity, to tell new people apart from resurrecting ones."""
+        if can_use_first_seen(filter, entity):
+            return EARLIEST_FIRST_SEEN_SQL, {}
+
+        earliest_events_filtered = (
+            Event.objects.filter(team_id=team_id)
+            .add_person_id(team_id)
+            .filter(filter_events(team_id, filter, entity, include_dates=False))
+        )
+        earliest_events_query, earliest_events_params = queryset_to_named_query(
+            earliest_events_filtered, "earliest_events"
+        )
+        return (
+            EARLIEST_EVENTS_SQL.format(
+                earliest_events=earliest_events_query,
+                action_join=ACTION_JOIN if entity.type == TREND_FILTER_TYPE_ACTIONS else "",
+                event_condition="{} = %(event)s".format(
+                    "action_id" if entity.type == TREND_FILTER_TYPE_ACTIONS else "event"
+                ),
+            ),
+            earliest_events_params,
+        )
+
 
 def parse_response(stats: Dict, filter: Filter, additional_values: Dict = {}) -> Dict[str, Any]:
     counts = stats[1]
@@ -1,4 +1,5 @@
-from typing import Any, Dict, List, Optional
+from collections import defaultdict
+from typing import Any, Dict, List, Optional, Tuple
 
 from django.db import connection
 from django.db.models import F, OuterRef, Q
@@ -13,6 +14,47 @@ from posthog.utils import request_to_date_query
 
 from .base import BaseQuery
 
+# Pairs of path nodes read from the database, enough for the nodes kept per step and a meaningful "other" node
+PATHS_EDGE_LIMIT = 1000
+OTHER_PATHS_NODE = "(other)"
+
+
+def collapse_paths(paths: List[Dict[str, Any]], step_limit: int) -> List[Dict[str, Any]]:
+    """
+    Keeps the `step_limit` busiest nodes of every step (the number before the `_` of a path key) and merges the rest
+    into a single "other" node per step, so high-cardinality paths (e.g. URLs with ids) stay readable and cheap to lay
+    out. Links between the same nodes are summed up, the order of the remaining ones is kept.
+    """
+    incoming: Dict[str, int] = defaultdict(int)
+    outgoing: Dict[str, int] = defaultdict(int)
+    for path in paths:
+        outgoing[path["source"]] += path["value"]
+        incoming[path["target"]] += path["value"]
+
+    nodes_by_step: Dict[str, List[str]] = defaultdict(list)
+    for node in {*incoming, *outgoing}:
+        nodes_by_step[node.split("_", 1)[0]].append(node)
+
+    collapsed_nodes: Dict[str, str] = {}
+    for step, nodes in nodes_by_step.items():
+        if len(nodes) > step_limit:
+            nodes.sort(key=lambda node: (-max(incoming[node], outgoing[node]), node))
+            for node in nodes[step_limit:]:
+                collapsed_nodes[node] = "{}_{}".format(step, OTHER_PATHS_NODE)
+
+    if not collapsed_nodes:
+        return paths
+
+    links: Dict[Tuple[str, str], Dict[str, Any]] = {}
+    for path in paths:
+        source = collapsed_nodes.get(path["source"], path["source"])
+        target = collapsed_nodes.get(path["target"], path["target"])
+        if (source, target) in links:
+            links[(source, target)]["value"] += path["value"]
+        else:
+            links[(source, target)] = {**path, "source": source, "target": target}
+    return sorted(links.values(), key=lambda x: x["value"], reverse=True)
+
 
 class Paths(BaseQuery):
     def _event_subquery(self, event: str, key: str):
@@ -132,9 +174,9 @@ class Paths(BaseQuery):
         query = "\
         SELECT source_event, target_event, MAX(target_id), MAX(source_id), count(*) from ({}) as counts\
         where source_event is not null and target_event is not null\
-        group by source_event, target_event order by count desc limit 20\
+        group by source_event, target_event order by count desc limit {}\
         ".format(
-            counts
+            counts, PATHS_EDGE_LIMIT
         )
 
         cursor = connection.cursor()
@@ -150,4 +192,4 @@ class Paths(BaseQuery):
         return resp
 
     def run(self, filter: PathFilter, team: Team, *args, **kwargs) -> List[Dict[str, Any]]:
-        return self.calculate_paths(filter=filter, team=team)
+        return collapse_paths(self.calculate_paths(filter=filter, team=team), filter.step_limit)
@@ -9,6 +9,7 @@ from django.db.models.query_utils import Q
 from rest_framework.utils.serializer_helpers import ReturnDict
 from sentry_sdk.api import capture_exception
 
+from posthog.columnar.queries import retention_counts
 from posthog.constants import RETENTION_FIRST_TIME, TREND_FILTER_TYPE_ACTIONS, TREND_FILTER_TYPE_EVENTS, TRENDS_LINEAR
 from posthog.models import Event, Filter, Team
 from posthog.models.entity import Entity
@@ -168,7 +169,9 @@ class Retention(BaseQuery):
         return by_dates
 
     def run(self, filter: RetentionFilter, team: Team, *args, **kwargs) -> List[Dict[str, Any]]:
-        resultset = self._execute_sql(filter, team)
+        resultset = retention_counts(filter, team.pk)
+        if resultset is None:
+            resultset = self._execute_sql(filter, team)
 
         if filter.display == TRENDS_LINEAR:
             result = self.process_graph_result(resultset, filter)
@@ -51,9 +51,11 @@ SESSIONS_IN_RANGE_QUERY = """
 
 class SessionRecording:
     def query_recording_snapshots(
-        self, team: Team, session_id: str
+        self, team: Team, session_id: str, offset: int = 0, limit: Optional[int] = None
     ) -> Tuple[Optional[DistinctId], Optional[datetime.datetime], Snapshots]:
-        events = SessionRecordingEvent.objects.filter(team=team, session_id=session_id).order_by("timestamp")
+        events = SessionRecordingEvent.objects.filter(team=team, session_id=session_id).order_by("timestamp", "id")
+        if limit is not None:
+            events = events[offset : offset + limit]
 
         if len(events) == 0:
             return None, None, []
@@ -61,23 +63,39 @@ class SessionRecording:
         return events[0].distinct_id, events[0].timestamp, [e.snapshot_data for e in events]
 
     def run(self, team: Team, session_recording_id: str, *args, **kwargs) -> Dict[str, Any]:
-        from posthog.api.person import PersonSerializer
-
         distinct_id, start_time, snapshots = self.query_recording_snapshots(team, session_recording_id)
         snapshots = list(decompress_chunked_snapshot_data(team.pk, session_recording_id, snapshots))
 
-        person = (
-            PersonSerializer(Person.objects.get(team=team, persondistinctid__distinct_id=distinct_id)).data
-            if distinct_id
-            else None
+        return {
+            "snapshots": snapshots,
+            "person": self._person(team, distinct_id),
+            "start_time": start_time,
+        }
+
+    def run_page(self, team: Team, session_recording_id: str, offset: int, limit: int) -> Dict[str, Any]:
+        """
+        Snapshots of the recording exactly as stored, a page at a time, so the player can decompress them off the
+        main thread and start playing before the whole recording has arrived. Compressed chunks are left as is and
+        the chunks of one snapshot batch may span pages. The person is only looked up for the first page.
+        """
+        distinct_id, start_time, snapshots = self.query_recording_snapshots(
+            team, session_recording_id, offset=offset, limit=limit + 1
         )
 
         return {
-            "snapshots": snapshots,
-            "person": person,
+            "snapshots": snapshots[:limit],
+            "person": self._person(team, distinct_id) if offset == 0 else None,
             "start_time": start_time,
+            "has_next": len(snapshots) > limit,
         }
 
+    def _person(self, team: Team, distinct_id: Optional[DistinctId]) -> Optional[Dict[str, Any]]:
+        from posthog.api.person import PersonSerializer
+
+        if not distinct_id:
+            return None
+        return PersonSerializer(Person.objects.get(team=team, persondistinctid__distinct_id=distinct_id)).data
+
 
 def query_sessions_in_range(
     team: Team, start_time: datetime.datetime, end_time: datetime.datetime, filter: SessionsFilter
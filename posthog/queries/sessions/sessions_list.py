@@ -1,23 +1,63 @@
-from datetime import datetime
-from typing import Dict, List, Optional, Tuple
+from datetime import datetime, timedelta
+from typing import Any, Dict, List, Optional, Tuple
 
 from dateutil.relativedelta import relativedelta
 from django.contrib.postgres.fields.jsonb import KeyTextTransform
+from django.core.cache import cache
 from django.db import connection
-from django.db.models import Q, QuerySet
-from django.db.models.expressions import ExpressionWrapper
+from django.db.models import F, Q, QuerySet
+from django.db.models.expressions import ExpressionWrapper, Window
 from django.db.models.fields import BooleanField
+from django.db.models.functions import Lag
 from django.utils.timezone import now
+from rest_framework.exceptions import ValidationError
 
-from posthog.models import Event, Person, Team
+from posthog.models import Event, Team
 from posthog.models.filters.filter import Filter
 from posthog.models.filters.sessions_filter import SessionsFilter
+from posthog.models.utils import generate_random_token, namedtuplefetchall
 from posthog.queries.base import entity_to_Q, properties_to_Q
 from posthog.queries.sessions.session_recording import filter_sessions_by_recordings
-from posthog.queries.sessions.sessions_list_builder import SessionListBuilder
+from posthog.utils import flatten
 
 Session = Dict
 SESSIONS_LIST_DEFAULT_LIMIT = 20
+# Pages are resumed from state kept on the server, the client only holds on to a token for it
+SESSIONS_LIST_CURSOR_TTL = 30 * 60
+SESSION_TIMEOUT = timedelta(minutes=30)
+
+SESSIONS_LIST_SQL = """
+    WITH people AS ({people_query}),
+    page AS (
+        SELECT
+            distinct_id,
+            MIN(timestamp) AS start_time,
+            MAX(timestamp) AS end_time,
+            COUNT(DISTINCT id) AS event_count,
+            (ARRAY_AGG(current_url ORDER BY timestamp DESC, id DESC))[1] AS start_url,
+            (ARRAY_AGG(current_url ORDER BY timestamp, id))[1] AS end_url
+            {matching_events}
+        FROM (
+            SELECT *, SUM(new_session) OVER (PARTITION BY distinct_id ORDER BY timestamp, id) AS session_index
+            FROM (
+                SELECT *, CASE WHEN timestamp - previous_timestamp <= %s THEN 0 ELSE 1 END AS new_session
+                FROM ({events_query}) AS events
+            ) AS session_starts
+        ) AS sessions
+        GROUP BY distinct_id, session_index
+        {having}
+        ORDER BY end_time DESC, distinct_id DESC
+        LIMIT %s
+    )
+    SELECT page.*, people.email, (SELECT COUNT(*) FROM people) AS people_count
+    FROM (SELECT 1) AS one
+    LEFT JOIN page ON TRUE
+    LEFT JOIN people ON people.distinct_id = page.distinct_id
+    ORDER BY page.end_time DESC, page.distinct_id DESC
+"""
+# Sessions of a distinct id don't overlap, so (end_time, distinct_id) identifies a session: the next page of the same
+# people starts right after the last session of the previous one
+SESSIONS_AFTER_SQL = "(MAX(timestamp), distinct_id) < (%s, %s)"
 
 
 class SessionsList:
@@ -46,38 +86,85 @@ class SessionsList:
             filter = filter.with_data({"pagination": pagination})
 
     def fetch_page(self) -> Tuple[List[Session], Optional[Dict]]:
-        distinct_id_offset = self.filter.pagination.get("distinct_id_offset", 0)
-        start_timestamp = self.filter.pagination.get("start_timestamp")
-
-        person_emails = self.query_people_in_range(limit=self.limit + distinct_id_offset)
-
-        sessions_builder = SessionListBuilder(
-            self.events_query(list(person_emails.keys()), start_timestamp).iterator(),
-            emails=person_emails,
-            action_filter_count=len(self.filter.action_filters),
-            distinct_id_offset=distinct_id_offset,
-            start_timestamp=start_timestamp,
-            limit=self.limit,
-            last_page_last_seen=self.filter.pagination.get("last_seen", {}),
+        """
+        Sessions are built in a single query for `limit` people at a time, the most recently active first. Once all of
+        their sessions are listed, the next page moves on to the next people.
+        """
+        cursor = self.load_cursor(self.filter.pagination.get("cursor"))
+        distinct_id_offset = cursor.get("distinct_id_offset", 0)
+        after: Optional[Tuple[datetime, str]] = cursor.get("after")
+
+        people_query, people_params = self.people_query(distinct_id_offset)
+        events_query, events_params = self.events_query().query.sql_with_params()
+        action_filter_keys = [f"entity_{index}" for index in range(len(self.filter.action_filters))]
+        query = SESSIONS_LIST_SQL.format(
+            people_query=people_query,
+            events_query=events_query,
+            matching_events="".join(
+                f", ARRAY_AGG(DISTINCT id) FILTER (WHERE {key}) AS matching_{key}" for key in action_filter_keys
+            ),
+            having=self._having(action_filter_keys, after),
         )
-        sessions_builder.build()
+        with connection.cursor() as db_cursor:
+            db_cursor.execute(
+                query, (*people_params, SESSION_TIMEOUT, *events_params, *(after or ()), self.limit + 1),
+            )
+            rows = namedtuplefetchall(db_cursor)
+
+        sessions = [self._parse_session(row, action_filter_keys) for row in rows if row.distinct_id is not None]
+        next_cursor: Optional[Dict[str, Any]] = None
+        if len(sessions) > self.limit:
+            sessions.pop()
+            last_session = sessions[-1]
+            next_cursor = {
+                "distinct_id_offset": distinct_id_offset,
+                "after": (last_session["end_time"], last_session["distinct_id"]),
+            }
+        elif rows[0].people_count >= self.limit:
+            next_cursor = {"distinct_id_offset": distinct_id_offset + self.limit}
 
         return (
-            filter_sessions_by_recordings(self.team, sessions_builder.sessions, self.filter),
-            sessions_builder.pagination,
+            filter_sessions_by_recordings(self.team, sessions, self.filter),
+            {"cursor": self.save_cursor(next_cursor)} if next_cursor else None,
         )
 
-    def events_query(self, distinct_ids: List[str], start_timestamp: Optional[str],) -> QuerySet:
+    def _having(self, action_filter_keys: List[str], after: Optional[Tuple[datetime, str]]) -> str:
+        conditions = [f"BOOL_OR({key})" for key in action_filter_keys]
+        if after is not None:
+            conditions.append(SESSIONS_AFTER_SQL)
+        return f"HAVING {' AND '.join(conditions)}" if conditions else ""
+
+    def load_cursor(self, token: Optional[str]) -> Dict[str, Any]:
+        if token is None:
+            return {}
+        cursor = cache.get(self._cursor_key(token))
+        if cursor is None:
+            raise ValidationError("This list of sessions has expired, please reload it.")
+        return cursor
+
+    def save_cursor(self, cursor: Dict[str, Any]) -> str:
+        token = generate_random_token(12)
+        cache.set(self._cursor_key(token), cursor, SESSIONS_LIST_CURSOR_TTL)
+        return token
+
+    def _cursor_key(self, token: str) -> str:
+        return f"sessions_list_cursor_{self.team.pk}_{token}"
+
+    def events_query(self) -> QuerySet:
+        """Events of the people on the page, with the time of the previous event of the same distinct id."""
         events = (
             Event.objects.filter(team=self.team)
             .filter(self.date_filter())
-            .filter(distinct_id__in=distinct_ids)
-            .order_by("-timestamp")
-            .only("distinct_id", "timestamp")
-            .annotate(current_url=KeyTextTransform("$current_url", "properties"))
+            .extra(where=['"posthog_event"."distinct_id" IN (SELECT distinct_id FROM people)'])
+            .annotate(
+                current_url=KeyTextTransform("$current_url", "properties"),
+                previous_timestamp=Window(
+                    expression=Lag("timestamp", default=None),
+                    partition_by=F("distinct_id"),
+                    order_by=[F("timestamp").asc(), F("id").asc()],
+                ),
+            )
         )
-        if start_timestamp is not None:
-            events = events.filter(timestamp__lt=datetime.fromtimestamp(float(start_timestamp)))
 
         keys = []
         for i, entity in enumerate(self.filter.action_filters):
@@ -87,15 +174,23 @@ class SessionsList:
             )
             keys.append(key)
 
-        return events.values_list("distinct_id", "timestamp", "id", "current_url", *keys)
+        return events.values("distinct_id", "timestamp", "id", "current_url", "previous_timestamp", *keys)
 
-    def query_people_in_range(self, limit: int) -> Dict[str, Optional[str]]:
+    def people_query(self, distinct_id_offset: int) -> Tuple[str, Tuple]:
+        """`limit` distinct ids and their email, matching the person filters and most recently active first."""
         if self.filter.distinct_id:
-            person = Person.objects.filter(
-                team=self.team, persondistinctid__distinct_id=self.filter.distinct_id
-            ).first()
             return (
-                {distinct_id: person.properties.get("email") for distinct_id in person.distinct_ids} if person else {}
+                """
+                SELECT posthog_persondistinctid.distinct_id, posthog_person.properties->>'email' AS email
+                FROM posthog_persondistinctid
+                JOIN posthog_person ON posthog_person.id = posthog_persondistinctid.person_id
+                WHERE posthog_persondistinctid.team_id = %s AND posthog_persondistinctid.person_id IN (
+                    SELECT person_id FROM posthog_persondistinctid WHERE team_id = %s AND distinct_id = %s
+                )
+                ORDER BY posthog_persondistinctid.id
+                LIMIT %s OFFSET %s
+                """,
+                (self.team.pk, self.team.pk, self.filter.distinct_id, self.limit, distinct_id_offset),
             )
 
         events_query = (
@@ -107,20 +202,17 @@ class SessionsList:
         )
         sql, params = events_query.query.sql_with_params()
         query = f"""
-            SELECT events.distinct_id, MIN(posthog_person.properties->>'email')
+            SELECT events.distinct_id, MIN(posthog_person.properties->>'email') AS email
             FROM ({sql}) events
             LEFT OUTER JOIN
-                posthog_persondistinctid ON posthog_persondistinctid.distinct_id = events.distinct_id AND posthog_persondistinctid.team_id = {self.team.pk}
+                posthog_persondistinctid ON posthog_persondistinctid.distinct_id = events.distinct_id AND posthog_persondistinctid.team_id = %s
             LEFT OUTER JOIN
                 posthog_person ON posthog_person.id = posthog_persondistinctid.person_id
             GROUP BY events.distinct_id
-            ORDER BY MAX(events.timestamp) DESC
-            LIMIT {limit}
+            ORDER BY MAX(events.timestamp) DESC, events.distinct_id DESC
+            LIMIT %s OFFSET %s
         """
-        with connection.cursor() as cursor:
-            cursor.execute(query, params)
-            distinct_id_to_email = dict(cursor.fetchall())
-            return distinct_id_to_email
+        return query, (*params, self.team.pk, self.limit, distinct_id_offset)
 
     def date_filter(self) -> Q:
         # if _date_from is not explicitely set we only want to get the last day worth of data
@@ -131,3 +223,19 @@ class SessionsList:
             dt = now()
             dt = dt.replace(hour=0, minute=0, second=0, microsecond=0)
             return Q(timestamp__gte=dt, timestamp__lte=dt + relativedelta(days=1))
+
+    def _parse_session(self, row: Any, action_filter_keys: List[str]) -> Session:
+        return {
+            "distinct_id": row.distinct_id,
+            "global_session_id": f"{row.distinct_id}-{row.start_time}",
+            "start_time": row.start_time,
+            "end_time": row.end_time,
+            "length": (row.end_time - row.start_time).seconds,
+            "event_count": row.event_count,
+            "start_url": row.start_url,
+            "end_url": row.end_url,
+            "email": row.email,
+            "matching_events": list(
+                sorted(set(flatten([getattr(row, f"matching_{key}") or [] for key in action_filter_keys])))
+            ),
+        }
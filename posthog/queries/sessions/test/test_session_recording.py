@@ -32,6 +32,26 @@ def session_recording_test_factory(session_recording, filter_sessions, event_fac
                 self.assertEqual(session["person"]["properties"], {"$some_prop": "something"})
                 self.assertEqual(session["start_time"], now())
 
+        def test_query_run_page(self):
+            with freeze_time("2020-09-13T12:26:40.000Z"):
+                Person.objects.create(team=self.team, distinct_ids=["user"], properties={"$some_prop": "something"})
+
+                self.create_snapshot("user", "1", now())
+                chunk = {"chunk_id": "afb", "chunk_index": 0, "chunk_count": 1, "data": "", "has_full_snapshot": True}
+                self.create_chunked_snapshot("user", "1", now() + relativedelta(seconds=10), chunk)
+                self.create_snapshot("user", "1", now() + relativedelta(seconds=20))
+
+                first_page = session_recording().run_page(team=self.team, session_recording_id="1", offset=0, limit=2)
+                self.assertEqual(first_page["snapshots"], [{"timestamp": 1_600_000_000, "type": 2}, chunk])
+                self.assertEqual(first_page["person"]["properties"], {"$some_prop": "something"})
+                self.assertEqual(first_page["start_time"], now())
+                self.assertTrue(first_page["has_next"])
+
+                last_page = session_recording().run_page(team=self.team, session_recording_id="1", offset=2, limit=2)
+                self.assertEqual(last_page["snapshots"], [{"timestamp": 1_600_000_020, "type": 2}])
+                self.assertIsNone(last_page["person"])
+                self.assertFalse(last_page["has_next"])
+
         def test_query_run_with_no_such_session(self):
             session = session_recording().run(team=self.team, session_recording_id="xxx")
             self.assertEqual(session, {"snapshots": [], "person": None, "start_time": None})
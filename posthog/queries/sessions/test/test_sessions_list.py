@@ -1,6 +1,7 @@
 from dateutil.relativedelta import relativedelta
 from django.utils.timezone import now
 from freezegun import freeze_time
+from rest_framework.exceptions import ValidationError
 
 from posthog.models import Action, ActionStep, Cohort, Event, Organization, Person, SessionRecordingEvent
 from posthog.models.filters.sessions_filter import SessionsFilter
@@ -283,4 +284,110 @@ def sessions_list_test_factory(sessions, event_factory, session_recording_event_
 
 
 class DjangoSessionsListTest(sessions_list_test_factory(SessionsList, Event.objects.create, SessionRecordingEvent.objects.create)):  # type: ignore
-    pass
+    def _all_pages(self, sessions_filter):
+        pages, pagination = [], None
+        while True:
+            sessions, pagination = self.run_query(sessions_filter.with_data({"pagination": pagination or {}}))
+            pages.append(sessions)
+            if pagination is None:
+                return pages
+            self.assertEqual(list(pagination.keys()), ["cursor"])
+
+    @freeze_time("2012-01-15T20:00:00.000Z")
+    def test_pages_through_every_session_with_a_cursor(self):
+        self.create_large_testset()
+        for distinct_id in ["1", "2"]:
+            Event.objects.create(
+                team=self.team, event="$pageview", distinct_id=distinct_id, timestamp="2012-01-15T08:00:00Z"
+            )
+
+        sessions = [session for page in self._all_pages(SessionsFilter(data={})) for session in page]
+
+        # Everyone has a session in the last 100 minutes, "1" and "2" also have one in the morning
+        self.assertEqual(
+            sorted(session["distinct_id"] for session in sessions),
+            sorted([str(i) for i in range(100)] + ["1", "2"]),
+        )
+        # No page reads sessions an earlier page already listed
+        self.assertEqual(len({session["global_session_id"] for session in sessions}), len(sessions))
+
+    @freeze_time("2012-01-15T20:00:00.000Z")
+    def test_paginates_parallel_sessions(self):
+        # 25 people active at the same times, so their sessions end together and only the distinct id orders them
+        for index in range(25):
+            for minutes in [0, 10, 90]:
+                Event.objects.create(
+                    team=self.team,
+                    event="$pageview",
+                    distinct_id=f"user_{index:02}",
+                    timestamp=now() - relativedelta(minutes=minutes),
+                )
+            Person.objects.create(
+                team=self.team, distinct_ids=[f"user_{index:02}"], properties={"email": f"user_{index:02}@posthog.com"}
+            )
+
+        pages = self._all_pages(SessionsFilter(data={}))
+        sessions = [session for page in pages for session in page]
+
+        self.assertEqual([len(page) for page in pages], [10, 10, 10, 10, 10])
+        self.assertEqual(
+            [(session["distinct_id"], session["event_count"]) for session in sessions],
+            [(f"user_{index:02}", 2) for index in reversed(range(15, 25))]
+            + [(f"user_{index:02}", 1) for index in reversed(range(15, 25))]
+            + [(f"user_{index:02}", 2) for index in reversed(range(5, 15))]
+            + [(f"user_{index:02}", 1) for index in reversed(range(5, 15))]
+            + [(f"user_{index:02}", count) for count in [2, 1] for index in reversed(range(0, 5))],
+        )
+
+    @freeze_time("2012-01-15T20:00:00.000Z")
+    def test_orders_sessions_by_end_time_across_pages(self):
+        self.create_large_testset()
+
+        pages = self._all_pages(SessionsFilter(data={}))
+        end_times = [session["end_time"] for page in pages for session in page]
+
+        self.assertGreater(len(pages), 1)
+        self.assertEqual(end_times, sorted(end_times, reverse=True))
+
+    @freeze_time("2012-01-15T20:00:00.000Z")
+    def test_sessions_email(self):
+        self.create_large_testset()
+        Event.objects.create(team=self.team, event="$pageview", distinct_id="anonymous", timestamp=now())
+
+        sessions, _ = self.run_query(SessionsFilter(data={}))
+
+        self.assertEqual(sessions[0]["distinct_id"], "anonymous")
+        self.assertIsNone(sessions[0]["email"])
+        self.assertEqual(sessions[1]["email"], "person0@example.com")
+        self.assertEqual(sessions[2]["email"], "person1@example.com")
+
+    def test_expired_cursor(self):
+        with self.assertRaises(ValidationError):
+            self.run_query(SessionsFilter(data={"pagination": {"cursor": "expired"}}))
+
+    @freeze_time("2012-01-15T20:00:00.000Z")
+    def test_splits_sessions_after_inactivity(self):
+        for minutes, distinct_id, url in [
+            (0, "1", "/last"),
+            (3, "2", None),
+            (27, "1", "/middle"),
+            (35, "1", "/first"),
+            (85, "1", "/earlier"),
+            (88, "2", None),
+        ]:
+            Event.objects.create(
+                team=self.team,
+                event="$pageview",
+                distinct_id=distinct_id,
+                timestamp=now() - relativedelta(minutes=minutes),
+                properties={"$current_url": url} if url else {},
+            )
+
+        sessions, pagination = self.run_query(SessionsFilter(data={}))
+
+        self.assertEqual(
+            [(session["distinct_id"], session["event_count"], session["length"]) for session in sessions],
+            [("1", 3, 35 * 60), ("2", 1, 0), ("1", 1, 0), ("2", 1, 0)],
+        )
+        self.assertEqual((sessions[0]["start_url"], sessions[0]["end_url"]), ("/last", "/first"))
+        self.assertIsNone(pagination)
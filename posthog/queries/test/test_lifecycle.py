@@ -1,9 +1,11 @@
 import json
+from datetime import datetime
 
+import pytz
 from freezegun import freeze_time
 
 from posthog.constants import FILTER_TEST_ACCOUNTS, TRENDS_LIFECYCLE
-from posthog.models import Action, ActionStep, Cohort, Event, Filter, Person, Team
+from posthog.models import Action, ActionStep, Cohort, Event, EventFirstSeen, Filter, Person, Team
 from posthog.queries.trends import Trends
 from posthog.test.base import APIBaseTest, BaseTest
 from posthog.utils import relative_date_parse
@@ -74,6 +76,29 @@ def lifecycle_test_factory(trends, event_factory, person_factory, action_factory
                 elif res["status"] == "new":
                     self.assertEqual(res["data"], [1, 0, 0, 1, 0, 0, 0, 0])
 
+        def test_lifecycle_trend_distinct_id_reused_after_person_deleted(self):
+            person = self._create_events(data=[("p1", ["2020-01-09T12:00:00Z"])])[0]
+            response = self.client.delete(f"/api/person/{person.pk}/")
+            self.assertEqual(response.status_code, 204)
+
+            self._create_events(data=[("p1", ["2020-01-14T12:00:00Z"])])
+
+            result = trends().run(
+                Filter(
+                    data={
+                        "date_from": "2020-01-12T00:00:00Z",
+                        "date_to": "2020-01-19T00:00:00Z",
+                        "events": [{"id": "$pageview", "type": "events", "order": 0}],
+                        "shown_as": TRENDS_LIFECYCLE,
+                    }
+                ),
+                self.team,
+            )
+
+            data = {res["status"]: res["data"] for res in result}
+            self.assertEqual(data["new"], [0, 0, 1, 0, 0, 0, 0, 0])
+            self.assertEqual(data["resurrecting"], [0, 0, 0, 0, 0, 0, 0, 0])
+
         def test_lifecycle_trend_prop_filtering(self):
 
             p1 = person_factory(team_id=self.team.pk, distinct_ids=["p1"], properties={"name": "p1"})
@@ -469,6 +494,33 @@ def lifecycle_test_factory(trends, event_factory, person_factory, action_factory
                 elif res["status"] == "new":
                     self.assertEqual(res["data"], [0, 2, 0, 1, 0, 0])
 
+        def test_lifecycle_trend_weeks_date_to_mid_week(self):
+            # the last week counts its activity after date_to too
+            person_factory(team_id=self.team.pk, distinct_ids=["p1"], properties={"name": "p1"})
+            event_factory(
+                team=self.team, event="$pageview", distinct_id="p1", timestamp="2020-02-12T12:00:00Z",
+            )
+            event_factory(
+                team=self.team, event="$pageview", distinct_id="p1", timestamp="2020-02-21T12:00:00Z",
+            )
+
+            result = trends().run(
+                Filter(
+                    data={
+                        "date_from": "2020-02-05T00:00:00Z",
+                        "date_to": "2020-02-19T00:00:00Z",
+                        "events": [{"id": "$pageview", "type": "events", "order": 0}],
+                        "shown_as": TRENDS_LIFECYCLE,
+                        "interval": "week",
+                    }
+                ),
+                self.team,
+            )
+
+            data = {res["status"]: res["data"] for res in result}
+            self.assertEqual(data["returning"][-1], 1)
+            self.assertEqual(data["dormant"][-1], 0)
+
         def test_lifecycle_trend_months(self):
 
             p1 = person_factory(team_id=self.team.pk, distinct_ids=["p1"], properties={"name": "p1"})
@@ -608,4 +660,18 @@ def _create_action(**kwargs):
 
 
 class TestDjangoLifecycle(lifecycle_test_factory(Trends, Event.objects.create, Person.objects.create, _create_action)):  # type: ignore
-    pass
+    def test_first_seen_kept_up_to_date(self):
+        for timestamp in ["2020-01-12T12:00:00Z", "2020-01-11T12:00:00Z", "2020-01-13T12:00:00Z"]:
+            Event.objects.create(team=self.team, event="$pageview", distinct_id="p1", timestamp=timestamp)
+        Event.objects.create(team=self.team, event="$autocapture", distinct_id="p1", timestamp="2020-01-13T12:00:00Z")
+
+        self.assertEqual(
+            {
+                (first_seen.event, first_seen.timestamp)
+                for first_seen in EventFirstSeen.objects.filter(team=self.team, distinct_id="p1")
+            },
+            {
+                ("$pageview", datetime(2020, 1, 11, 12, tzinfo=pytz.utc)),
+                ("$autocapture", datetime(2020, 1, 13, 12, tzinfo=pytz.utc)),
+            },
+        )
@@ -1,6 +1,7 @@
 from dateutil.relativedelta import relativedelta
 from django.utils.timezone import now
 from freezegun import freeze_time
+from rest_framework.exceptions import ValidationError
 
 from posthog.constants import FILTER_TEST_ACCOUNTS
 from posthog.models import Element, Event, Person
@@ -455,6 +456,30 @@ def paths_test_factory(paths, event_factory, person_factory):
             self.assertTrue(response[1].items() >= {"source": "1_/", "target": "2_/pricing", "value": 2}.items())
             self.assertTrue(response[2].items() >= {"source": "2_/pricing", "target": "3_/about", "value": 1}.items())
 
+        def test_paths_step_limit(self):
+            for index, page in enumerate(["/a", "/a", "/a", "/b", "/b", "/c", "/d"]):
+                distinct_id = "person_{}".format(index)
+                person_factory(team_id=self.team.pk, distinct_ids=[distinct_id])
+                event_factory(
+                    properties={"$current_url": "/"}, distinct_id=distinct_id, event="$pageview", team=self.team,
+                )
+                event_factory(
+                    properties={"$current_url": page}, distinct_id=distinct_id, event="$pageview", team=self.team,
+                )
+
+            response = paths().run(team=self.team, filter=PathFilter(data={"path_type": "$pageview"}))
+            self.assertEqual(len(response), 4)
+
+            response = paths().run(team=self.team, filter=PathFilter(data={"path_type": "$pageview", "step_limit": 2}))
+            self.assertEqual(len(response), 3)
+            self.assertTrue(response[0].items() >= {"source": "1_/", "target": "2_/a", "value": 3}.items())
+            self.assertTrue(response[1].items() >= {"source": "1_/", "target": "2_/b", "value": 2}.items())
+            self.assertTrue(response[2].items() >= {"source": "1_/", "target": "2_(other)", "value": 2}.items())
+
+            self.assertEqual(PathFilter(data={"step_limit": 0}).step_limit, 1)
+            with self.assertRaises(ValidationError):
+                PathFilter(data={"step_limit": "all"}).step_limit
+
         def test_paths_in_window(self):
             person_factory(team_id=self.team.pk, distinct_ids=["person_1"])
 
@@ -24,6 +24,7 @@ from django.db.models.expressions import ExpressionWrapper, F, RawSQL, Subquery
 from django.db.models.fields import DateTimeField
 from django.db.models.functions import Cast
 
+from posthog.columnar.queries import trend_counts
 from posthog.constants import TREND_FILTER_TYPE_ACTIONS, TRENDS_CUMULATIVE, TRENDS_DISPLAY_BY_VALUE, TRENDS_LIFECYCLE
 from posthog.models import (
     Action,
@@ -331,6 +332,10 @@ class Trends(LifecycleTrend, BaseQuery):
         return filter
 
     def _format_normal_query(self, entity: Entity, filter: Filter, team_id: int) -> List[Dict[str, Any]]:
+        counts = trend_counts(entity, filter, team_id) if entity.math not in MATH_TO_AGGREGATE_FUNCTION else None
+        if counts is not None:
+            return self._format_columnar_query(counts, filter)
+
         events = process_entity_for_events(entity=entity, team_id=team_id, order_by="-timestamp",)
 
         items, filtered_events = aggregate_by_interval(events=events, team_id=team_id, entity=entity, filter=filter,)
@@ -342,6 +347,20 @@ class Trends(LifecycleTrend, BaseQuery):
             formatted_entities.append(formatted_data)
         return formatted_entities
 
+    def _format_columnar_query(self, counts: Tuple[List[Dict[str, Any]], int], filter: Filter) -> List[Dict[str, Any]]:
+        aggregates, total = counts
+        interval = filter.interval if filter.interval else "day"
+        items = group_events_to_date(
+            date_from=filter.date_from, date_to=filter.date_to, aggregates=aggregates, interval=interval
+        )
+        formatted_entities: List[Dict[str, Any]] = []
+        for _, item in items.items():
+            formatted_data = append_data(dates_filled=list(item.items()), interval=filter.interval)
+            if filter.display in TRENDS_DISPLAY_BY_VALUE:
+                formatted_data.update({"aggregated_value": total})
+            formatted_entities.append(formatted_data)
+        return formatted_entities
+
     def _serialize_breakdown(self, entity: Entity, filter: Filter, team_id: int) -> List[Dict[str, Any]]:
         events = process_entity_for_events(entity=entity, team_id=team_id, order_by="-timestamp",)
         items, filtered_events = aggregate_by_interval(
@@ -1,26 +1,121 @@
-from typing import Optional
+from time import time
+from typing import Any, Callable, Optional
 
 import redis
+import statsd
 from django.conf import settings
 from django.core.exceptions import ImproperlyConfigured
+from django_redis.pool import ConnectionFactory
+from redis.sentinel import Sentinel
 
 _client = None  # type: Optional[redis.Redis]
 
 
+def _report_latency(command: str, seconds: float) -> None:
+    if settings.STATSD_HOST is None:
+        return
+    try:
+        statsd.Timer("%s_posthog_redis" % (settings.STATSD_PREFIX,)).send(command.lower(), seconds)
+    except:
+        # metrics must never break the command itself
+        pass
+
+
+def _timed(command: str, function: Callable) -> Callable:
+    def timed_function(*args: Any, **kwargs: Any) -> Any:
+        start_time = time()
+        try:
+            return function(*args, **kwargs)
+        finally:
+            _report_latency(command, time() - start_time)
+
+    return timed_function
+
+
+class InstrumentedMixin:
+    """Reports per-command and per-pipeline latency to statsd, for both standalone and cluster clients."""
+
+    def execute_command(self, *args: Any, **options: Any) -> Any:
+        return _timed(str(args[0]), super().execute_command)(*args, **options)  # type: ignore
+
+    def pipeline(self, *args: Any, **kwargs: Any) -> Any:
+        pipeline = super().pipeline(*args, **kwargs)  # type: ignore
+        pipeline.execute = _timed("pipeline", pipeline.execute)
+        return pipeline
+
+
+class InstrumentedRedis(InstrumentedMixin, redis.Redis):
+    pass
+
+
+def _connection_kwargs() -> dict:
+    return {
+        "socket_timeout": settings.REDIS_SOCKET_TIMEOUT,
+        "socket_connect_timeout": settings.REDIS_SOCKET_CONNECT_TIMEOUT,
+        "health_check_interval": 30,
+    }
+
+
+def _create_client() -> Optional[redis.Redis]:
+    if settings.TEST:
+        import fakeredis
+
+        return fakeredis.FakeRedis()
+
+    if settings.REDIS_CLUSTER:
+        try:
+            from rediscluster import RedisCluster
+        except ImportError:
+            raise ImproperlyConfigured("REDIS_CLUSTER requires the redis-py-cluster package!")
+
+        class InstrumentedRedisCluster(InstrumentedMixin, RedisCluster):
+            pass
+
+        return InstrumentedRedisCluster.from_url(
+            settings.REDIS_URL, max_connections=settings.REDIS_MAX_CONNECTIONS, **_connection_kwargs()
+        )
+
+    if settings.REDIS_SENTINEL_HOSTS:
+        sentinels = [tuple(host.rsplit(":", 1)) for host in settings.REDIS_SENTINEL_HOSTS]
+        sentinel = Sentinel(
+            [(host, int(port)) for host, port in sentinels], sentinel_kwargs=_connection_kwargs(), **_connection_kwargs()
+        )
+        return sentinel.master_for(
+            settings.REDIS_SENTINEL_MASTER,
+            redis_class=InstrumentedRedis,
+            db=0,
+            max_connections=settings.REDIS_MAX_CONNECTIONS,
+        )
+
+    if settings.REDIS_URL:
+        pool = redis.BlockingConnectionPool.from_url(
+            settings.REDIS_URL,
+            db=0,
+            max_connections=settings.REDIS_MAX_CONNECTIONS,
+            timeout=settings.REDIS_POOL_TIMEOUT,
+            **_connection_kwargs(),
+        )
+        return InstrumentedRedis(connection_pool=pool)
+
+    return None
+
+
 def get_client() -> redis.Redis:
     global _client
 
     if _client:
         return _client
 
-    if settings.TEST:
-        import fakeredis
-
-        _client = fakeredis.FakeRedis()
-    elif settings.REDIS_URL:
-        _client = redis.from_url(settings.REDIS_URL, db=0)
+    _client = _create_client()
 
     if not _client:
         raise ImproperlyConfigured("Redis not configured!")
 
     return _client
+
+
+class HighAvailabilityConnectionFactory(ConnectionFactory):
+    """Hands the Django cache the Sentinel or Cluster client of `get_client`, see `CACHES` in settings."""
+
+    def connect(self, url: str) -> redis.Redis:
+        return get_client()
@@ -190,6 +190,11 @@ EVENT_PROPERTY_USAGE_INTERVAL_SECONDS = get_from_env(
     "ASYNC_EVENT_PROPERTY_USAGE_INTERVAL_SECONDS", 60 * 60, type_cast=int
 )
 
+# Optional columnar copy of the events serving funnels, trends and retention on Postgres installs (see posthog/columnar)
+# Disabled unless a file path is set, needs `pip install duckdb`
+COLUMNAR_STORE_PATH = os.getenv("COLUMNAR_STORE_PATH", "")
+COLUMNAR_STORE_SYNC_INTERVAL_SECONDS = get_from_env("COLUMNAR_STORE_SYNC_INTERVAL_SECONDS", 60, type_cast=int)
+
 UPDATE_CACHED_DASHBOARD_ITEMS_INTERVAL_SECONDS = get_from_env(
     "UPDATE_CACHED_DASHBOARD_ITEMS_INTERVAL_SECONDS", 90, type_cast=int
 )
@@ -430,10 +435,69 @@ if not REDIS_URL:
         "https://posthog.com/docs/deployment/upgrading-posthog#upgrading-from-before-1011"
     )
 
-# Only listen to the default queue "celery", unless overridden via the cli
+# Redis connections are pooled per process, REDIS_MAX_CONNECTIONS caps the pool and callers wait at most
+# REDIS_POOL_TIMEOUT seconds for a free connection. Commands time out after REDIS_SOCKET_TIMEOUT seconds.
+REDIS_MAX_CONNECTIONS = get_from_env("REDIS_MAX_CONNECTIONS", 50, type_cast=int)
+REDIS_POOL_TIMEOUT = get_from_env("REDIS_POOL_TIMEOUT", 5, type_cast=float)
+REDIS_SOCKET_TIMEOUT = get_from_env("REDIS_SOCKET_TIMEOUT", 5, type_cast=float)
+REDIS_SOCKET_CONNECT_TIMEOUT = get_from_env("REDIS_SOCKET_CONNECT_TIMEOUT", 2, type_cast=float)
+# Optional high availability setups: either a comma-separated list of sentinels (host:port) with the master name,
+# or Redis Cluster (requires the `redis-py-cluster` package), which REDIS_URL then points to
+REDIS_SENTINEL_HOSTS = get_list(os.getenv("REDIS_SENTINEL_HOSTS", ""))
+REDIS_SENTINEL_MASTER = os.getenv("REDIS_SENTINEL_MASTER", "mymaster")
+REDIS_CLUSTER = get_from_env("REDIS_CLUSTER", False, type_cast=strtobool)
+
+# Workload-isolated queues, so that a burst of heavy tasks can't delay webhooks or dashboard refreshes.
+# Workers listen to all of them unless narrowed down via the cli (`bin/docker-worker-celery --queues=realtime`).
+CELERY_REALTIME_QUEUE = "realtime"  # webhooks, emails, heartbeat and probes
+CELERY_REFRESH_QUEUE = "refresh"  # dashboard and insight cache refreshes
+CELERY_HEAVY_BATCH_QUEUE = "heavy-batch"  # cohort calculation, event property usage, action mappings
+CELERY_MAINTENANCE_QUEUE = "maintenance"  # partitions, retention, metrics and other housekeeping
+CELERY_WORKLOAD_QUEUES = [
+    CELERY_REALTIME_QUEUE,
+    CELERY_REFRESH_QUEUE,
+    CELERY_HEAVY_BATCH_QUEUE,
+    CELERY_MAINTENANCE_QUEUE,
+]
+
+# Listen to the default queue "celery" and the workload queues, unless overridden via the cli
 # NB! This is set to explicitly exclude the "posthog-plugins" queue, handled by a nodejs process
-CELERY_QUEUES = (Queue("celery", Exchange("celery"), "celery"),)
+CELERY_QUEUES = tuple(Queue(name, Exchange(name), name) for name in ["celery", *CELERY_WORKLOAD_QUEUES])
 CELERY_DEFAULT_QUEUE = "celery"
+
+# Priorities within a queue go from 0 (highest) to 9 (lowest), anything not routed below gets 5
+CELERY_DEFAULT_PRIORITY = 5
+CELERY_ROUTES = {
+    "posthog.celery.redis_heartbeat": {"queue": CELERY_REALTIME_QUEUE, "priority": 0},
+    "posthog.celery.redis_celery_queue_depth": {"queue": CELERY_REALTIME_QUEUE, "priority": 0},
+    "posthog.tasks.webhooks.*": {"queue": CELERY_REALTIME_QUEUE, "priority": 2},
+    "ee.tasks.webhooks_ee.*": {"queue": CELERY_REALTIME_QUEUE, "priority": 2},
+    "ee.tasks.hooks.*": {"queue": CELERY_REALTIME_QUEUE, "priority": 2},
+    "posthog.email.*": {"queue": CELERY_REALTIME_QUEUE},
+    "posthog.tasks.email.send_invite": {"queue": CELERY_REALTIME_QUEUE},
+    "posthog.tasks.user_identify.*": {"queue": CELERY_REALTIME_QUEUE},
+    "posthog.celery.update_cache_item_task": {"queue": CELERY_REFRESH_QUEUE},
+    "posthog.celery.check_cached_items": {"queue": CELERY_REFRESH_QUEUE},
+    "posthog.celery.calculate_cohort": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.tasks.calculate_cohort.*": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.celery.calculate_event_property_usage": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.tasks.calculate_event_property_usage.*": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.celery.calculate_event_action_mappings": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.tasks.calculate_action.*": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.celery.sync_columnar_store": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.celery.send_weekly_email_report": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.tasks.email._send_weekly_email_report_for_team": {"queue": CELERY_HEAVY_BATCH_QUEUE},
+    "posthog.tasks.sync_event_and_properties_definitions.*": {"queue": CELERY_MAINTENANCE_QUEUE},
+    "posthog.tasks.session_recording_retention.*": {"queue": CELERY_MAINTENANCE_QUEUE},
+    "posthog.celery.*": {"queue": CELERY_MAINTENANCE_QUEUE},
+}
+
+# Max number of concurrently running tasks of a given type across all workers, enforced via Redis semaphores
+CELERY_TASK_CONCURRENCY_LIMITS = {
+    "calculate_cohort": get_from_env("CALCULATE_COHORT_CONCURRENCY", 2, type_cast=int),
+    "calculate_event_property_usage_for_team": get_from_env("EVENT_PROPERTY_USAGE_CONCURRENCY", 1, type_cast=int),
+    "update_cache_item": get_from_env("UPDATE_CACHE_ITEM_CONCURRENCY", 10, type_cast=int),
+}
 CELERY_IMPORTS = ["posthog.tasks.webhooks"]  # required to avoid circular import
 
 if PRIMARY_DB == RDBMS.CLICKHOUSE:
@@ -445,8 +509,23 @@ if PRIMARY_DB == RDBMS.CLICKHOUSE:
         CELERY_IMPORTS.append("ee.tasks.webhooks_ee")
 
 CELERY_BROKER_URL = REDIS_URL  # celery connects to redis
+CELERY_BROKER_POOL_LIMIT = get_from_env("CELERY_BROKER_POOL_LIMIT", 10, type_cast=int)  # connections per worker
 CELERY_BEAT_MAX_LOOP_INTERVAL = 30  # sleep max 30sec before checking for new periodic events
 CELERY_RESULT_BACKEND = REDIS_URL  # stores results for lookup when processing
+if REDIS_SENTINEL_HOSTS:
+    CELERY_BROKER_URL = CELERY_RESULT_BACKEND = ";".join(f"sentinel://{host}" for host in REDIS_SENTINEL_HOSTS)
+    CELERY_BROKER_TRANSPORT_OPTIONS = {"master_name": REDIS_SENTINEL_MASTER}
+    CELERY_RESULT_BACKEND_TRANSPORT_OPTIONS = {"master_name": REDIS_SENTINEL_MASTER}
+    CELERY_REDBEAT_REDIS_URL = "redis-sentinel://"
+    CELERY_REDBEAT_REDIS_OPTIONS = {
+        "sentinels": [(host, int(port)) for host, port in (host.rsplit(":", 1) for host in REDIS_SENTINEL_HOSTS)],
+        "service_name": REDIS_SENTINEL_MASTER,
+    }
+elif REDIS_CLUSTER:
+    # kombu can't talk to Redis Cluster, the broker has to be a standalone (or sentinel managed) Redis
+    CELERY_BROKER_URL = CELERY_RESULT_BACKEND = os.getenv("CELERY_BROKER_URL", "")
+    if not CELERY_BROKER_URL:
+        raise ImproperlyConfigured("REDIS_CLUSTER requires CELERY_BROKER_URL to point to a standalone Redis!")
 CELERY_IGNORE_RESULT = True  # only applies to delay(), must do @shared_task(ignore_result=True) for apply_async
 CELERY_RESULT_EXPIRES = timedelta(days=4)  # expire tasks after 4 days instead of the default 1
 REDBEAT_LOCK_TIMEOUT = 45  # keep distributed beat lock for 45sec
@@ -529,11 +608,20 @@ CACHES = {
     "default": {
         "BACKEND": "django_redis.cache.RedisCache",
         "LOCATION": REDIS_URL,
-        "OPTIONS": {"CLIENT_CLASS": "django_redis.client.DefaultClient"},
+        "OPTIONS": {
+            "CLIENT_CLASS": "django_redis.client.DefaultClient",
+            "SOCKET_TIMEOUT": REDIS_SOCKET_TIMEOUT,
+            "SOCKET_CONNECT_TIMEOUT": REDIS_SOCKET_CONNECT_TIMEOUT,
+            "CONNECTION_POOL_CLASS": "redis.BlockingConnectionPool",
+            "CONNECTION_POOL_KWARGS": {"max_connections": REDIS_MAX_CONNECTIONS, "timeout": REDIS_POOL_TIMEOUT},
+        },
         "KEY_PREFIX": "posthog",
     }
 }
 
+if REDIS_SENTINEL_HOSTS or REDIS_CLUSTER:
+    CACHES["default"]["OPTIONS"]["CONNECTION_FACTORY"] = "posthog.redis.HighAvailabilityConnectionFactory"
+
 if TEST:
     CACHES["default"] = {
         "BACKEND": "django.core.cache.backends.locmem.LocMemCache",
@@ -0,0 +1,78 @@
+import time
+from functools import wraps
+from typing import Any, Callable, Optional
+from uuid import uuid4
+
+from celery import current_task
+from django.conf import settings
+
+from posthog.redis import get_client
+
+SEMAPHORE_KEY_PREFIX = "@posthog/task-semaphore/"
+SEMAPHORE_TIMEOUT_SECONDS = 60 * 60  # tokens of crashed workers are reclaimed after an hour
+RESCHEDULE_COUNTDOWN_SECONDS = 15
+
+
+class RedisSemaphore:
+    """
+    Counting semaphore shared between all workers.
+
+    Holders are tracked in a sorted set scored by acquisition time, so that tokens of workers that died without
+    releasing them expire after `timeout` seconds.
+    """
+
+    def __init__(self, name: str, limit: int, timeout: int = SEMAPHORE_TIMEOUT_SECONDS) -> None:
+        self.key = SEMAPHORE_KEY_PREFIX + name
+        self.limit = limit
+        self.timeout = timeout
+
+    def acquire(self) -> Optional[str]:
+        token = uuid4().hex
+        now = time.time()
+        pipeline = get_client().pipeline()
+        pipeline.zremrangebyscore(self.key, "-inf", now - self.timeout)
+        pipeline.zadd(self.key, {token: now})
+        pipeline.zrank(self.key, token)
+        pipeline.expire(self.key, self.timeout)
+        _, _, rank, _ = pipeline.execute()
+        if rank is not None and rank < self.limit:
+            return token
+        self.release(token)
+        return None
+
+    def release(self, token: str) -> None:
+        get_client().zrem(self.key, token)
+
+    def holders(self) -> int:
+        return get_client().zcount(self.key, time.time() - self.timeout, "+inf")
+
+
+def limit_concurrency(name: str) -> Callable:
+    """
+    Caps how many tasks of type `name` run at once, see `CELERY_TASK_CONCURRENCY_LIMITS`.
+    When the cap is reached the task is put back on its queue instead of occupying a worker slot.
+    Eager and direct calls are never limited.
+    """
+
+    def decorator(func: Callable) -> Callable:
+        @wraps(func)
+        def wrapper(*args: Any, **kwargs: Any) -> Any:
+            limit = settings.CELERY_TASK_CONCURRENCY_LIMITS.get(name)
+            task = current_task
+            if not limit or not task or task.request.called_directly or task.request.is_eager:
+                return func(*args, **kwargs)
+
+            semaphore = RedisSemaphore(name, limit)
+            token = semaphore.acquire()
+            if token is None:
+                priority = (task.request.delivery_info or {}).get("priority")
+                task.apply_async(args=args, kwargs=kwargs, countdown=RESCHEDULE_COUNTDOWN_SECONDS, priority=priority)
+                return None
+            try:
+                return func(*args, **kwargs)
+            finally:
+                semaphore.release(token)
+
+        return wrapper
+
+    return decorator
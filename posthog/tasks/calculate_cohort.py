@@ -11,6 +11,7 @@ from django.utils import timezone
 from posthog.constants import INSIGHT_STICKINESS
 from posthog.ee import is_ee_enabled
 from posthog.models import Cohort
+from posthog.task_concurrency import limit_concurrency
 
 logger = logging.getLogger(__name__)
 
@@ -35,6 +36,7 @@ def calculate_cohorts() -> None:
 
 
 @shared_task(ignore_result=True, max_retries=1)
+@limit_concurrency("calculate_cohort")
 def calculate_cohort(cohort_id: int) -> None:
     start_time = time.time()
     cohort = Cohort.objects.get(pk=cohort_id)
@@ -51,7 +53,8 @@ def calculate_cohort_from_list(cohort_id: int, items: List[str]) -> None:
     logger.info("Calculating cohort {} from CSV took {:.2f} seconds".format(cohort.pk, (time.time() - start_time)))
 
 
-@shared_task(ignore_result=True, max_retries=1)
+# Acknowledged once done, so a sync cut short by a worker restart is delivered again and resumes from its cursor
+@shared_task(ignore_result=True, max_retries=1, acks_late=True, reject_on_worker_lost=True)
 def insert_cohort_from_query(
     cohort_id: int, insight_type: str, filter_data: Dict[str, Any], entity_data: Dict[str, Any]
 ) -> None:
@@ -66,13 +69,15 @@ def insert_cohort_from_query(
 
         cohort = Cohort.objects.get(pk=cohort_id)
         entity = Entity(data=entity_data)
-        if insight_type == INSIGHT_STICKINESS:
-            _stickiness_filter = StickinessFilter(
-                data=filter_data, team=cohort.team, get_earliest_timestamp=get_earliest_timestamp
-            )
-            insert_stickiness_people_into_cohort(cohort, entity, _stickiness_filter)
-        else:
-            _filter = Filter(data=filter_data)
-            insert_entity_people_into_cohort(cohort, entity, _filter)
+        # A sync with a cursor was interrupted after the people were stored in ClickHouse, only the copy is left
+        if cohort.static_sync_cursor is None:
+            if insight_type == INSIGHT_STICKINESS:
+                _stickiness_filter = StickinessFilter(
+                    data=filter_data, team=cohort.team, get_earliest_timestamp=get_earliest_timestamp
+                )
+                insert_stickiness_people_into_cohort(cohort, entity, _stickiness_filter)
+            else:
+                _filter = Filter(data=filter_data)
+                insert_entity_people_into_cohort(cohort, entity, _filter)
 
         insert_cohort_people_into_pg(cohort=cohort)
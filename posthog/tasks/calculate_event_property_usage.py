@@ -10,6 +10,7 @@ from posthog.ee import is_ee_enabled
 from posthog.models import Team
 from posthog.models.dashboard_item import DashboardItem
 from posthog.models.event import Event
+from posthog.task_concurrency import limit_concurrency
 
 
 def calculate_event_property_usage() -> None:
@@ -27,6 +28,7 @@ def _save_team(team: Team, event_names: Dict[str, Dict], event_properties: Dict[
 
 
 @shared_task(ignore_result=True, max_retries=1)
+@limit_concurrency("calculate_event_property_usage_for_team")
 def calculate_event_property_usage_for_team(team_id: int) -> None:
     team = Team.objects.get(pk=team_id)
     event_names = {event: {"event": event, "usage_count": 0} for event in team.event_names}
@@ -0,0 +1,22 @@
+import logging
+
+from posthog.columnar import store
+from posthog.task_concurrency import RedisSemaphore
+
+logger = logging.getLogger(__name__)
+
+# A sync copies at most `store.SYNC_MAX_BATCHES` batches, the token of a worker that died mid-sync is reclaimed after
+SYNC_TIMEOUT_SECONDS = 30 * 60
+
+
+def sync_columnar_store() -> None:
+    """DuckDB allows a single writing process per file, a sync still running skips the next ones."""
+    semaphore = RedisSemaphore("sync_columnar_store", limit=1, timeout=SYNC_TIMEOUT_SECONDS)
+    token = semaphore.acquire()
+    if token is None:
+        return
+    try:
+        copied = store.sync_columnar_store()
+        logger.info("Copied %d events to the columnar store", copied)
+    finally:
+        semaphore.release(token)
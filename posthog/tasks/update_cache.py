@@ -107,7 +107,8 @@ def update_cached_items() -> None:
 
         cache_type = get_cache_type(filter)
         payload = {"filter": filter.toJSON(), "team_id": item.team_id}
-        tasks.append(update_cache_item_task.s(cache_key, cache_type, payload))
+        # background refreshes yield to the ones requested by users, which use the default priority
+        tasks.append(update_cache_item_task.s(cache_key, cache_type, payload).set(priority=7))
 
     logger.info("Found {} items to refresh".format(len(tasks)))
     taskset = group(tasks)
@@ -0,0 +1,30 @@
+from django.test import TestCase
+from freezegun import freeze_time
+
+from posthog.redis import get_client
+from posthog.task_concurrency import RedisSemaphore
+
+
+class TestRedisSemaphore(TestCase):
+    def setUp(self):
+        get_client().delete(RedisSemaphore("test", 1).key)
+
+    def test_limits_holders(self):
+        semaphore = RedisSemaphore("test", 2)
+        first = semaphore.acquire()
+        second = semaphore.acquire()
+        self.assertIsNotNone(first)
+        self.assertIsNotNone(second)
+        self.assertIsNone(semaphore.acquire())
+        self.assertEqual(semaphore.holders(), 2)
+
+        semaphore.release(first)  # type: ignore
+        self.assertIsNotNone(semaphore.acquire())
+
+    def test_stale_tokens_expire(self):
+        semaphore = RedisSemaphore("test", 1, timeout=60)
+        with freeze_time("2021-01-01T12:00:00Z"):
+            self.assertIsNotNone(semaphore.acquire())
+            self.assertIsNone(semaphore.acquire())
+        with freeze_time("2021-01-01T12:02:00Z"):
+            self.assertIsNotNone(semaphore.acquire())
@@ -1,7 +1,13 @@
+from django.core.cache import cache
 from django.test import TestCase
 from freezegun import freeze_time
 
-from posthog.utils import get_available_timezones_with_offsets, mask_email_address, relative_date_parse
+from posthog.utils import (
+    get_available_timezones_with_offsets,
+    get_safe_cache_many,
+    mask_email_address,
+    relative_date_parse,
+)
 
 
 class TestGeneralUtils(TestCase):
@@ -21,6 +27,14 @@ class TestGeneralUtils(TestCase):
         timezones = get_available_timezones_with_offsets()
         self.assertEqual(timezones.get("Europe/Moscow"), 3)
 
+    def test_get_safe_cache_many(self):
+        cache.set("cached_a", {"result": 1})
+        cache.set("cached_b", {"result": 2})
+        self.assertEqual(
+            get_safe_cache_many(["cached_a", "cached_b", "missing"]),
+            {"cached_a": {"result": 1}, "cached_b": {"result": 2}},
+        )
+
 
 class TestRelativeDateParse(TestCase):
     @freeze_time("2020-01-31T12:22:23")
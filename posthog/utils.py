@@ -580,6 +580,21 @@ def get_safe_cache(cache_key: str):
     return None
 
 
+def get_safe_cache_many(cache_keys: List[str]) -> Dict[str, Any]:
+    """
+    Like `get_safe_cache`, but fetches all keys in one round trip (MGET). Missing keys are left out of the result.
+    """
+    try:
+        return cache.get_many(cache_keys)
+    except Exception:  # fall back to key by key, so that one corrupted entry doesn't fail the whole batch
+        results = {}
+        for cache_key in cache_keys:
+            cached_result = get_safe_cache(cache_key)
+            if cached_result is not None:
+                results[cache_key] = cached_result
+        return results
+
+
 def is_anonymous_id(distinct_id: str) -> bool:
     # Our anonymous ids are _not_ uuids, but a random collection of strings
     return bool(re.match(ANONYMOUS_REGEX, distinct_id))
@@ -10,7 +10,13 @@ const AntdDayjsWebpackPlugin = require('antd-dayjs-webpack-plugin')
 const webpackDevServerHost = process.env.WEBPACK_HOT_RELOAD_HOST || '127.0.0.1'
 const webpackDevServerFrontendAddr = webpackDevServerHost === '0.0.0.0' ? '127.0.0.1' : webpackDevServerHost
 
+// The toolbar bootstrap (`toolbar.js`) is injected into our users' sites, the production build fails above this size
+const TOOLBAR_BOOTSTRAP_BUDGET = 20 * 1024
+
 function createEntry(entry) {
+    const isWorker = entry === 'snapshot_worker' || entry === 'paths_worker'
+    // only the app edits code (plugin sources), other bundles don't need the Monaco workers and languages
+    const isApp = entry === 'main' || entry === 'cypress'
     const commonLoadersForSassAndLess = [
         entry === 'toolbar'
             ? {
@@ -61,15 +67,64 @@ function createEntry(entry) {
                     ? './frontend/src/toolbar/index.tsx'
                     : entry === 'shared_dashboard'
                     ? './frontend/src/scenes/dashboard/SharedDashboard.tsx'
+                    : entry === 'snapshot_worker'
+                    ? './frontend/src/scenes/sessions/snapshotWorker.ts'
+                    : entry === 'paths_worker'
+                    ? './frontend/src/scenes/paths/pathsWorker.js'
                     : null,
         },
+        target: isWorker ? 'webworker' : 'web',
         watchOptions: {
             ignored: /node_modules/,
         },
+        optimization: isApp
+            ? {
+                  // heavy libraries are only used by a few lazily loaded scenes, keep each in its own cached chunk
+                  splitChunks: {
+                      chunks: 'async',
+                      cacheGroups: {
+                          vendor_charts: {
+                              test: /[\\/]node_modules[\\/](chart\.js|chartjs-[^\\/]+)[\\/]/,
+                              name: 'vendor_charts',
+                              priority: 10,
+                          },
+                          vendor_d3: {
+                              test: /[\\/]node_modules[\\/](d3[^\\/]*)[\\/]/,
+                              name: 'vendor_d3',
+                              priority: 10,
+                          },
+                          vendor_rrweb: {
+                              test: /[\\/]node_modules[\\/](rrweb|@posthog[\\/]react-rrweb-player)[\\/]/,
+                              name: 'vendor_rrweb',
+                              priority: 10,
+                          },
+                          vendor_monaco: {
+                              test: /[\\/]node_modules[\\/](monaco-editor|react-monaco-editor)[\\/]/,
+                              name: 'vendor_monaco',
+                              priority: 10,
+                          },
+                      },
+                  },
+              }
+            : undefined,
+        performance:
+            entry === 'toolbar' && process.env.NODE_ENV === 'production'
+                ? {
+                      hints: 'error',
+                      maxEntrypointSize: TOOLBAR_BOOTSTRAP_BUDGET,
+                      maxAssetSize: TOOLBAR_BOOTSTRAP_BUDGET,
+                      // the rest of the toolbar is in lazily loaded chunks
+                      assetFilter: (assetFilename) => assetFilename === 'toolbar.js',
+                  }
+                : undefined,
         output: {
             path: path.resolve(__dirname, 'frontend', 'dist'),
             filename: '[name].js',
             chunkFilename: '[name].[contenthash].js',
+            // `window` doesn't exist in worker bundles
+            globalObject: 'self',
+            // the toolbar loads its chunks on other sites, which can have their own webpack runtime
+            ...(entry === 'toolbar' ? { jsonpFunction: 'webpackJsonpPostHogToolbar' } : {}),
             publicPath:
                 process.env.NODE_ENV === 'production'
                     ? '/static/'
@@ -198,13 +253,21 @@ function createEntry(entry) {
                   },
               }
             : {}),
-        plugins: [
-            new MonacoWebpackPlugin({
-                languages: ['json', 'javascript'],
-            }),
-            new AntdDayjsWebpackPlugin(),
-            // common plugins for all entrypoints
-        ].concat(
+        plugins: (isWorker
+            ? // worker bundles have no UI
+              []
+            : [
+                  ...(isApp
+                      ? [
+                            new MonacoWebpackPlugin({
+                                languages: ['json', 'javascript'],
+                            }),
+                        ]
+                      : []),
+                  new AntdDayjsWebpackPlugin(),
+                  // common plugins for all entrypoints
+              ]
+        ).concat(
             entry === 'main'
                 ? [
                       // other bundles include the css in js via style-loader
@@ -252,5 +315,13 @@ function createEntry(entry) {
 // main = app
 // toolbar = toolbar
 // shared_dashboard = publicly available dashboard
-module.exports = () => [createEntry('main'), createEntry('toolbar'), createEntry('shared_dashboard')]
+// snapshot_worker = web worker decoding session recordings
+// paths_worker = web worker laying out the paths sankey
+module.exports = () => [
+    createEntry('main'),
+    createEntry('toolbar'),
+    createEntry('shared_dashboard'),
+    createEntry('snapshot_worker'),
+    createEntry('paths_worker'),
+]
 module.exports.createEntry = createEntry